@@ -140,7 +140,7 @@ namespace JSC {
             if (!result)
                 return 0;
 
-            ExecutableAllocator::makeWritable(result->start(), result->sizeInBytes());
+            globalData.executableAllocator.makeWritable(result.get());
 
             memcpy(result->start(), m_buffer, m_index);
             
@@ -350,7 +350,7 @@ inline void LinkBufferBase<MacroAssembler, ExecutableOffsetCalculator>::performF
 #endif
 
     ASSERT(m_size <= INT_MAX);
-    ExecutableAllocator::makeExecutable(code(), static_cast<int>(m_size));
+    m_globalData->executableAllocator.makeExecutable(m_executableMemory.get());
     MacroAssembler::cacheFlush(code(), m_size);
 }
 
@@ -418,7 +418,7 @@ inline void BranchCompactingLinkBuffer<MacroAssembler>::performFinalization()
     this->m_completed = true;
 #endif
 
-    ExecutableAllocator::makeExecutable(code(), m_initialSize);
+    m_globalData->executableAllocator.makeExecutable(m_executableMemory.get());
     MacroAssembler::cacheFlush(code(), m_size);
 }
 
@@ -434,7 +434,7 @@ inline void BranchCompactingLinkBuffer<MacroAssembler>::linkCode(void* ownerUID,
         return;
     m_code = (uint8_t*)m_executableMemory->start();
     ASSERT(m_code);
-    ExecutableAllocator::makeWritable(m_code, m_initialSize);
+    m_globalData->executableAllocator.makeWritable(m_executableMemory.get());
     uint8_t* inData = (uint8_t*)m_assembler->unlinkedCode();
     uint8_t* outData = reinterpret_cast<uint8_t*>(m_code);
     int readPtr = 0;
@@ -61,11 +61,13 @@ namespace JSC {
 class JSGlobalData;
 
 struct ExecutableMemoryHandle : public RefCounted<ExecutableMemoryHandle> {
-    ExecutableMemoryHandle(QV4::ExecutableAllocator *allocator, size_t size)
+    ExecutableMemoryHandle(QV4::ExecutableAllocator *allocator, size_t size,
+                           QV4::ExecutableAllocator::WriteBatch *writeBatch,
+                           QV4::ExecutableAllocator::Pool pool = QV4::ExecutableAllocator::HotCode)
         : m_allocator(allocator)
         , m_size(size)
     {
-        m_allocation = allocator->allocate(size);
+        m_allocation = allocator->allocate(size, writeBatch, pool);
     }
     ~ExecutableMemoryHandle()
     {
@@ -90,85 +92,37 @@ struct ExecutableMemoryHandle : public RefCounted<ExecutableMemoryHandle> {
 };
 
 struct ExecutableAllocator {
-    ExecutableAllocator(QV4::ExecutableAllocator *alloc)
+    ExecutableAllocator(QV4::ExecutableAllocator *alloc,
+                        QV4::ExecutableAllocator::Pool pool,
+                        QV4::ExecutableAllocator::WriteBatch *writeBatch)
         : realAllocator(alloc)
+        , pool(pool)
+        , writeBatch(writeBatch)
     {}
 
     PassRefPtr<ExecutableMemoryHandle> allocate(JSGlobalData&, size_t size, void*, int)
     {
-        return adoptRef(new ExecutableMemoryHandle(realAllocator, size));
+        return adoptRef(new ExecutableMemoryHandle(realAllocator, size, writeBatch, pool));
     }
 
+    // Memory from the allocator stays writable until its write batch is committed,
+    // which makes all code linked into it executable at once.
+    void makeWritable(ExecutableMemoryHandle *) {}
+    void makeExecutable(ExecutableMemoryHandle *) {}
+
     static void makeWritable(void* addr, size_t size)
     {
-        quintptr pageSize = WTF::pageSize();
-        quintptr iaddr = reinterpret_cast<quintptr>(addr);
-        quintptr roundAddr = iaddr & ~(pageSize - 1);
-        size = size + (iaddr - roundAddr);
-        addr = reinterpret_cast<void*>(roundAddr);
-
-#if ENABLE(ASSEMBLER_WX_EXCLUSIVE) && !defined(V4_BOOTSTRAP)
-#  if OS(WINDOWS)
-        DWORD oldProtect;
-#    if !OS(WINRT)
-        VirtualProtect(addr, size, PAGE_READWRITE, &oldProtect);
-#    else
-        bool hr = VirtualProtectFromApp(addr, size, PAGE_READWRITE, &oldProtect);
-        if (!hr) {
-            Q_UNREACHABLE();
-        }
-#    endif
-#  else
-        int mode = PROT_READ | PROT_WRITE;
-        if (mprotect(addr, size, mode) != 0) {
-            perror("mprotect failed in ExecutableAllocator::makeWritable");
-            Q_UNREACHABLE();
-        }
-#  endif
-#else
-        // We assume we already have RWX
-        (void)addr; // suppress unused parameter warning
-        (void)size; // suppress unused parameter warning
-#endif
+        QV4::ExecutableAllocator::makeWritable(addr, size);
     }
 
     static void makeExecutable(void* addr, size_t size)
     {
-        quintptr pageSize = WTF::pageSize();
-        quintptr iaddr = reinterpret_cast<quintptr>(addr);
-        quintptr roundAddr = iaddr & ~(pageSize - 1);
-        size = size + (iaddr - roundAddr);
-        addr = reinterpret_cast<void*>(roundAddr);
-
-#if !defined(V4_BOOTSTRAP)
-#if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
-#  if OS(WINDOWS)
-        DWORD oldProtect;
-#    if !OS(WINRT)
-        VirtualProtect(addr, size, PAGE_EXECUTE_READ, &oldProtect);
-#    else
-        bool hr = VirtualProtectFromApp(addr, size, PAGE_EXECUTE_READ, &oldProtect);
-        if (!hr) {
-            Q_UNREACHABLE();
-        }
-#    endif
-#  else
-        int mode = PROT_READ | PROT_EXEC;
-        if (mprotect(addr, size, mode) != 0) {
-            perror("mprotect failed in ExecutableAllocator::makeExecutable");
-            Q_UNREACHABLE();
-        }
-#  endif
-#else
-#  error "Only W^X is supported"
-#endif
-#else
-        (void)addr; // suppress unused parameter warning
-        (void)size; // suppress unused parameter warning
-#endif
+        QV4::ExecutableAllocator::makeExecutable(addr, size);
     }
 
     QV4::ExecutableAllocator *realAllocator;
+    QV4::ExecutableAllocator::Pool pool;
+    QV4::ExecutableAllocator::WriteBatch *writeBatch;
 };
 
 }
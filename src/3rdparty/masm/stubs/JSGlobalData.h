@@ -46,9 +46,14 @@ namespace JSC {
 
 class JSGlobalData {
 public:
-    JSGlobalData(QV4::ExecutableAllocator *realAllocator)
-        : executableAllocator(realAllocator)
+    // Without a write batch of the caller, the code becomes executable when this is destroyed.
+    JSGlobalData(QV4::ExecutableAllocator *realAllocator,
+                 QV4::ExecutableAllocator::Pool pool = QV4::ExecutableAllocator::HotCode,
+                 QV4::ExecutableAllocator::WriteBatch *writeBatch = 0)
+        : ownWriteBatch(realAllocator)
+        , executableAllocator(realAllocator, pool, writeBatch ? writeBatch : &ownWriteBatch)
     {}
+    QV4::ExecutableAllocator::WriteBatch ownWriteBatch;
     ExecutableAllocator executableAllocator;
 };
 
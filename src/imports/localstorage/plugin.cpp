@@ -47,11 +47,16 @@
 #include <QtSql/qsqlerror.h>
 #include <QtSql/qsqlrecord.h>
 #include <QtSql/qsqlfield.h>
+#include <QtSql/qsqldriver.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qcoreapplication.h>
 #include <private/qv4sqlerrors_p.h>
 #include <private/qv4engine_p.h>
 #include <private/qv4object_p.h>
@@ -91,6 +96,322 @@ QT_BEGIN_NAMESPACE
     RETURN_UNDEFINED(); \
 }
 
+#define QML_SQL_STATEMENT_CACHE_SIZE 32
+
+typedef QVector<QPair<QVariant, QVariant> > QQmlSqlBindings; // placeholder index or name, value
+
+struct QQmlSqlStatement
+{
+    QQmlSqlStatement() : isBatch(false) {}
+
+    int bindingCount() const
+    {
+        if (!isBatch)
+            return bindings.count();
+        if (batch.isEmpty())
+            return 0;
+        int count = batch.first().count();
+        for (const QQmlSqlBindings &rowBindings : batch)
+            count = qMin(count, rowBindings.count());
+        return count;
+    }
+
+    QString sql;
+    QQmlSqlBindings bindings;
+    QVector<QQmlSqlBindings> batch; // isBatch: the bindings of each execution
+    bool isBatch;
+};
+
+struct QQmlSqlStatementResult
+{
+    QQmlSqlStatementResult() : rowsAffected(0) {}
+
+    QVector<QSqlRecord> rows;
+    int rowsAffected;
+    QVariant insertId;
+};
+
+struct QQmlSqlTransaction
+{
+    QQmlSqlTransaction() : id(0), errorStatement(-1), errorCode(0) {}
+
+    int id;
+    QString databaseName;
+    QVector<QQmlSqlStatement> statements;
+
+    QVector<QQmlSqlStatementResult> results;
+    int errorStatement; // the statement that failed, or -1
+    int errorCode;      // SQLEXCEPTION_* if the transaction failed, or 0
+    QString errorMessage;
+};
+
+/*
+    Keeps the most recently executed statements of a connection prepared, so that statements
+    which are run repeatedly are only compiled by SQLite once.  A query is taken out of the
+    cache while it is in use and put back when it has finished.
+*/
+class QQmlSqlStatementCache
+{
+public:
+    QQmlSqlStatementCache() : m_queries(QML_SQL_STATEMENT_CACHE_SIZE) {}
+
+    bool prepare(const QSqlDatabase &database, const QQmlSqlStatement &statement, QSqlQuery *query)
+    {
+        if (m_driver != database.driver()) {
+            // The connection was reopened, its prepared statements are gone.
+            m_queries.clear();
+            m_driver = database.driver();
+        }
+
+        QScopedPointer<QSqlQuery> cached(m_queries.take(statement.sql));
+        // Values stay bound between executions, so a cached query is only reused if all of them
+        // are replaced; otherwise a missing value must fail as it would for a new query.
+        if (cached && cached->boundValues().count() <= statement.bindingCount()) {
+            *query = *cached;
+            return true;
+        }
+        *query = QSqlQuery(database);
+        return query->prepare(statement.sql);
+    }
+
+    void release(const QString &sql, QSqlQuery *query)
+    {
+        query->finish();
+        m_queries.insert(sql, new QSqlQuery(*query));
+    }
+
+    void clear() { m_queries.clear(); }
+
+private:
+    QCache<QString, QSqlQuery> m_queries;
+    QPointer<QSqlDriver> m_driver;
+};
+
+static void bindSqlValues(QSqlQuery *query, const QQmlSqlBindings &bindings)
+{
+    for (const QPair<QVariant, QVariant> &binding : bindings) {
+        if (binding.first.type() == QVariant::String)
+            query->bindValue(binding.first.toString(), binding.second);
+        else
+            query->bindValue(binding.first.toInt(), binding.second);
+    }
+}
+
+static bool execSqlStatement(QSqlQuery *query, const QQmlSqlStatement &statement, int *rowsAffected)
+{
+    if (!statement.isBatch) {
+        bindSqlValues(query, statement.bindings);
+        if (!query->exec())
+            return false;
+        *rowsAffected = query->numRowsAffected();
+        return true;
+    }
+
+    // SQLite has no array binding; QSqlQuery::execBatch() would run the same loop, but without
+    // telling how many rows were affected.
+    *rowsAffected = 0;
+    for (const QQmlSqlBindings &bindings : statement.batch) {
+        bindSqlValues(query, bindings);
+        if (!query->exec())
+            return false;
+        *rowsAffected += qMax(0, query->numRowsAffected());
+    }
+    return true;
+}
+
+class QQmlSqlTransactionEvent : public QEvent
+{
+public:
+    QQmlSqlTransactionEvent(const QQmlSqlTransaction &transaction)
+        : QEvent(QEvent::User), transaction(transaction) {}
+
+    QQmlSqlTransaction transaction;
+};
+
+/*
+    Runs the statements of asynchronous transactions on the database thread, and posts the
+    transaction back to the receiver with its results.  A connection can only be used by the
+    thread that opened it, so the worker opens its own connection to each database.
+*/
+class QQmlSqlDatabaseWorker : public QObject
+{
+    Q_OBJECT
+public:
+    QQmlSqlDatabaseWorker(QObject *receiver) : m_receiver(receiver) {}
+
+    bool event(QEvent *e) Q_DECL_OVERRIDE;
+
+public Q_SLOTS:
+    void close();
+
+private:
+    void runTransaction(QQmlSqlTransaction *transaction);
+
+    QObject *m_receiver;
+    QHash<QString, QQmlSqlStatementCache *> m_statements; // by connection name
+};
+
+bool QQmlSqlDatabaseWorker::event(QEvent *e)
+{
+    if (e->type() == QEvent::User) {
+        QQmlSqlTransaction transaction = static_cast<QQmlSqlTransactionEvent *>(e)->transaction;
+        runTransaction(&transaction);
+        QCoreApplication::postEvent(m_receiver, new QQmlSqlTransactionEvent(transaction));
+        return true;
+    }
+    return QObject::event(e);
+}
+
+void QQmlSqlDatabaseWorker::runTransaction(QQmlSqlTransaction *transaction)
+{
+    const QString name = QLatin1String("QQmlSqlDatabaseWorker/")
+            + QString::number(quintptr(this), 16) + QLatin1Char('/') + transaction->databaseName;
+    if (!QSqlDatabase::contains(name)) {
+        QSqlDatabase database = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), name);
+        database.setDatabaseName(transaction->databaseName);
+    }
+    QQmlSqlStatementCache *&statements = m_statements[name];
+    if (!statements)
+        statements = new QQmlSqlStatementCache;
+
+    QSqlDatabase database = QSqlDatabase::database(name);
+    if (!database.isOpen()) {
+        transaction->errorCode = SQLEXCEPTION_DATABASE_ERR;
+        transaction->errorMessage = database.lastError().text();
+        return;
+    }
+
+    if (!database.transaction()) {
+        transaction->errorCode = SQLEXCEPTION_DATABASE_ERR;
+        transaction->errorMessage = database.lastError().text();
+        return;
+    }
+    for (int i = 0; i < transaction->statements.count(); ++i) {
+        const QQmlSqlStatement &statement = transaction->statements.at(i);
+        QQmlSqlStatementResult result;
+        QSqlQuery query;
+        if (!statements->prepare(database, statement, &query)
+                || !execSqlStatement(&query, statement, &result.rowsAffected)) {
+            transaction->errorStatement = i;
+            transaction->errorCode = SQLEXCEPTION_DATABASE_ERR;
+            transaction->errorMessage = query.lastError().text();
+            break;
+        }
+        if (query.isSelect()) {
+            while (query.next())
+                result.rows.append(query.record());
+        }
+        result.insertId = query.lastInsertId();
+        statements->release(statement.sql, &query);
+        transaction->results.append(result);
+    }
+
+    if (transaction->errorCode) {
+        database.rollback();
+    } else if (!database.commit()) {
+        database.rollback();
+        transaction->errorCode = SQLEXCEPTION_UNKNOWN_ERR;
+        transaction->errorMessage = QQmlEngine::tr("SQL transaction failed");
+    }
+}
+
+void QQmlSqlDatabaseWorker::close()
+{
+    for (auto it = m_statements.cbegin(), end = m_statements.cend(); it != end; ++it) {
+        delete it.value();
+        QSqlDatabase::removeDatabase(it.key());
+    }
+    m_statements.clear();
+}
+
+/*
+    Runs the transactions of transactionAsync() and readTransactionAsync() on a database
+    thread, and calls their callbacks with the results on the engine's thread.
+*/
+class QQmlSqlAsyncDatabase : public QObject
+{
+    Q_OBJECT
+public:
+    struct StatementCallbacks
+    {
+        QV4::PersistentValue result;
+        QV4::PersistentValue error;
+    };
+
+    struct PendingTransaction
+    {
+        QQmlSqlTransaction transaction;
+        QVector<StatementCallbacks> statementCallbacks;
+        QV4::PersistentValue errorCallback;
+        QV4::PersistentValue successCallback;
+    };
+
+    QQmlSqlAsyncDatabase(QV4::ExecutionEngine *engine);
+    ~QQmlSqlAsyncDatabase();
+
+    PendingTransaction *createTransaction(const QString &databaseName);
+    PendingTransaction *transaction(int id) const { return m_transactions.value(id); }
+    void run(int id);
+    void cancel(int id);
+
+    bool event(QEvent *e) Q_DECL_OVERRIDE;
+
+private:
+    void finishTransaction(const QQmlSqlTransaction &transaction);
+
+    QV4::ExecutionEngine *m_engine;
+    QThread m_thread;
+    QQmlSqlDatabaseWorker *m_worker;
+    QHash<int, PendingTransaction *> m_transactions;
+    int m_nextId;
+};
+
+QQmlSqlAsyncDatabase::QQmlSqlAsyncDatabase(QV4::ExecutionEngine *engine)
+    : m_engine(engine), m_worker(new QQmlSqlDatabaseWorker(this)), m_nextId(1)
+{
+    m_thread.setObjectName(QStringLiteral("QQmlSqlDatabaseWorker"));
+    m_worker->moveToThread(&m_thread);
+    m_thread.start();
+}
+
+QQmlSqlAsyncDatabase::~QQmlSqlAsyncDatabase()
+{
+    QMetaObject::invokeMethod(m_worker, "close", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+    delete m_worker;
+    qDeleteAll(m_transactions);
+}
+
+QQmlSqlAsyncDatabase::PendingTransaction *QQmlSqlAsyncDatabase::createTransaction(const QString &databaseName)
+{
+    PendingTransaction *pending = new PendingTransaction;
+    pending->transaction.id = m_nextId++;
+    pending->transaction.databaseName = databaseName;
+    m_transactions.insert(pending->transaction.id, pending);
+    return pending;
+}
+
+void QQmlSqlAsyncDatabase::run(int id)
+{
+    if (PendingTransaction *pending = m_transactions.value(id))
+        QCoreApplication::postEvent(m_worker, new QQmlSqlTransactionEvent(pending->transaction));
+}
+
+void QQmlSqlAsyncDatabase::cancel(int id)
+{
+    delete m_transactions.take(id);
+}
+
+bool QQmlSqlAsyncDatabase::event(QEvent *e)
+{
+    if (e->type() == QEvent::User) {
+        finishTransaction(static_cast<QQmlSqlTransactionEvent *>(e)->transaction);
+        return true;
+    }
+    return QObject::event(e);
+}
+
 
 class QQmlSqlDatabaseData : public QV8Engine::Deletable
 {
@@ -98,9 +419,19 @@ public:
     QQmlSqlDatabaseData(QV4::ExecutionEngine *engine);
     ~QQmlSqlDatabaseData();
 
+    QQmlSqlStatementCache *statementCache(const QSqlDatabase &database);
+    QQmlSqlAsyncDatabase *asyncDatabase();
+
     QV4::PersistentValue databaseProto;
     QV4::PersistentValue queryProto;
+    QV4::PersistentValue asyncQueryProto;
     QV4::PersistentValue rowsProto;
+    QV4::PersistentValue resultRowsProto;
+
+private:
+    QV4::ExecutionEngine *m_engine;
+    QHash<QString, QQmlSqlStatementCache *> m_statementCaches; // by connection name
+    QQmlSqlAsyncDatabase *m_asyncDatabase;
 };
 
 V4_DEFINE_EXTENSION(QQmlSqlDatabaseData, databaseData)
@@ -109,7 +440,7 @@ namespace QV4 {
 
 namespace Heap {
     struct QQmlSqlDatabaseWrapper : public Object {
-        enum Type { Database, Query, Rows };
+        enum Type { Database, Query, AsyncQuery, Rows };
         void init()
         {
             Object::init();
@@ -117,6 +448,7 @@ namespace Heap {
             database = new QSqlDatabase;
             version = new QString;
             sqlQuery = new QSqlQuery;
+            transactionId = 0;
         }
 
         void destroy() {
@@ -131,8 +463,9 @@ namespace Heap {
 
         QString *version; // type == Database
 
-        bool inTransaction; // type == Query
-        bool readonly;   // type == Query
+        bool inTransaction; // type == Query, AsyncQuery
+        bool readonly;   // type == Query, AsyncQuery
+        int transactionId; // type == AsyncQuery
 
         QSqlQuery *sqlQuery; // type == Rows
         bool forwardOnly; // type == Rows
@@ -213,25 +546,47 @@ static void qmlsqldatabase_rows_setForwardOnly(const QV4::BuiltinFunction *, QV4
 
 QQmlSqlDatabaseData::~QQmlSqlDatabaseData()
 {
+    delete m_asyncDatabase;
+    qDeleteAll(m_statementCaches);
 }
 
-static ReturnedValue qmlsqldatabase_rows_index(const QQmlSqlDatabaseWrapper *r, ExecutionEngine *v4, quint32 index, bool *hasProperty = 0)
+QQmlSqlStatementCache *QQmlSqlDatabaseData::statementCache(const QSqlDatabase &database)
+{
+    QQmlSqlStatementCache *&statements = m_statementCaches[database.connectionName()];
+    if (!statements)
+        statements = new QQmlSqlStatementCache;
+    return statements;
+}
+
+QQmlSqlAsyncDatabase *QQmlSqlDatabaseData::asyncDatabase()
+{
+    if (!m_asyncDatabase)
+        m_asyncDatabase = new QQmlSqlAsyncDatabase(m_engine);
+    return m_asyncDatabase;
+}
+
+static ReturnedValue qmlsqldatabase_row(ExecutionEngine *v4, const QSqlRecord &record)
 {
     Scope scope(v4);
+    // XXX optimize
+    ScopedObject row(scope, v4->newObject());
+    ScopedString s(scope);
+    ScopedValue val(scope);
+    for (int ii = 0; ii < record.count(); ++ii) {
+        QVariant v = record.value(ii);
+        s = v4->newIdentifier(record.fieldName(ii));
+        val = v.isNull() ? Encode::null() : v4->fromVariant(v);
+        row->put(s.getPointer(), val);
+    }
+    return row.asReturnedValue();
+}
 
+static ReturnedValue qmlsqldatabase_rows_index(const QQmlSqlDatabaseWrapper *r, ExecutionEngine *v4, quint32 index, bool *hasProperty = 0)
+{
     if (r->d()->sqlQuery->at() == (int)index || r->d()->sqlQuery->seek(index)) {
-        QSqlRecord record = r->d()->sqlQuery->record();
-        // XXX optimize
-        ScopedObject row(scope, v4->newObject());
-        for (int ii = 0; ii < record.count(); ++ii) {
-            QVariant v = record.value(ii);
-            ScopedString s(scope, v4->newIdentifier(record.fieldName(ii)));
-            ScopedValue val(scope, v.isNull() ? Encode::null() : v4->fromVariant(v));
-            row->put(s.getPointer(), val);
-        }
         if (hasProperty)
             *hasProperty = true;
-        return row.asReturnedValue();
+        return qmlsqldatabase_row(v4, r->d()->sqlQuery->record());
     } else {
         if (hasProperty)
             *hasProperty = false;
@@ -267,14 +622,70 @@ static QVariant toSqlVariant(QV4::ExecutionEngine *engine, const QV4::ScopedValu
     return engine->toVariant(value, /*typehint*/-1);
 }
 
-static void qmlsqldatabase_executeSql(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+static QQmlSqlBindings toSqlBindings(QV4::Scope &scope, const QV4::Value &values)
+{
+    QQmlSqlBindings bindings;
+    if (values.as<ArrayObject>()) {
+        ScopedArrayObject array(scope, values);
+        quint32 size = array->getLength();
+        QV4::ScopedValue v(scope);
+        for (quint32 ii = 0; ii < size; ++ii)
+            bindings.append(qMakePair(QVariant(int(ii)), toSqlVariant(scope.engine, (v = array->getIndexed(ii)))));
+    } else if (values.as<Object>()) {
+        ScopedObject object(scope, values);
+        ObjectIterator it(scope, object, ObjectIterator::WithProtoChain|ObjectIterator::EnumerableOnly);
+        ScopedValue key(scope);
+        QV4::ScopedValue val(scope);
+        while (1) {
+            key = it.nextPropertyName(val);
+            if (key->isNull())
+                break;
+            QVariant v = toSqlVariant(scope.engine, val);
+            if (key->isString()) {
+                bindings.append(qMakePair(QVariant(key->stringValue()->toQString()), v));
+            } else {
+                Q_ASSERT(key->isInteger());
+                bindings.append(qMakePair(QVariant(key->integerValue()), v));
+            }
+        }
+    } else {
+        bindings.append(qMakePair(QVariant(0), toSqlVariant(scope.engine, ScopedValue(scope, values))));
+    }
+    return bindings;
+}
+
+// Reads the (statement, values) arguments of executeSql(), or (statement, rows) of executeBatch().
+static QQmlSqlStatement toSqlStatement(QV4::Scope &scope, QV4::CallData *callData, bool isBatch, bool optionalValues)
+{
+    QQmlSqlStatement statement;
+    statement.sql = callData->argc ? callData->args[0].toQString() : QString();
+    statement.isBatch = isBatch;
+
+    if (callData->argc < 2 || (optionalValues && callData->args[1].isNullOrUndefined()))
+        return statement;
+
+    if (!isBatch) {
+        statement.bindings = toSqlBindings(scope, callData->args[1]);
+    } else if (callData->args[1].as<ArrayObject>()) {
+        ScopedArrayObject rows(scope, callData->args[1]);
+        quint32 size = rows->getLength();
+        QV4::ScopedValue row(scope);
+        for (quint32 ii = 0; ii < size; ++ii)
+            statement.batch.append(toSqlBindings(scope, (row = rows->getIndexed(ii))));
+    }
+    return statement;
+}
+
+static void qmlsqldatabase_execute_shared(QV4::Scope &scope, QV4::CallData *callData, bool isBatch)
 {
     QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, callData->thisObject.as<QQmlSqlDatabaseWrapper>());
     if (!r || r->d()->type != Heap::QQmlSqlDatabaseWrapper::Query)
         V4THROW_REFERENCE("Not a SQLDatabase::Query object");
 
-    if (!r->d()->inTransaction)
-        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR,QQmlEngine::tr("executeSql called outside transaction()"));
+    if (!r->d()->inTransaction) {
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR, isBatch ? QQmlEngine::tr("executeBatch called outside transaction()")
+                                                       : QQmlEngine::tr("executeSql called outside transaction()"));
+    }
 
     QSqlDatabase db = *r->d()->database;
 
@@ -284,68 +695,47 @@ static void qmlsqldatabase_executeSql(const QV4::BuiltinFunction *, QV4::Scope &
         V4THROW_SQL(SQLEXCEPTION_SYNTAX_ERR, QQmlEngine::tr("Read-only Transaction"));
     }
 
-    QSqlQuery query(db);
-    bool err = false;
-
-    ScopedValue result(scope, Primitive::undefinedValue());
+    QQmlSqlStatement statement = toSqlStatement(scope, callData, isBatch, false);
+    if (scope.hasException())
+        RETURN_UNDEFINED();
 
-    if (query.prepare(sql)) {
-        if (callData->argc > 1) {
-            ScopedValue values(scope, callData->args[1]);
-            if (values->as<ArrayObject>()) {
-                ScopedArrayObject array(scope, values);
-                quint32 size = array->getLength();
-                QV4::ScopedValue v(scope);
-                for (quint32 ii = 0; ii < size; ++ii) {
-                    query.bindValue(ii, toSqlVariant(scope.engine, (v = array->getIndexed(ii))));
-                }
-            } else if (values->as<Object>()) {
-                ScopedObject object(scope, values);
-                ObjectIterator it(scope, object, ObjectIterator::WithProtoChain|ObjectIterator::EnumerableOnly);
-                ScopedValue key(scope);
-                QV4::ScopedValue val(scope);
-                while (1) {
-                    key = it.nextPropertyName(val);
-                    if (key->isNull())
-                        break;
-                    QVariant v = toSqlVariant(scope.engine, val);
-                    if (key->isString()) {
-                        query.bindValue(key->stringValue()->toQString(), v);
-                    } else {
-                        Q_ASSERT(key->isInteger());
-                        query.bindValue(key->integerValue(), v);
-                    }
-                }
-            } else {
-                query.bindValue(0, toSqlVariant(scope.engine, values));
-            }
-        }
-        if (query.exec()) {
-            QV4::Scoped<QQmlSqlDatabaseWrapper> rows(scope, QQmlSqlDatabaseWrapper::create(scope.engine));
-            QV4::ScopedObject p(scope, databaseData(scope.engine)->rowsProto.value());
-            rows->setPrototype(p.getPointer());
-            rows->d()->type = Heap::QQmlSqlDatabaseWrapper::Rows;
-            *rows->d()->database = db;
-            *rows->d()->sqlQuery = query;
-
-            ScopedObject resultObject(scope, scope.engine->newObject());
-            result = resultObject.asReturnedValue();
-            // XXX optimize
-            ScopedString s(scope);
-            ScopedValue v(scope);
-            resultObject->put((s = scope.engine->newIdentifier("rowsAffected")).getPointer(), (v = Primitive::fromInt32(query.numRowsAffected())));
-            resultObject->put((s = scope.engine->newIdentifier("insertId")).getPointer(), (v = scope.engine->newString(query.lastInsertId().toString())));
-            resultObject->put((s = scope.engine->newIdentifier("rows")).getPointer(), rows);
-        } else {
-            err = true;
-        }
-    } else {
-        err = true;
-    }
-    if (err)
+    QQmlSqlStatementCache *statements = databaseData(scope.engine)->statementCache(db);
+    QSqlQuery query;
+    int rowsAffected = 0;
+    if (!statements->prepare(db, statement, &query) || !execSqlStatement(&query, statement, &rowsAffected))
         V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR,query.lastError().text());
 
-    RETURN_RESULT(result->asReturnedValue());
+    QV4::Scoped<QQmlSqlDatabaseWrapper> rows(scope, QQmlSqlDatabaseWrapper::create(scope.engine));
+    QV4::ScopedObject p(scope, databaseData(scope.engine)->rowsProto.value());
+    rows->setPrototype(p.getPointer());
+    rows->d()->type = Heap::QQmlSqlDatabaseWrapper::Rows;
+    *rows->d()->database = db;
+
+    ScopedObject resultObject(scope, scope.engine->newObject());
+    // XXX optimize
+    ScopedString s(scope);
+    ScopedValue v(scope);
+    resultObject->put((s = scope.engine->newIdentifier("rowsAffected")).getPointer(), (v = Primitive::fromInt32(rowsAffected)));
+    resultObject->put((s = scope.engine->newIdentifier("insertId")).getPointer(), (v = scope.engine->newString(query.lastInsertId().toString())));
+    resultObject->put((s = scope.engine->newIdentifier("rows")).getPointer(), rows);
+
+    // The rows read their result lazily, only other statements can stay prepared.
+    if (query.isSelect())
+        *rows->d()->sqlQuery = query;
+    else
+        statements->release(statement.sql, &query);
+
+    RETURN_RESULT(resultObject.asReturnedValue());
+}
+
+static void qmlsqldatabase_executeSql(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_execute_shared(scope, callData, false);
+}
+
+static void qmlsqldatabase_executeBatch(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_execute_shared(scope, callData, true);
 }
 
 struct TransactionRollback {
@@ -479,7 +869,190 @@ static void qmlsqldatabase_read_transaction(const QV4::BuiltinFunction *f, QV4::
     qmlsqldatabase_transaction_shared(f, scope, callData, true);
 }
 
+static void qmlsqldatabase_execute_async_shared(QV4::Scope &scope, QV4::CallData *callData, bool isBatch)
+{
+    QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, callData->thisObject.as<QQmlSqlDatabaseWrapper>());
+    if (!r || r->d()->type != Heap::QQmlSqlDatabaseWrapper::AsyncQuery)
+        V4THROW_REFERENCE("Not a SQLDatabase::Query object");
+
+    if (!r->d()->inTransaction) {
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR, isBatch ? QQmlEngine::tr("executeBatch called outside transactionAsync()")
+                                                       : QQmlEngine::tr("executeSql called outside transactionAsync()"));
+    }
+
+    QString sql = callData->argc ? callData->args[0].toQString() : QString();
+
+    if (r->d()->readonly && !sql.startsWith(QLatin1String("SELECT"),Qt::CaseInsensitive)) {
+        V4THROW_SQL(SQLEXCEPTION_SYNTAX_ERR, QQmlEngine::tr("Read-only Transaction"));
+    }
+
+    QQmlSqlStatement statement = toSqlStatement(scope, callData, isBatch, true);
+    if (scope.hasException())
+        RETURN_UNDEFINED();
+
+    QQmlSqlAsyncDatabase::PendingTransaction *transaction
+            = databaseData(scope.engine)->asyncDatabase()->transaction(r->d()->transactionId);
+    Q_ASSERT(transaction);
+
+    QQmlSqlAsyncDatabase::StatementCallbacks callbacks;
+    if (callData->argc > 2 && callData->args[2].as<FunctionObject>())
+        callbacks.result.set(scope.engine, callData->args[2]);
+    if (callData->argc > 3 && callData->args[3].as<FunctionObject>())
+        callbacks.error.set(scope.engine, callData->args[3]);
+
+    transaction->transaction.statements.append(statement);
+    transaction->statementCallbacks.append(callbacks);
+
+    RETURN_UNDEFINED();
+}
+
+static void qmlsqldatabase_executeSqlAsync(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_execute_async_shared(scope, callData, false);
+}
+
+static void qmlsqldatabase_executeBatchAsync(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_execute_async_shared(scope, callData, true);
+}
+
+static void qmlsqldatabase_transaction_async_shared(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData, bool readOnly)
+{
+    QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, callData->thisObject.as<QQmlSqlDatabaseWrapper>());
+    if (!r || r->d()->type != Heap::QQmlSqlDatabaseWrapper::Database)
+        V4THROW_REFERENCE("Not a SQLDatabase object");
+
+    ScopedFunctionObject callback(scope, callData->argc ? callData->args[0] : Primitive::undefinedValue());
+    if (!callback)
+        V4THROW_SQL(SQLEXCEPTION_UNKNOWN_ERR, QQmlEngine::tr("transaction: missing callback"));
+
+    QQmlSqlAsyncDatabase *asyncDatabase = databaseData(scope.engine)->asyncDatabase();
+    QQmlSqlAsyncDatabase::PendingTransaction *transaction
+            = asyncDatabase->createTransaction(r->d()->database->databaseName());
+    if (callData->argc > 1 && callData->args[1].as<FunctionObject>())
+        transaction->errorCallback.set(scope.engine, callData->args[1]);
+    if (callData->argc > 2 && callData->args[2].as<FunctionObject>())
+        transaction->successCallback.set(scope.engine, callData->args[2]);
+    const int id = transaction->transaction.id;
+
+    Scoped<QQmlSqlDatabaseWrapper> w(scope, QQmlSqlDatabaseWrapper::create(scope.engine));
+    QV4::ScopedObject p(scope, databaseData(scope.engine)->asyncQueryProto.value());
+    w->setPrototype(p.getPointer());
+    w->d()->type = Heap::QQmlSqlDatabaseWrapper::AsyncQuery;
+    *w->d()->database = *r->d()->database;
+    *w->d()->version = *r->d()->version;
+    w->d()->readonly = readOnly;
+    w->d()->transactionId = id;
+
+    // The callback only collects the statements, they are run once it has returned.
+    {
+        ScopedCallData callData(scope, 1);
+        callData->thisObject = scope.engine->globalObject;
+        callData->args[0] = w;
+        w->d()->inTransaction = true;
+        callback->call(scope, callData);
+        w->d()->inTransaction = false;
+    }
+
+    if (scope.hasException())
+        asyncDatabase->cancel(id);
+    else
+        asyncDatabase->run(id);
+
+    RETURN_UNDEFINED();
+}
+
+static void qmlsqldatabase_transactionAsync(const QV4::BuiltinFunction *f, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_transaction_async_shared(f, scope, callData, false);
+}
+
+static void qmlsqldatabase_readTransactionAsync(const QV4::BuiltinFunction *f, QV4::Scope &scope, QV4::CallData *callData)
+{
+    qmlsqldatabase_transaction_async_shared(f, scope, callData, true);
+}
+
+static void qmlsqldatabase_result_rows_item(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData)
+{
+    QV4::ScopedObject rows(scope, callData->thisObject);
+    if (!rows)
+        V4THROW_REFERENCE("Not a SQLDatabase::Rows object");
+
+    RETURN_RESULT(rows->getIndexed(callData->argc ? callData->args[0].toUInt32() : 0));
+}
+
+static ReturnedValue qmlsqldatabase_result(ExecutionEngine *v4, const QQmlSqlStatementResult &result)
+{
+    Scope scope(v4);
+
+    // The rows of an asynchronous result are read in full on the database thread.
+    ScopedArrayObject rows(scope, v4->newArrayObject());
+    ScopedObject p(scope, databaseData(v4)->resultRowsProto.value());
+    rows->setPrototype(p.getPointer());
+    ScopedValue row(scope);
+    for (int ii = 0; ii < result.rows.count(); ++ii)
+        rows->putIndexed(ii, (row = qmlsqldatabase_row(v4, result.rows.at(ii))));
+
+    ScopedObject resultObject(scope, v4->newObject());
+    ScopedString s(scope);
+    ScopedValue v(scope);
+    resultObject->put((s = v4->newIdentifier("rowsAffected")).getPointer(), (v = Primitive::fromInt32(result.rowsAffected)));
+    resultObject->put((s = v4->newIdentifier("insertId")).getPointer(), (v = v4->newString(result.insertId.toString())));
+    resultObject->put((s = v4->newIdentifier("rows")).getPointer(), rows);
+    return resultObject.asReturnedValue();
+}
+
+static ReturnedValue qmlsqldatabase_error(ExecutionEngine *v4, int code, const QString &message)
+{
+    Scope scope(v4);
+    ScopedString v(scope, v4->newString(message));
+    ScopedObject ex(scope, v4->newErrorObject(v));
+    ex->put(ScopedString(scope, v4->newIdentifier(QStringLiteral("code"))).getPointer(), ScopedValue(scope, Primitive::fromInt32(code)));
+    return ex.asReturnedValue();
+}
+
+static void qmlsqldatabase_callback(Scope &scope, const PersistentValue &function, const Value *argument = 0)
+{
+    ScopedFunctionObject callback(scope, function.value());
+    if (!callback)
+        return;
+
+    ScopedCallData callData(scope, argument ? 1 : 0);
+    callData->thisObject = scope.engine->globalObject;
+    if (argument)
+        callData->args[0] = *argument;
+    callback->call(scope, callData);
+    if (scope.hasException()) {
+        QQmlError error = scope.engine->catchExceptionAsQmlError();
+        QQmlEnginePrivate::warning(scope.engine->qmlEngine(), error);
+    }
+}
+
+void QQmlSqlAsyncDatabase::finishTransaction(const QQmlSqlTransaction &transaction)
+{
+    QScopedPointer<PendingTransaction> pending(m_transactions.take(transaction.id));
+    if (!pending)
+        return;
+
+    Scope scope(m_engine);
+    ScopedValue value(scope);
+    for (int i = 0; i < transaction.results.count(); ++i) {
+        value = qmlsqldatabase_result(m_engine, transaction.results.at(i));
+        qmlsqldatabase_callback(scope, pending->statementCallbacks.at(i).result, value);
+    }
+
+    if (transaction.errorCode) {
+        value = qmlsqldatabase_error(m_engine, transaction.errorCode, transaction.errorMessage);
+        if (transaction.errorStatement != -1)
+            qmlsqldatabase_callback(scope, pending->statementCallbacks.at(transaction.errorStatement).error, value);
+        qmlsqldatabase_callback(scope, pending->errorCallback, value);
+    } else {
+        qmlsqldatabase_callback(scope, pending->successCallback);
+    }
+}
+
 QQmlSqlDatabaseData::QQmlSqlDatabaseData(ExecutionEngine *v4)
+    : m_engine(v4), m_asyncDatabase(0)
 {
     Scope scope(v4);
     {
@@ -488,14 +1061,23 @@ QQmlSqlDatabaseData::QQmlSqlDatabaseData(ExecutionEngine *v4)
         proto->defineDefaultProperty(QStringLiteral("readTransaction"), qmlsqldatabase_read_transaction);
         proto->defineAccessorProperty(QStringLiteral("version"), qmlsqldatabase_version, 0);
         proto->defineDefaultProperty(QStringLiteral("changeVersion"), qmlsqldatabase_changeVersion);
+        proto->defineDefaultProperty(QStringLiteral("transactionAsync"), qmlsqldatabase_transactionAsync);
+        proto->defineDefaultProperty(QStringLiteral("readTransactionAsync"), qmlsqldatabase_readTransactionAsync);
         databaseProto = proto;
     }
 
     {
         ScopedObject proto(scope, v4->newObject());
         proto->defineDefaultProperty(QStringLiteral("executeSql"), qmlsqldatabase_executeSql);
+        proto->defineDefaultProperty(QStringLiteral("executeBatch"), qmlsqldatabase_executeBatch);
         queryProto = proto;
     }
+    {
+        ScopedObject proto(scope, v4->newObject());
+        proto->defineDefaultProperty(QStringLiteral("executeSql"), qmlsqldatabase_executeSqlAsync);
+        proto->defineDefaultProperty(QStringLiteral("executeBatch"), qmlsqldatabase_executeBatchAsync);
+        asyncQueryProto = proto;
+    }
     {
         ScopedObject proto(scope, v4->newObject());
         proto->defineDefaultProperty(QStringLiteral("item"), qmlsqldatabase_rows_item);
@@ -504,6 +1086,12 @@ QQmlSqlDatabaseData::QQmlSqlDatabaseData(ExecutionEngine *v4)
                                       qmlsqldatabase_rows_forwardOnly, qmlsqldatabase_rows_setForwardOnly);
         rowsProto = proto;
     }
+    {
+        ScopedObject proto(scope, v4->newObject());
+        proto->setPrototype(v4->arrayPrototype());
+        proto->defineDefaultProperty(QStringLiteral("item"), qmlsqldatabase_result_rows_item);
+        resultRowsProto = proto;
+    }
 }
 
 /*
@@ -657,6 +1245,60 @@ See below for an example:
 
 \snippet qml/localstorage/dbtransaction.js 1
 
+Statements are kept prepared by the database connection, so executing the same statement
+again, with new values, does not compile it again.
+
+\section3 results = tx.executeBatch(statement, rows)
+
+This method executes an SQL \e statement once for each entry of the array \e rows, binding the
+values of the entry to the parameters of the statement as \e executeSql does. The statement is
+only prepared once.
+
+It returns a results object as \e executeSql does, where \c rowsAffected is the sum of the rows
+affected by all executions. If one of the executions fails, an exception is thrown and the rows
+that follow are not executed.
+
+\code
+db.transaction(function(tx) {
+    tx.executeBatch('INSERT INTO Greeting VALUES(?, ?)', [ [ 'hello', 'world' ], [ 'hi', 'there' ] ]);
+});
+\endcode
+
+\section3 db.transactionAsync(callback(tx), errorCallback(error), successCallback())
+
+This method creates a read/write transaction and passes it to \e callback, like
+\e db.transaction does, but the statements of the transaction are run on a separate thread
+after \e callback has returned, so that the user interface is not blocked while they run.
+
+Within \e callback, \c{tx.executeSql(statement, values, resultCallback(results), errorCallback(error))}
+and \c{tx.executeBatch(statement, rows, resultCallback(results), errorCallback(error))} queue a
+statement instead of running it, and return nothing. When the transaction has been run, the
+\e resultCallback of each statement is called, in order, with a results object as returned by
+the synchronous methods; \c rows of the results is an array that also provides \c item().
+All callbacks are optional and are called on the thread of the QML engine.
+
+If a statement fails, the transaction is rolled back, the \e errorCallback of the statement and then
+the \e errorCallback of the transaction are called with an error that has a \c code property;
+otherwise \e successCallback is called once the transaction has been committed. If \e callback
+throws an exception, no statement of the transaction is run.
+
+\code
+db.transactionAsync(function(tx) {
+    tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'hello', 'world' ]);
+    tx.executeSql('SELECT * FROM Greeting', [], function(rs) {
+        for (var i = 0; i < rs.rows.length; i++)
+            console.log(rs.rows[i].salutation + ", " + rs.rows[i].salutee);
+    });
+}, function(error) {
+    console.log("Transaction failed: " + error.message);
+});
+\endcode
+
+\section3 db.readTransactionAsync(callback(tx), errorCallback(error), successCallback())
+
+This method creates a read-only transaction that is run like the ones created by
+\e db.transactionAsync.
+
 \section1 Method Documentation
 
 \target openDatabaseSync
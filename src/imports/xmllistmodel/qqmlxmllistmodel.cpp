@@ -58,6 +58,10 @@
 #include <QNetworkReply>
 #include <QTimer>
 #include <QMutex>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QXmlStreamReader>
+#include <QtCore/qnumeric.h>
 
 #include <private/qabstractitemmodel_p.h>
 
@@ -71,6 +75,10 @@ typedef QPair<int, int> QQuickXmlListRange;
 
 #define XMLLISTMODEL_CLEAR_ID 0
 
+// Rows read by a streaming query are sent to the model in batches which double in size
+#define XMLLISTMODEL_FIRST_BATCH 64
+#define XMLLISTMODEL_MAX_BATCH 4096
+
 /*!
     \qmlmodule QtQuick.XmlListModel 2
     \title Qt Quick XmlListModel QML Types
@@ -159,14 +167,129 @@ struct XmlQueryJob
     int queryId;
     QByteArray data;
     QString query;
+    QString modelQuery;
     QString namespaces;
     QStringList roleQueries;
     QList<void*> roleQueryErrorId; // the ptr to send back if there is an error
     QStringList keyRoleQueries;
+    QList<int> keyRoleIndexes;
     QStringList keyRoleResultsCache;
     QString prefix;
 };
 
+/*
+    A query that selects elements by name from the root of the document, and role queries that
+    select the string or number value of a child element or attribute, can be answered in a
+    single pass over the document with a QXmlStreamReader.
+*/
+struct XmlStreamPath
+{
+    XmlStreamPath() : isNumber(false) {}
+
+    QStringList elements;
+    QString attribute;
+    bool isNumber;
+};
+
+static bool isXmlStreamName(const QString &name)
+{
+    if (name.isEmpty() || !(name.at(0).isLetter() || name.at(0) == QLatin1Char('_')))
+        return false;
+    for (const QChar c : name) {
+        if (!(c.isLetterOrNumber() || c == QLatin1Char('_') || c == QLatin1Char('-') || c == QLatin1Char('.')))
+            return false;
+    }
+    return true;
+}
+
+static bool parseXmlStreamItemPath(const QString &query, QStringList *elements)
+{
+    if (!query.startsWith(QLatin1Char('/')))
+        return false;
+    *elements = query.mid(1).split(QLatin1Char('/'));
+    for (const QString &element : qAsConst(*elements)) {
+        if (!isXmlStreamName(element))
+            return false;
+    }
+    return true;
+}
+
+static bool parseXmlStreamRolePath(const QString &query, XmlStreamPath *path)
+{
+    QStringList steps = query.split(QLatin1Char('/'));
+    const QString function = steps.takeLast();
+    if (function == QLatin1String("number()"))
+        path->isNumber = true;
+    else if (function != QLatin1String("string()"))
+        return false;
+
+    if (!steps.isEmpty() && steps.last().startsWith(QLatin1Char('@'))) {
+        path->attribute = steps.takeLast().mid(1);
+        if (!isXmlStreamName(path->attribute))
+            return false;
+    }
+    for (const QString &step : qAsConst(steps)) {
+        if (!isXmlStreamName(step))
+            return false;
+    }
+    path->elements = steps;
+    return true;
+}
+
+static QVariant xmlStreamValue(const XmlStreamPath &path, bool found, const QString &text)
+{
+    // As with the XPath queries, a missing or empty value is an empty string for either type.
+    if (!found || !path.isNumber)
+        return found ? text : QString();
+    const QString trimmed = text.trimmed();
+    if (trimmed.isEmpty())
+        return QString();
+    bool ok = false;
+    const double number = trimmed.toDouble(&ok);
+    return ok ? number : qQNaN();
+}
+
+class QQuickXmlQueryTask : public QRunnable
+{
+public:
+    QQuickXmlQueryTask(const QByteArray &data, const QString &query)
+        : m_data(data), m_query(query), m_valid(false)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        QBuffer buffer(&m_data);
+        buffer.open(QIODevice::ReadOnly);
+        QXmlQuery query;
+        query.bindVariable(QLatin1String("inputDocument"), &buffer);
+        query.setQuery(m_query);
+        m_valid = query.isValid();
+        if (!m_valid)
+            return;
+
+        QXmlResultItems resultItems;
+        query.evaluateTo(&resultItems);
+        QXmlItem item(resultItems.next());
+        while (!item.isNull()) {
+            m_values << item.toAtomicValue(); //### we used to trim strings
+            item = resultItems.next();
+        }
+    }
+
+    bool isValid() const { return m_valid; }
+    QList<QVariant> values() const { return m_values; }
+
+private:
+    QByteArray m_data;
+    QString m_query;
+    QList<QVariant> m_values;
+    bool m_valid;
+};
+
 
 class QQuickXmlQueryEngine;
 class QQuickXmlQueryThreadObject : public QObject
@@ -199,6 +322,7 @@ public:
 
 signals:
     void queryCompleted(const QQuickXmlQueryResult &);
+    void queryRowsReady(const QQuickXmlQueryResult &);
     void error(void*, const QString&);
 
 protected:
@@ -206,12 +330,16 @@ protected:
 
 private:
     void processQuery(XmlQueryJob *job);
+    bool doStreamQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
+    bool sendRows(const XmlQueryJob &job, int from, int to, QList<QList<QVariant> > *data);
     void doQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void doSubQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
-    void getValuesOfKeyRoles(const XmlQueryJob& currentJob, QStringList *values, QXmlQuery *query) const;
+    QString keyRolesQuery(const XmlQueryJob &currentJob) const;
+    void setKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const;
     void addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const;
 
     QMutex m_mutex;
+    QThreadPool m_queryPool;
     QQuickXmlQueryThreadObject *m_threadObject;
     QList<XmlQueryJob> m_jobs;
     QSet<int> m_cancelledJobs;
@@ -282,6 +410,7 @@ int QQuickXmlQueryEngine::doQuery(QString query, QString namespaces, QByteArray
     job.queryId = m_queryIds.load();
     job.data = data;
     job.query = QLatin1String("doc($src)") + query;
+    job.modelQuery = query;
     job.namespaces = namespaces;
     job.keyRoleResultsCache = keyRoleResultsCache;
 
@@ -292,8 +421,10 @@ int QQuickXmlQueryEngine::doQuery(QString query, QString namespaces, QByteArray
         }
         job.roleQueries << roleObjects->at(i)->query();
         job.roleQueryErrorId << static_cast<void*>(roleObjects->at(i));
-        if (roleObjects->at(i)->isKey())
+        if (roleObjects->at(i)->isKey()) {
             job.keyRoleQueries << job.roleQueries.last();
+            job.keyRoleIndexes << i;
+        }
     }
 
     {
@@ -364,8 +495,10 @@ void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
 {
     QQuickXmlQueryResult result;
     result.queryId = job->queryId;
-    doQueryJob(job, &result);
-    doSubQueryJob(job, &result);
+    if (!doStreamQueryJob(job, &result)) {
+        doQueryJob(job, &result);
+        doSubQueryJob(job, &result);
+    }
 
     {
         QMutexLocker ml(&m_mutex);
@@ -377,6 +510,151 @@ void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
     }
 }
 
+bool QQuickXmlQueryEngine::doStreamQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+{
+    Q_ASSERT(currentJob->queryId != -1);
+
+    QStringList itemElements;
+    if (!currentJob->namespaces.isEmpty() || !parseXmlStreamItemPath(currentJob->modelQuery, &itemElements))
+        return false;
+
+    const QStringList &queries = currentJob->roleQueries;
+    const int roleCount = queries.count();
+    QVector<XmlStreamPath> roles(roleCount);
+    for (int i = 0; i < roleCount; ++i) {
+        if (!queries.at(i).isEmpty() && !parseXmlStreamRolePath(queries.at(i), &roles[i]))
+            return false;
+    }
+
+    // Rows can be sent to the model as they are read unless key roles have to be compared
+    // with those of the previous results.
+    const bool sendBatches = currentJob->keyRoleQueries.isEmpty();
+
+    QList<QList<QVariant> > data;
+    for (int i = 0; i < roleCount; ++i)
+        data << QList<QVariant>();
+    QStringList keyRoleResults;
+    int rows = 0;
+    int sentRows = 0;
+    int batchSize = XMLLISTMODEL_FIRST_BATCH;
+
+    QStringList path;   // The names of the open elements, or an empty string for a namespaced one.
+    int itemDepth = -1; // The depth of the current item, or -1 outside of an item.
+    QVector<int> textDepth(roleCount, -1); // The depth of the element whose text is being read.
+    QVector<bool> found(roleCount);
+    QVector<QString> text(roleCount);
+
+    QXmlStreamReader reader(currentJob->data);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement:
+            path.append(reader.namespaceUri().isEmpty() ? reader.name().toString() : QString());
+            if (itemDepth == -1) {
+                if (path != itemElements)
+                    break;
+                itemDepth = path.count();
+                found.fill(false);
+                textDepth.fill(-1);
+            }
+            for (int i = 0; i < roleCount; ++i) {
+                const XmlStreamPath &role = roles.at(i);
+                if (queries.at(i).isEmpty() || found.at(i) || textDepth.at(i) != -1
+                        || role.elements.count() != path.count() - itemDepth
+                        || !std::equal(role.elements.constBegin(), role.elements.constEnd(), path.constBegin() + itemDepth)) {
+                    continue;
+                }
+                if (role.attribute.isEmpty()) {
+                    textDepth[i] = path.count();
+                    text[i].clear();
+                } else if (reader.attributes().hasAttribute(role.attribute)) {
+                    text[i] = reader.attributes().value(role.attribute).toString();
+                    found[i] = true;
+                }
+            }
+            break;
+        case QXmlStreamReader::Characters:
+            for (int i = 0; i < roleCount && itemDepth != -1; ++i) {
+                if (textDepth.at(i) != -1)
+                    text[i] += reader.text();
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            for (int i = 0; i < roleCount && itemDepth != -1; ++i) {
+                if (textDepth.at(i) == path.count()) {
+                    textDepth[i] = -1;
+                    found[i] = true;
+                }
+            }
+            if (path.count() == itemDepth) {
+                itemDepth = -1;
+                for (int i = 0; i < roleCount; ++i) {
+                    if (!queries.at(i).isEmpty())
+                        data[i] << xmlStreamValue(roles.at(i), found.at(i), text.at(i));
+                    else
+                        data[i] << QVariant();
+                }
+                ++rows;
+                if (!sendBatches) {
+                    QString key;
+                    for (int i : qAsConst(currentJob->keyRoleIndexes))
+                        key += data.at(i).last().toString();
+                    keyRoleResults << key;
+                } else if (rows - sentRows == batchSize) {
+                    if (!sendRows(*currentJob, sentRows, rows, &data))
+                        return true;
+                    sentRows = rows;
+                    batchSize = qMin(2 * batchSize, XMLLISTMODEL_MAX_BATCH);
+                }
+            }
+            path.removeLast();
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (reader.hasError()) {
+        // A malformed document has no items, so any rows that were sent are removed again.
+        for (int i = 0; i < roleCount; ++i)
+            data[i].clear();
+        keyRoleResults.clear();
+        rows = 0;
+        sentRows = 0;
+    }
+
+    currentResult->size = rows;
+    currentResult->data = data;
+    if (sendBatches) {
+        currentResult->incremental = true;
+        currentResult->inserted << qMakePair(sentRows, rows - sentRows);
+    } else {
+        setKeyRoleResults(*currentJob, keyRoleResults, currentResult);
+    }
+    return true;
+}
+
+/*
+    Sends the rows from \a from to \a to of a streaming query to the model, unless the query
+    has been cancelled.
+*/
+bool QQuickXmlQueryEngine::sendRows(const XmlQueryJob &job, int from, int to, QList<QList<QVariant> > *data)
+{
+    QQuickXmlQueryResult result;
+    result.queryId = job.queryId;
+    result.size = to;
+    result.data = *data;
+    result.inserted << qMakePair(from, to - from);
+    result.incremental = true;
+    for (int i = 0; i < data->count(); ++i)
+        (*data)[i].clear();
+
+    QMutexLocker ml(&m_mutex);
+    if (m_cancelledJobs.contains(job.queryId))
+        return false;
+    emit queryRowsReady(result);
+    return true;
+}
+
 void QQuickXmlQueryEngine::doQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
 {
     Q_ASSERT(currentJob->queryId != -1);
@@ -415,7 +693,7 @@ void QQuickXmlQueryEngine::doQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryRes
     currentResult->size = (count > 0 ? count : 0);
 }
 
-void QQuickXmlQueryEngine::getValuesOfKeyRoles(const XmlQueryJob& currentJob, QStringList *values, QXmlQuery *query) const
+QString QQuickXmlQueryEngine::keyRolesQuery(const XmlQueryJob &currentJob) const
 {
     const QStringList &keysQueries = currentJob.keyRoleQueries;
     QString keysQuery;
@@ -423,17 +701,7 @@ void QQuickXmlQueryEngine::getValuesOfKeyRoles(const XmlQueryJob& currentJob, QS
         keysQuery = currentJob.prefix + keysQueries[0];
     else if (keysQueries.count() > 1)
         keysQuery = currentJob.prefix + QLatin1String("concat(") + keysQueries.join(QLatin1Char(',')) + QLatin1Char(')');
-
-    if (!keysQuery.isEmpty()) {
-        query->setQuery(keysQuery);
-        QXmlResultItems resultItems;
-        query->evaluateTo(&resultItems);
-        QXmlItem item(resultItems.next());
-        while (!item.isNull()) {
-            values->append(item.toAtomicValue().toString());
-            item = resultItems.next();
-        }
-    }
+    return keysQuery;
 }
 
 void QQuickXmlQueryEngine::addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const {
@@ -445,31 +713,20 @@ void QQuickXmlQueryEngine::addIndexToRangeList(QList<QQuickXmlListRange> *ranges
         ranges->append(qMakePair(index, 1));
 }
 
-void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+void QQuickXmlQueryEngine::setKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const
 {
-    Q_ASSERT(currentJob->queryId != -1);
-
-    QBuffer b(&currentJob->data);
-    b.open(QIODevice::ReadOnly);
-
-    QXmlQuery subquery;
-    subquery.bindVariable(QLatin1String("inputDocument"), &b);
-
-    QStringList keyRoleResults;
-    getValuesOfKeyRoles(*currentJob, &keyRoleResults, &subquery);
-
     // See if any values of key roles have been inserted or removed.
 
-    if (currentJob->keyRoleResultsCache.isEmpty()) {
+    if (currentJob.keyRoleResultsCache.isEmpty()) {
         currentResult->inserted << qMakePair(0, currentResult->size);
     } else {
-        if (keyRoleResults != currentJob->keyRoleResultsCache) {
+        if (keyRoleResults != currentJob.keyRoleResultsCache) {
             QStringList temp;
-            for (int i=0; i<currentJob->keyRoleResultsCache.count(); i++) {
-                if (!keyRoleResults.contains(currentJob->keyRoleResultsCache[i]))
+            for (int i=0; i<currentJob.keyRoleResultsCache.count(); i++) {
+                if (!keyRoleResults.contains(currentJob.keyRoleResultsCache[i]))
                     addIndexToRangeList(&currentResult->removed, i);
                 else
-                    temp << currentJob->keyRoleResultsCache[i];
+                    temp << currentJob.keyRoleResultsCache[i];
             }
             for (int i=0; i<keyRoleResults.count(); i++) {
                 if (temp.count() == i || keyRoleResults[i] != temp[i]) {
@@ -480,32 +737,56 @@ void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQuery
         }
     }
     currentResult->keyRoleResultsCache = keyRoleResults;
+}
+
+void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+{
+    Q_ASSERT(currentJob->queryId != -1);
+
+    // The key roles and each of the roles are independent queries of the same document, so
+    // they are evaluated in parallel.
+    QQuickXmlQueryTask *keyTask = 0;
+    const QString keysQuery = keyRolesQuery(*currentJob);
+    if (!keysQuery.isEmpty()) {
+        keyTask = new QQuickXmlQueryTask(currentJob->data, keysQuery);
+        m_queryPool.start(keyTask);
+    }
 
-    // Get the new values for each role.
     //### we might be able to condense even further (query for everything in one go)
     const QStringList &queries = currentJob->roleQueries;
+    QVector<QQuickXmlQueryTask *> roleTasks(queries.size());
     for (int i = 0; i < queries.size(); ++i) {
-        QList<QVariant> resultList;
         if (!queries[i].isEmpty()) {
-            subquery.setQuery(currentJob->prefix + QLatin1String("(let $v := string(") + queries[i] + QLatin1String(") return if ($v) then ") + queries[i] + QLatin1String(" else \"\")"));
-            if (subquery.isValid()) {
-                QXmlResultItems resultItems;
-                subquery.evaluateTo(&resultItems);
-                QXmlItem item(resultItems.next());
-                while (!item.isNull()) {
-                    resultList << item.toAtomicValue(); //### we used to trim strings
-                    item = resultItems.next();
-                }
-            } else {
+            roleTasks[i] = new QQuickXmlQueryTask(currentJob->data, currentJob->prefix + QLatin1String("(let $v := string(") + queries[i] + QLatin1String(") return if ($v) then ") + queries[i] + QLatin1String(" else \"\")"));
+            m_queryPool.start(roleTasks[i]);
+        }
+    }
+    m_queryPool.waitForDone();
+
+    QStringList keyRoleResults;
+    if (keyTask) {
+        const QList<QVariant> keyValues = keyTask->values();
+        for (const QVariant &value : keyValues)
+            keyRoleResults << value.toString();
+        delete keyTask;
+    }
+    setKeyRoleResults(*currentJob, keyRoleResults, currentResult);
+
+    // Get the new values for each role.
+    for (int i = 0; i < queries.size(); ++i) {
+        QList<QVariant> resultList;
+        if (QQuickXmlQueryTask *task = roleTasks.at(i)) {
+            if (task->isValid())
+                resultList = task->values();
+            else
                 emit error(currentJob->roleQueryErrorId.at(i), queries[i]);
-            }
         }
         //### should warn here if things have gone wrong.
         while (resultList.count() < currentResult->size)
             resultList << QVariant();
         currentResult->data << resultList;
-        b.seek(0);
     }
+    qDeleteAll(roleTasks);
 
     //this method is much slower, but works better for incremental loading
     /*for (int j = 0; j < m_size; ++j) {
@@ -692,6 +973,14 @@ void QQuickXmlListModelPrivate::clear_role(QQmlListProperty<QQuickXmlListModelRo
     Note this means when XmlListModel is used for a view, the view is not
     populated until the model is loaded.
 
+    If the \l query selects elements by name from the root of the document, like
+    "/rss/channel/item" above, each role query reads the \c string() or \c number() value of a
+    child element or attribute, like "title/string()" or "@id/string()", and no
+    \l namespaceDeclarations are set, the document is read in a single pass.  Unless key roles
+    are used, the items are then added to the model in batches while it is still loading, so
+    a view shows the first items of a large document early.  Other queries are evaluated with
+    XQuery, with the role queries run in parallel.
+
 
     \section2 Using Key XML Roles
 
@@ -1000,6 +1289,8 @@ void QQuickXmlListModel::classBegin()
     QQuickXmlQueryEngine *queryEngine = QQuickXmlQueryEngine::instance(qmlEngine(this));
     connect(queryEngine, SIGNAL(queryCompleted(QQuickXmlQueryResult)),
             SLOT(queryCompleted(QQuickXmlQueryResult)));
+    connect(queryEngine, SIGNAL(queryRowsReady(QQuickXmlQueryResult)),
+            SLOT(queryRowsReady(QQuickXmlQueryResult)));
     connect(queryEngine, SIGNAL(error(void*,QString)),
             SLOT(queryError(void*,QString)));
 }
@@ -1150,10 +1441,11 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
         return;
 
     int origCount = d->size;
-    bool sizeChanged = result.size != d->size;
 
-    d->size = result.size;
-    d->data = result.data;
+    if (!result.incremental) {
+        d->size = result.size;
+        d->data = result.data;
+    }
     d->keyRoleResultsCache = result.keyRoleResultsCache;
     if (d->src.isEmpty() && d->xml.isEmpty())
         d->status = Null;
@@ -1169,7 +1461,9 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
             break;
         }
     }
-    if (!hasKeys) {
+    if (result.incremental) {
+        appendRows(result);
+    } else if (!hasKeys) {
         if (origCount > 0) {
             beginRemoveRows(QModelIndex(), 0, origCount - 1);
             endRemoveRows();
@@ -1196,12 +1490,55 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
             }
         }
     }
-    if (sizeChanged)
+    if (d->size != origCount)
         emit countChanged();
 
     emit statusChanged(d->status);
 }
 
+void QQuickXmlListModel::queryRowsReady(const QQuickXmlQueryResult &result)
+{
+    Q_D(QQuickXmlListModel);
+    if (result.queryId != d->queryId)
+        return;
+
+    int origCount = d->size;
+    appendRows(result);
+    if (d->size != origCount)
+        emit countChanged();
+}
+
+void QQuickXmlListModel::appendRows(const QQuickXmlQueryResult &result)
+{
+    Q_D(QQuickXmlListModel);
+    const QQuickXmlListRange range = result.inserted.value(0);
+
+    // The first rows read by a query replace those of the previous query, whose key
+    // role values no longer describe the rows.
+    if (range.first == 0) {
+        d->keyRoleResultsCache.clear();
+        if (d->size > 0) {
+            beginRemoveRows(QModelIndex(), 0, d->size - 1);
+            d->data.clear();
+            d->size = 0;
+            endRemoveRows();
+        }
+        d->data.clear();
+    }
+
+    if (range.second > 0) {
+        beginInsertRows(QModelIndex(), d->size, d->size + range.second - 1);
+        for (int i = 0; i < result.data.count(); ++i) {
+            if (i == d->data.count())
+                d->data.append(result.data.at(i));
+            else
+                d->data[i] += result.data.at(i);
+        }
+        d->size += range.second;
+        endInsertRows();
+    }
+}
+
 QT_END_NAMESPACE
 
 #include <qqmlxmllistmodel.moc>
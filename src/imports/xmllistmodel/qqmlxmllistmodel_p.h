@@ -67,12 +67,15 @@ class QQuickXmlListModelRole;
 class QQuickXmlListModelPrivate;
 
 struct QQuickXmlQueryResult {
+    QQuickXmlQueryResult() : queryId(0), size(0), incremental(false) {}
+
     int queryId;
     int size;
     QList<QList<QVariant> > data;
     QList<QPair<int, int> > inserted;
     QList<QPair<int, int> > removed;
     QStringList keyRoleResultsCache;
+    bool incremental;   // data holds only the rows in inserted, the others were sent before
 };
 
 class QQuickXmlListModel : public QAbstractListModel, public QQmlParserStatus
@@ -148,9 +151,12 @@ private Q_SLOTS:
     void requestProgress(qint64,qint64);
     void dataCleared();
     void queryCompleted(const QQuickXmlQueryResult &);
+    void queryRowsReady(const QQuickXmlQueryResult &);
     void queryError(void* object, const QString& error);
 
 private:
+    void appendRows(const QQuickXmlQueryResult &result);
+
     Q_DECLARE_PRIVATE(QQuickXmlListModel)
     Q_DISABLE_COPY(QQuickXmlListModel)
 };
@@ -148,6 +148,9 @@ QV4::CompiledData::CompilationUnit *QQmlTypeCompiler::compile()
         QQmlJavaScriptBindingExpressionSimplificationPass pass(document->objects, &document->jsModule, &document->jsGenerator);
         pass.reduceTranslationBindings();
 
+        QQmlTypedBindingCodeGenerator typedBindings(document->objects, &document->jsModule, &document->jsGenerator);
+        typedBindings.generateTypedBindings();
+
         QV4::ExecutionEngine *v4 = engine->v4engine();
         QScopedPointer<QV4::EvalInstructionSelection> isel(v4->iselFactory->create(engine, v4->executableAllocator, &document->jsModule, &document->jsGenerator));
         isel->setUseFastLookups(false);
@@ -43,6 +43,10 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QCoreApplication>
+#include <QDir>
+#include <QVector>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -91,4 +95,177 @@ bool CompilationUnitMapper::verifyHeader(const CompiledData::Unit *header, QDate
     return true;
 }
 
+CompiledData::Unit *CompilationUnitMapper::openFromBundle(const QString &sourcePath, const QDateTime &sourceTimeStamp, QString *errorString)
+{
+    const CompiledData::Unit *unit = nullptr;
+    QSharedPointer<CompilationUnitBundle> containingBundle = CompilationUnitBundle::bundleForSource(sourcePath, &unit);
+    if (!containingBundle) {
+        *errorString = QStringLiteral("File is not part of any cache bundle");
+        return nullptr;
+    }
+
+    if (!verifyHeader(unit, sourceTimeStamp, errorString))
+        return nullptr;
+
+#if !defined(Q_OS_UNIX)
+    // The bundle is mapped without execute permissions, which cannot be added later on Windows.
+    if (unit->flags & CompiledData::Unit::ContainsMachineCode) {
+        *errorString = QStringLiteral("Machine code in cache bundles is not supported on this platform");
+        return nullptr;
+    }
+#endif
+
+    close();
+    bundle = containingBundle;
+    dataPtr = const_cast<CompiledData::Unit *>(unit);
+    return reinterpret_cast<CompiledData::Unit *>(dataPtr);
+}
+
+bool CompilationUnitMapper::hasValidHeader(const QString &sourcePath, const QString &cacheFilePath, const QDateTime &sourceTimeStamp)
+{
+    QString error;
+    const CompiledData::Unit *unit = nullptr;
+    if (CompilationUnitBundle::bundleForSource(sourcePath, &unit) && verifyHeader(unit, sourceTimeStamp, &error))
+        return true;
+
+    QFile file(cacheFilePath);
+    CompiledData::Unit header;
+    return file.open(QIODevice::ReadOnly)
+            && file.read(reinterpret_cast<char *>(&header), sizeof(header)) == qint64(sizeof(header))
+            && verifyHeader(&header, sourceTimeStamp, &error);
+}
+
+namespace {
+struct BundleRegistry
+{
+    BundleRegistry();
+
+    // Only written during construction, so lookups from several threads need no locking.
+    QVector<QSharedPointer<CompilationUnitBundle>> bundles;
+};
+
+BundleRegistry::BundleRegistry()
+{
+    const QString paths = QString::fromLocal8Bit(qgetenv("QML_CACHE_BUNDLE"));
+    if (paths.isEmpty())
+        return;
+    for (const QString &path : paths.split(QDir::listSeparator(), QString::SkipEmptyParts)) {
+        QString error;
+        QSharedPointer<CompilationUnitBundle> bundle = CompilationUnitBundle::open(path, &error);
+        if (bundle)
+            bundles.append(bundle);
+        else
+            qWarning("QML_CACHE_BUNDLE: Error opening %s: %s", qPrintable(path), qPrintable(error));
+    }
+}
+}
+
+Q_GLOBAL_STATIC(BundleRegistry, bundleRegistry)
+
+CompilationUnitBundle::CompilationUnitBundle(const QString &bundleFilePath)
+    : file(bundleFilePath)
+    , dataPtr(nullptr)
+    , length(0)
+{
+}
+
+CompilationUnitBundle::~CompilationUnitBundle()
+{
+    if (dataPtr)
+        file.unmap(const_cast<uchar *>(dataPtr));
+}
+
+QSharedPointer<CompilationUnitBundle> CompilationUnitBundle::open(const QString &bundleFilePath, QString *errorString)
+{
+    QSharedPointer<CompilationUnitBundle> bundle(new CompilationUnitBundle(bundleFilePath));
+    if (!bundle->file.open(QIODevice::ReadOnly)) {
+        *errorString = bundle->file.errorString();
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    bundle->length = bundle->file.size();
+    if (bundle->length < qint64(sizeof(CompiledData::BundleHeader))) {
+        *errorString = QStringLiteral("File too small for the header fields");
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    // One mapping for all units in the bundle. The pages are shared read-only between all
+    // processes that use the same bundle.
+    bundle->dataPtr = bundle->file.map(0, bundle->length);
+    if (!bundle->dataPtr) {
+        *errorString = bundle->file.errorString();
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    const CompiledData::BundleHeader *header = reinterpret_cast<const CompiledData::BundleHeader *>(bundle->dataPtr);
+    if (strncmp(header->magic, CompiledData::bundle_magic_str, sizeof(header->magic))) {
+        *errorString = QStringLiteral("Magic bytes in the header do not match");
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    if (header->version != quint32(QV4_DATA_STRUCTURE_VERSION)) {
+        *errorString = QString::fromUtf8("V4 data structure version mismatch. Found %1 expected %2").arg(header->version, 0, 16).arg(QV4_DATA_STRUCTURE_VERSION, 0, 16);
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    if (header->qtVersion != quint32(QT_VERSION)) {
+        *errorString = QString::fromUtf8("Qt version mismatch. Found %1 expected %2").arg(header->qtVersion, 0, 16).arg(QT_VERSION, 0, 16);
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    const qint64 entryTableEnd = qint64(header->offsetToEntryTable) + qint64(header->entryCount) * qint64(sizeof(CompiledData::BundleEntry));
+    if (entryTableEnd > bundle->length) {
+        *errorString = QStringLiteral("Entry table exceeds the file size");
+        return QSharedPointer<CompilationUnitBundle>();
+    }
+
+    for (quint32 i = 0; i < header->entryCount; ++i) {
+        const CompiledData::BundleEntry *entry = header->entryAt(i);
+        if (qint64(entry->keyOffset) + entry->keyLength > bundle->length
+            || qint64(entry->unitOffset) + entry->unitSize > bundle->length
+            || entry->unitSize < sizeof(CompiledData::Unit)) {
+            *errorString = QStringLiteral("Entry %1 exceeds the file size").arg(i);
+            return QSharedPointer<CompilationUnitBundle>();
+        }
+    }
+
+    return bundle;
+}
+
+const CompiledData::Unit *CompilationUnitBundle::findUnit(const QString &sourcePath) const
+{
+    const CompiledData::BundleHeader *header = reinterpret_cast<const CompiledData::BundleHeader *>(dataPtr);
+    const QByteArray key = sourcePath.toUtf8();
+    const quint32 hash = CompiledData::bundleKeyHash(key);
+
+    const CompiledData::BundleEntry *begin = header->entryAt(0);
+    const CompiledData::BundleEntry *end = begin + header->entryCount;
+    auto it = std::lower_bound(begin, end, hash, [](const CompiledData::BundleEntry &entry, quint32 hash) {
+        return entry.keyHash < hash;
+    });
+    for (; it != end && it->keyHash == hash; ++it) {
+        if (it->keyLength != quint32(key.size()))
+            continue;
+        if (memcmp(dataPtr + it->keyOffset, key.constData(), key.size()) != 0)
+            continue;
+        return reinterpret_cast<const CompiledData::Unit *>(dataPtr + it->unitOffset);
+    }
+    return nullptr;
+}
+
+QSharedPointer<CompilationUnitBundle> CompilationUnitBundle::bundleForSource(const QString &sourcePath, const CompiledData::Unit **unit)
+{
+    BundleRegistry *registry = bundleRegistry();
+    if (!registry)
+        return QSharedPointer<CompilationUnitBundle>();
+
+    for (const QSharedPointer<CompilationUnitBundle> &bundle : qAsConst(registry->bundles)) {
+        if (const CompiledData::Unit *found = bundle->findUnit(sourcePath)) {
+            *unit = found;
+            return bundle;
+        }
+    }
+    return QSharedPointer<CompilationUnitBundle>();
+}
+
 QT_END_NAMESPACE
@@ -53,6 +53,7 @@
 
 #include <private/qv4global_p.h>
 #include <QFile>
+#include <QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,8 +61,33 @@ namespace QV4 {
 
 namespace CompiledData {
 struct Unit;
+struct BundleHeader;
 }
 
+// A read-only mapping of a cache bundle produced by qmlcachegen --bundle. Bundles are
+// listed in the QML_CACHE_BUNDLE environment variable, opened once per process and
+// shared by all engines and type loader threads.
+class Q_QML_PRIVATE_EXPORT CompilationUnitBundle
+{
+public:
+    ~CompilationUnitBundle();
+
+    static QSharedPointer<CompilationUnitBundle> open(const QString &bundleFilePath, QString *errorString);
+
+    const CompiledData::Unit *findUnit(const QString &sourcePath) const;
+    QString filePath() const { return file.fileName(); }
+
+    // Returns the bundle that contains the unit for the given source path, if any.
+    static QSharedPointer<CompilationUnitBundle> bundleForSource(const QString &sourcePath, const CompiledData::Unit **unit);
+
+private:
+    CompilationUnitBundle(const QString &bundleFilePath);
+
+    QFile file;
+    const uchar *dataPtr;
+    qint64 length;
+};
+
 class CompilationUnitMapper
 {
 public:
@@ -69,11 +95,17 @@ public:
     ~CompilationUnitMapper();
 
     CompiledData::Unit *open(const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString);
+    CompiledData::Unit *openFromBundle(const QString &sourcePath, const QDateTime &sourceTimeStamp, QString *errorString);
     void close();
 
+    static bool hasValidHeader(const QString &sourcePath, const QString &cacheFilePath, const QDateTime &sourceTimeStamp);
+
 private:
     static bool verifyHeader(const QV4::CompiledData::Unit *header, QDateTime sourceTimeStamp, QString *errorString);
 
+    // Set when dataPtr points into a shared bundle rather than to a mapping we own.
+    QSharedPointer<CompilationUnitBundle> bundle;
+
 #if defined(Q_OS_UNIX)
     size_t length;
 #endif
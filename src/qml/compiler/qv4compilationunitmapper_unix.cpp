@@ -92,7 +92,9 @@ CompiledData::Unit *CompilationUnitMapper::open(const QString &cacheFileName, co
 
 void CompilationUnitMapper::close()
 {
-    if (dataPtr != nullptr)
+    if (bundle)
+        bundle.reset();
+    else if (dataPtr != nullptr)
         munmap(dataPtr, length);
     dataPtr = nullptr;
 }
@@ -51,6 +51,7 @@
 #include <private/qqmltypeloader_p.h>
 #include <private/qqmlengine_p.h>
 #include "qv4compilationunitmapper_p.h"
+#include <private/qqmlstartupmanifest_p.h>
 #include <QQmlPropertyMap>
 #include <QDateTime>
 #include <QFile>
@@ -361,10 +362,27 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
     const QString sourcePath = QQmlFile::urlToLocalFileOrQrc(url);
     QScopedPointer<CompilationUnitMapper> cacheFile(new CompilationUnitMapper());
 
-    CompiledData::Unit *mappedUnit = cacheFile->open(cacheFilePath(url), sourceTimeStamp, errorString);
+    // Units from a cache bundle avoid opening and mapping one file per source file. A unit
+    // that the bundle has for a different architecture or code generator falls back to the
+    // per-file cache.
+    QString bundleError;
+    if (const Unit *bundleUnit = cacheFile->openFromBundle(sourcePath, sourceTimeStamp, &bundleError)) {
+        if (loadMappedUnit(cacheFile, bundleUnit, sourcePath, iselFactory, &bundleError))
+            return true;
+        cacheFile.reset(new CompilationUnitMapper());
+    }
+
+    const QString cachePath = cacheFilePath(url);
+    const Unit *mappedUnit = cacheFile->open(cachePath, sourceTimeStamp, errorString);
     if (!mappedUnit)
         return false;
+    QQmlStartupManifest::record(QQmlStartupManifest::CompilationCache, cachePath);
+    return loadMappedUnit(cacheFile, mappedUnit, sourcePath, iselFactory, errorString);
+}
 
+bool CompilationUnit::loadMappedUnit(QScopedPointer<CompilationUnitMapper> &cacheFile, const Unit *mappedUnit, const QString &sourcePath,
+                                     EvalISelFactory *iselFactory, QString *errorString)
+{
     const Unit * const oldDataPtr = (data && !(data->flags & QV4::CompiledData::Unit::StaticData)) ? data : nullptr;
     QScopedValueRollback<const Unit *> dataPtrChange(data, mappedUnit);
 
@@ -400,6 +418,18 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
     return true;
 }
 
+/*!
+Returns whether \a url has a unit in a cache bundle or a cache file whose header matches
+the source file, without mapping it. loadFromDisk() can still fail for such a unit, for
+example if it was generated for a different architecture.
+*/
+bool CompilationUnit::hasCacheFile(const QUrl &url, const QDateTime &sourceTimeStamp)
+{
+    if (!QQmlFile::isLocalFile(url))
+        return false;
+    return CompilationUnitMapper::hasValidHeader(QQmlFile::urlToLocalFileOrQrc(url), cacheFilePath(url), sourceTimeStamp);
+}
+
 bool CompilationUnit::memoryMapCode(QString *errorString)
 {
     *errorString = QStringLiteral("Missing code mapping backend");
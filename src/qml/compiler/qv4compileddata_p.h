@@ -72,7 +72,7 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x13
+#define QV4_DATA_STRUCTURE_VERSION 0x14
 
 class QIODevice;
 class QQmlPropertyCache;
@@ -205,6 +205,38 @@ struct String
 };
 static_assert(sizeof(String) == 4, "String structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
 
+// Instruction of the typed form of a binding expression, which computes the value of the binding
+// from numbers and numeric properties without calling the JavaScript function. The instructions
+// operate on a stack of numbers and objects, see QQmlTypedBinding.
+struct TypedBindingInstruction
+{
+    enum Type : unsigned int {
+        LoadConstant,           // index into the constant table
+        LoadScopeProperty,      // core index of a property of the QML scope object
+        LoadContextProperty,    // core index of a property of the QML context object
+        LoadIdObject,           // index of an id object of the QML context
+        LoadName,               // string index of a name looked up in the QML context
+        LoadProperty,           // string index of a property of the object on top of the stack
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negate
+    };
+
+    enum { MaximumStackDepth = 8 };
+
+    union {
+        QJsonPrivate::qle_bitfield<0, 4> type;
+        QJsonPrivate::qle_bitfield<4, 28> index;
+    };
+
+    TypedBindingInstruction() { type.val = 0; index.val = 0; }
+
+    static quint32 encode(Type type, quint32 index) { return type | (index << 4); }
+};
+static_assert(sizeof(TypedBindingInstruction) == 4, "TypedBindingInstruction structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+
 // Function is aligned on an 8-byte boundary to make sure there are no bus errors or penalties
 // for unaligned access. The ordering of the fields is also from largest to smallest.
 struct Function
@@ -237,6 +269,8 @@ struct Function
     LEUInt32 dependingContextPropertiesOffset; // Array of int pairs (property index and notify index)
     LEUInt32 nDependingScopeProperties;
     LEUInt32 dependingScopePropertiesOffset; // Array of int pairs (property index and notify index)
+    LEUInt32 nTypedBindingInstructions;
+    LEUInt32 typedBindingOffset; // Array of TypedBindingInstruction
     // Qml Extensions End
 
 //    quint32 formalsIndex[nFormals]
@@ -254,6 +288,7 @@ struct Function
     const LEUInt32 *qmlIdObjectDependencyTable() const { return reinterpret_cast<const LEUInt32 *>(reinterpret_cast<const char *>(this) + dependingIdObjectsOffset); }
     const LEUInt32 *qmlContextPropertiesDependencyTable() const { return reinterpret_cast<const LEUInt32 *>(reinterpret_cast<const char *>(this) + dependingContextPropertiesOffset); }
     const LEUInt32 *qmlScopePropertiesDependencyTable() const { return reinterpret_cast<const LEUInt32 *>(reinterpret_cast<const char *>(this) + dependingScopePropertiesOffset); }
+    const TypedBindingInstruction *typedBindingTable() const { return reinterpret_cast<const TypedBindingInstruction *>(reinterpret_cast<const char *>(this) + typedBindingOffset); }
 
     // --- QQmlPropertyCacheCreator interface
     const LEUInt32 *formalsBegin() const { return formalsTable(); }
@@ -262,11 +297,13 @@ struct Function
 
     inline bool hasQmlDependencies() const { return nDependingIdObjects > 0 || nDependingContextProperties > 0 || nDependingScopeProperties > 0; }
 
-    static int calculateSize(int nFormals, int nLocals, int nInnerfunctions, int nIdObjectDependencies, int nPropertyDependencies) {
-        return (sizeof(Function) + (nFormals + nLocals + nInnerfunctions + nIdObjectDependencies + 2 * nPropertyDependencies) * sizeof(quint32) + 7) & ~0x7;
+    inline bool hasTypedBinding() const { return nTypedBindingInstructions > 0; }
+
+    static int calculateSize(int nFormals, int nLocals, int nInnerfunctions, int nIdObjectDependencies, int nPropertyDependencies, int nTypedBindingInstructions) {
+        return (sizeof(Function) + (nFormals + nLocals + nInnerfunctions + nIdObjectDependencies + 2 * nPropertyDependencies + nTypedBindingInstructions) * sizeof(quint32) + 7) & ~0x7;
     }
 };
-static_assert(sizeof(Function) == 72, "Function structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+static_assert(sizeof(Function) == 80, "Function structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
 
 // Qml data structures
 
@@ -734,6 +771,49 @@ struct Unit
 
 static_assert(sizeof(Unit) == 144, "Unit structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
 
+// A cache bundle packs the compilation units of many QML/JS files into one file, so
+// that they can be located through a single index and mapped with a single mmap.
+// The unit data of each entry is exactly what would otherwise be written to the
+// .qmlc/.jsc file, starting on a page boundary.
+static const char bundle_magic_str[] = "qv4cbndl";
+static const int bundleUnitAlignment = 4096;
+
+struct BundleEntry
+{
+    LEUInt32 keyHash; // bundleKeyHash() of the source file path
+    LEUInt32 keyOffset; // UTF-8 encoded source file path, as seen by QQmlFile::urlToLocalFileOrQrc
+    LEUInt32 keyLength;
+    LEUInt32 unitOffset;
+    LEUInt32 unitSize; // Size of the unit including any code appended to it
+    LEUInt32 reserved;
+};
+static_assert(sizeof(BundleEntry) == 24, "BundleEntry structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+
+struct BundleHeader
+{
+    char magic[8];
+    LEUInt32 version; // QV4_DATA_STRUCTURE_VERSION
+    LEUInt32 qtVersion;
+    LEUInt32 entryCount;
+    LEUInt32 offsetToEntryTable; // entries are sorted by keyHash
+
+    const BundleEntry *entryAt(int idx) const {
+        return reinterpret_cast<const BundleEntry *>(reinterpret_cast<const char *>(this) + offsetToEntryTable + idx * sizeof(BundleEntry));
+    }
+};
+static_assert(sizeof(BundleHeader) == 24, "BundleHeader structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+
+// FNV-1a, so that the hash does not depend on QHash seeding or on the Qt version.
+inline quint32 bundleKeyHash(const QByteArray &utf8Key)
+{
+    quint32 h = 2166136261u;
+    for (char c : utf8Key) {
+        h ^= quint8(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
 struct TypeReference
 {
     TypeReference(const Location &loc)
@@ -867,6 +947,20 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     QHash<int, IdentifierHash<int>> namedObjectsPerComponentCache;
     IdentifierHash<int> namedObjectsPerComponent(int componentObjectIndex);
 
+    // index is object index. Where QQmlVMEMetaObject keeps the values of the properties
+    // declared by the object, either in its typed storage or in its MemberData.
+    // This is initialized on-demand by QQmlVMEMetaObject
+    struct PropertyStorageLayout
+    {
+        PropertyStorageLayout() : typedStorageSize(0), memberDataPropertyCount(0), initialized(false) {}
+        // byte offset into the typed storage or index into the MemberData, per property
+        QVector<int> storageIndex;
+        int typedStorageSize;
+        int memberDataPropertyCount;
+        bool initialized;
+    };
+    QVector<PropertyStorageLayout> propertyStorageLayoutPerObject;
+
     // pointers either to data->constants() or little-endian memory copy.
     const Value* constants;
 
@@ -917,10 +1011,15 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     void destroy() Q_DECL_OVERRIDE;
 
     bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, EvalISelFactory *iselFactory, QString *errorString);
+    static bool hasCacheFile(const QUrl &url, const QDateTime &sourceTimeStamp);
 
 protected:
     virtual void linkBackendToEngine(QV4::ExecutionEngine *engine) = 0;
     virtual bool memoryMapCode(QString *errorString);
+
+private:
+    bool loadMappedUnit(QScopedPointer<CompilationUnitMapper> &cacheFile, const Unit *mappedUnit, const QString &sourcePath,
+                        EvalISelFactory *iselFactory, QString *errorString);
 #endif // V4_BOOTSTRAP
 
 public:
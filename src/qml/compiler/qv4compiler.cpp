@@ -328,6 +328,10 @@ void QV4::Compiler::JSUnitGenerator::writeFunction(char *f, QV4::IR::Function *i
         currentOffset += function->nDependingScopeProperties * sizeof(quint32) * 2;
     }
 
+    function->nTypedBindingInstructions = irFunction->typedBindingCode.size();
+    function->typedBindingOffset = currentOffset;
+    currentOffset += function->nTypedBindingInstructions * sizeof(quint32);
+
     function->location.line = irFunction->line;
     function->location.column = irFunction->column;
 
@@ -362,6 +366,11 @@ void QV4::Compiler::JSUnitGenerator::writeFunction(char *f, QV4::IR::Function *i
         *writtenDeps++ = property.key(); // property index
         *writtenDeps++ = property.value(); // notify index
     }
+
+    // write typed binding
+    CompiledData::LEUInt32 *typedBindingCode = (CompiledData::LEUInt32 *)(f + function->typedBindingOffset);
+    for (quint32 instruction : irFunction->typedBindingCode)
+        *typedBindingCode++ = instruction;
 }
 
 QV4::CompiledData::Unit QV4::Compiler::JSUnitGenerator::generateHeader(QV4::Compiler::JSUnitGenerator::GeneratorOption option, QJsonPrivate::q_littleendian<quint32> *functionOffsets, uint *jsClassDataOffset)
@@ -414,7 +423,7 @@ QV4::CompiledData::Unit QV4::Compiler::JSUnitGenerator::generateHeader(QV4::Comp
 
         const int qmlIdDepsCount = f->idObjectDependencies.count();
         const int qmlPropertyDepsCount = f->scopeObjectPropertyDependencies.count() + f->contextObjectPropertyDependencies.count();
-        nextOffset += QV4::CompiledData::Function::calculateSize(f->formals.size(), f->locals.size(), f->nestedFunctions.size(), qmlIdDepsCount, qmlPropertyDepsCount);
+        nextOffset += QV4::CompiledData::Function::calculateSize(f->formals.size(), f->locals.size(), f->nestedFunctions.size(), qmlIdDepsCount, qmlPropertyDepsCount, f->typedBindingCode.size());
     }
 
     if (option == GenerateWithStringTable) {
@@ -1320,6 +1320,7 @@ struct Function {
     SmallSet<int> idObjectDependencies;
     PropertyDependencyMap contextObjectPropertyDependencies;
     PropertyDependencyMap scopeObjectPropertyDependencies;
+    QVector<quint32> typedBindingCode; // Encoded CompiledData::TypedBindingInstruction
 
     template <typename T> T *New() { return new (pool->allocate(sizeof(T))) T(); }
     template <typename T> T *NewStmt() {
@@ -39,6 +39,8 @@
 
 #include "qv4jssimplifier_p.h"
 
+#include <private/qv4value_p.h>
+
 QT_BEGIN_NAMESPACE
 
 QQmlJavaScriptBindingExpressionSimplificationPass::QQmlJavaScriptBindingExpressionSimplificationPass(const QVector<QmlIR::Object*> &qmlObjects, QV4::IR::Module *jsModule, QV4::Compiler::JSUnitGenerator *unitGenerator)
@@ -316,6 +318,226 @@ bool QQmlJavaScriptBindingExpressionSimplificationPass::detectTranslationCallAnd
     return false;
 }
 
+QQmlTypedBindingCodeGenerator::QQmlTypedBindingCodeGenerator(const QVector<QmlIR::Object*> &qmlObjects, QV4::IR::Module *jsModule, QV4::Compiler::JSUnitGenerator *unitGenerator)
+    : qmlObjects(qmlObjects)
+    , jsModule(jsModule)
+    , unitGenerator(unitGenerator)
+    , _returned(false)
+{
+}
+
+void QQmlTypedBindingCodeGenerator::generateTypedBindings()
+{
+    for (const QmlIR::Object *obj : qmlObjects) {
+        for (QmlIR::Binding *binding = obj->firstBinding(); binding; binding = binding->next) {
+            if (binding->type != QV4::CompiledData::Binding::Type_Script
+                || binding->flags & QV4::CompiledData::Binding::IsSignalHandlerExpression)
+                continue;
+
+            const int irFunctionIndex = obj->runtimeFunctionIndices.at(binding->value.compiledScriptIndex);
+            QV4::IR::Function *irFunction = jsModule->functions.at(irFunctionIndex);
+            if (irFunction && generateTypedBinding(irFunction))
+                irFunction->typedBindingCode = _code;
+        }
+    }
+}
+
+bool QQmlTypedBindingCodeGenerator::generateTypedBinding(QV4::IR::Function *function)
+{
+    _temps.clear();
+    _qmlContextTemps.clear();
+    _code.clear();
+    _returned = false;
+
+    // A binding expression without control flow consists of the entry block and the
+    // exit block returning the value.
+    if (!function->isQmlBinding || function->hasDirectEval || function->basicBlockCount() > 2)
+        return false;
+
+    for (QV4::IR::BasicBlock *bb : function->basicBlocks()) {
+        for (QV4::IR::Stmt *s : bb->statements()) {
+            // Nothing may follow the return of the value
+            if (_returned)
+                return false;
+
+            switch (s->stmtKind) {
+            case QV4::IR::Stmt::MoveStmt:
+                if (!visitMove(s->asMove()))
+                    return false;
+                break;
+            case QV4::IR::Stmt::RetStmt:
+                if (!visitRet(s->asRet()))
+                    return false;
+                break;
+            case QV4::IR::Stmt::JumpStmt:
+                break;
+            default:
+                return false;
+            }
+        }
+    }
+
+    return _returned && !_code.isEmpty()
+            && _code.size() <= MaximumInstructionCount
+            && stackDepth(_code) <= QV4::CompiledData::TypedBindingInstruction::MaximumStackDepth;
+}
+
+bool QQmlTypedBindingCodeGenerator::visitMove(QV4::IR::Move *move)
+{
+    QV4::IR::Temp *target = move->target->asTemp();
+    if (!target || target->kind != QV4::IR::Temp::VirtualRegister)
+        return false;
+
+    _temps.remove(target->index);
+    _qmlContextTemps.remove(target->index);
+
+    QVector<quint32> code;
+    if (QV4::IR::Name *name = move->source->asName()) {
+        if (name->builtin == QV4::IR::Name::builtin_qml_context) {
+            _qmlContextTemps.insert(target->index);
+            return true;
+        }
+        if (name->builtin == QV4::IR::Name::builtin_qml_imported_scripts_object)
+            return true;
+        // Type names, enums and singletons are not supported by the typed form
+        if (name->builtin != QV4::IR::Name::builtin_invalid || name->global || name->qmlSingleton
+            || name->id->isEmpty() || name->id->at(0).isUpper())
+            return false;
+        code.append(QV4::CompiledData::TypedBindingInstruction::encode(
+                        QV4::CompiledData::TypedBindingInstruction::LoadName,
+                        unitGenerator->registerString(*name->id)));
+    } else if (QV4::IR::Const *c = move->source->asConst()) {
+        // The return value is initialized with undefined, which does not have a typed form
+        if (!generateOperand(c, &code))
+            return true;
+    } else if (QV4::IR::Temp *temp = move->source->asTemp()) {
+        if (!generateOperand(temp, &code))
+            return false;
+    } else if (QV4::IR::Member *member = move->source->asMember()) {
+        if (!generateMember(member, &code))
+            return false;
+    } else if (QV4::IR::Binop *binop = move->source->asBinop()) {
+        QV4::CompiledData::TypedBindingInstruction::Type type;
+        switch (binop->op) {
+        case QV4::IR::OpAdd: type = QV4::CompiledData::TypedBindingInstruction::Add; break;
+        case QV4::IR::OpSub: type = QV4::CompiledData::TypedBindingInstruction::Subtract; break;
+        case QV4::IR::OpMul: type = QV4::CompiledData::TypedBindingInstruction::Multiply; break;
+        case QV4::IR::OpDiv: type = QV4::CompiledData::TypedBindingInstruction::Divide; break;
+        default: return false;
+        }
+        if (!generateOperand(binop->left, &code) || !generateOperand(binop->right, &code))
+            return false;
+        code.append(QV4::CompiledData::TypedBindingInstruction::encode(type, 0));
+    } else if (QV4::IR::Unop *unop = move->source->asUnop()) {
+        if (unop->op != QV4::IR::OpUMinus || !generateOperand(unop->expr, &code))
+            return false;
+        code.append(QV4::CompiledData::TypedBindingInstruction::encode(
+                        QV4::CompiledData::TypedBindingInstruction::Negate, 0));
+    } else {
+        return false;
+    }
+
+    if (code.size() > MaximumInstructionCount)
+        return false;
+    _temps.insert(target->index, code);
+    return true;
+}
+
+bool QQmlTypedBindingCodeGenerator::visitRet(QV4::IR::Ret *ret)
+{
+    QV4::IR::Temp *temp = ret->expr->asTemp();
+    if (!temp || !generateOperand(temp, &_code))
+        return false;
+    _returned = true;
+    return true;
+}
+
+bool QQmlTypedBindingCodeGenerator::generateOperand(QV4::IR::Expr *operand, QVector<quint32> *code)
+{
+    if (QV4::IR::Const *c = operand->asConst()) {
+        if (!(c->type & QV4::IR::NumberType) || (c->type & ~QV4::IR::NumberType))
+            return false;
+        const int index = unitGenerator->registerConstant(QV4::Primitive::fromDouble(c->value).asReturnedValue());
+        code->append(QV4::CompiledData::TypedBindingInstruction::encode(
+                         QV4::CompiledData::TypedBindingInstruction::LoadConstant, index));
+        return true;
+    }
+
+    QV4::IR::Temp *temp = operand->asTemp();
+    if (!temp || temp->kind != QV4::IR::Temp::VirtualRegister)
+        return false;
+    QHash<int, QVector<quint32> >::ConstIterator it = _temps.constFind(temp->index);
+    if (it == _temps.constEnd())
+        return false;
+    *code += *it;
+    return true;
+}
+
+bool QQmlTypedBindingCodeGenerator::generateMember(QV4::IR::Member *member, QVector<quint32> *code)
+{
+    QV4::IR::Temp *base = member->base->asTemp();
+    if (!base || base->kind != QV4::IR::Temp::VirtualRegister)
+        return false;
+
+    if (_qmlContextTemps.contains(base->index)) {
+        switch (member->kind) {
+        case QV4::IR::Member::MemberOfIdObjectsArray:
+            code->append(QV4::CompiledData::TypedBindingInstruction::encode(
+                             QV4::CompiledData::TypedBindingInstruction::LoadIdObject, member->idIndex));
+            return true;
+#ifndef V4_BOOTSTRAP
+        case QV4::IR::Member::MemberOfQmlScopeObject:
+        case QV4::IR::Member::MemberOfQmlContextObject:
+            if (!member->property || member->attachedPropertiesId != 0)
+                return false;
+            code->append(QV4::CompiledData::TypedBindingInstruction::encode(
+                             member->kind == QV4::IR::Member::MemberOfQmlScopeObject
+                             ? QV4::CompiledData::TypedBindingInstruction::LoadScopeProperty
+                             : QV4::CompiledData::TypedBindingInstruction::LoadContextProperty,
+                             member->property->coreIndex()));
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    if (member->kind != QV4::IR::Member::UnspecifiedMember || member->attachedPropertiesId != 0)
+        return false;
+    if (!generateOperand(base, code))
+        return false;
+    code->append(QV4::CompiledData::TypedBindingInstruction::encode(
+                     QV4::CompiledData::TypedBindingInstruction::LoadProperty,
+                     unitGenerator->registerString(*member->name)));
+    return true;
+}
+
+int QQmlTypedBindingCodeGenerator::stackDepth(const QVector<quint32> &code)
+{
+    int depth = 0;
+    int maximumDepth = 0;
+    for (quint32 instruction : code) {
+        switch (instruction & 0xf) {
+        case QV4::CompiledData::TypedBindingInstruction::LoadConstant:
+        case QV4::CompiledData::TypedBindingInstruction::LoadScopeProperty:
+        case QV4::CompiledData::TypedBindingInstruction::LoadContextProperty:
+        case QV4::CompiledData::TypedBindingInstruction::LoadIdObject:
+        case QV4::CompiledData::TypedBindingInstruction::LoadName:
+            maximumDepth = qMax(maximumDepth, ++depth);
+            break;
+        case QV4::CompiledData::TypedBindingInstruction::Add:
+        case QV4::CompiledData::TypedBindingInstruction::Subtract:
+        case QV4::CompiledData::TypedBindingInstruction::Multiply:
+        case QV4::CompiledData::TypedBindingInstruction::Divide:
+            --depth;
+            break;
+        default: // LoadProperty and Negate replace the value on top of the stack
+            break;
+        }
+    }
+    return maximumDepth;
+}
+
 QQmlIRFunctionCleanser::QQmlIRFunctionCleanser(QV4::IR::Module *module, const QVector<QmlIR::Object *> &qmlObjects, const QVector<int> &functionsToRemove)
     : module(module)
     , qmlObjects(qmlObjects)
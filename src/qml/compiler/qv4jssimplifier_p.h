@@ -125,6 +125,40 @@ private:
     QVector<int> irFunctionsToRemove;
 };
 
+// Generates the typed form of binding expressions that only read numbers from properties
+// and do arithmetic on them, such as "parent.width - 10". The JavaScript function of the
+// binding is kept, it is called whenever the typed form cannot be evaluated.
+class QQmlTypedBindingCodeGenerator
+{
+public:
+    QQmlTypedBindingCodeGenerator(const QVector<QmlIR::Object*> &qmlObjects, QV4::IR::Module *jsModule, QV4::Compiler::JSUnitGenerator *unitGenerator);
+
+    void generateTypedBindings();
+
+    enum { MaximumInstructionCount = 32 };
+
+private:
+    bool generateTypedBinding(QV4::IR::Function *function);
+
+    bool visitMove(QV4::IR::Move *move);
+    bool visitRet(QV4::IR::Ret *ret);
+
+    bool generateOperand(QV4::IR::Expr *operand, QVector<quint32> *code);
+    bool generateMember(QV4::IR::Member *member, QVector<quint32> *code);
+
+    static int stackDepth(const QVector<quint32> &code);
+
+    const QVector<QmlIR::Object*> &qmlObjects;
+    QV4::IR::Module *jsModule;
+    QV4::Compiler::JSUnitGenerator *unitGenerator;
+
+    // Instructions computing the value of each temp
+    QHash<int, QVector<quint32> > _temps;
+    QSet<int> _qmlContextTemps;
+    QVector<quint32> _code;
+    bool _returned;
+};
+
 class QQmlIRFunctionCleanser
 {
 public:
@@ -89,11 +89,25 @@ bool CompilationUnit::memoryMapCode(QString *errorString)
 
     const char *basePtr = reinterpret_cast<const char *>(data);
 
+    // The code of all functions is stored contiguously after the unit, so change the
+    // protection of the whole range with one call instead of one per function.
+    quint64 codeStart = 0;
+    quint64 codeEnd = 0;
+    for (uint i = 0; i < data->functionTableSize; ++i) {
+        const CompiledData::Function *compiledFunction = data->functionAt(i);
+        if (!compiledFunction->codeSize)
+            continue;
+        if (!codeEnd || compiledFunction->codeOffset < codeStart)
+            codeStart = compiledFunction->codeOffset;
+        codeEnd = qMax<quint64>(codeEnd, compiledFunction->codeOffset + compiledFunction->codeSize);
+    }
+    if (codeEnd > codeStart)
+        JSC::ExecutableAllocator::makeExecutable(const_cast<char *>(basePtr + codeStart), codeEnd - codeStart);
+
     for (uint i = 0; i < data->functionTableSize; ++i) {
         const CompiledData::Function *compiledFunction = data->functionAt(i);
         void *codePtr = const_cast<void *>(reinterpret_cast<const void *>(basePtr + compiledFunction->codeOffset));
         JSC::MacroAssemblerCodeRef codeRef = JSC::MacroAssemblerCodeRef::createSelfManagedCodeRef(JSC::MacroAssemblerCodePtr(codePtr));
-        JSC::ExecutableAllocator::makeExecutable(codePtr, compiledFunction->codeSize);
         codeRefs[i] = codeRef;
 
         static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
@@ -156,10 +170,10 @@ bool CompilationUnit::saveCodeToDisk(QIODevice *device, const CompiledData::Unit
 }
 
 template <typename TargetConfiguration>
-Assembler<TargetConfiguration>::Assembler(QV4::Compiler::JSUnitGenerator *jsGenerator, IR::Function* function, QV4::ExecutableAllocator *executableAllocator)
+Assembler<TargetConfiguration>::Assembler(QV4::Compiler::JSUnitGenerator *jsGenerator, IR::Function* function, QV4::ExecutableAllocator::WriteBatch *writeBatch)
     : _function(function)
     , _nextBlock(0)
-    , _executableAllocator(executableAllocator)
+    , _writeBatch(writeBatch)
     , _jsGenerator(jsGenerator)
 {
     _addrs.resize(_function->basicBlockCount());
@@ -609,7 +623,10 @@ JSC::MacroAssemblerCodeRef Assembler<TargetConfiguration>::link(int *codeSize)
         }
     }
 
-    JSC::JSGlobalData dummy(_executableAllocator);
+    // The global code of a script runs once, keep it away from the functions that are called repeatedly.
+    const QV4::ExecutableAllocator::Pool pool = (_function->module && _function == _function->module->rootFunction)
+            ? QV4::ExecutableAllocator::ColdCode : QV4::ExecutableAllocator::HotCode;
+    JSC::JSGlobalData dummy(_writeBatch->allocator, pool, _writeBatch);
     JSC::LinkBuffer<typename TargetConfiguration::MacroAssembler> linkBuffer(dummy, this, 0);
 
     for (const DataLabelPatch &p : qAsConst(_dataLabelPatches))
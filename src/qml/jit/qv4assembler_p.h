@@ -679,7 +679,7 @@ class Assembler : public TargetConfiguration::MacroAssembler, public TargetConfi
     Q_DISABLE_COPY(Assembler)
 
 public:
-    Assembler(QV4::Compiler::JSUnitGenerator *jsGenerator, IR::Function* function, QV4::ExecutableAllocator *executableAllocator);
+    Assembler(QV4::Compiler::JSUnitGenerator *jsGenerator, IR::Function* function, QV4::ExecutableAllocator::WriteBatch *writeBatch);
 
     using MacroAssembler = typename TargetConfiguration::MacroAssembler;
     using RegisterID = typename MacroAssembler::RegisterID;
@@ -1657,7 +1657,7 @@ private:
     std::vector<std::vector<DataLabelPtr>> _labelPatches;
     IR::BasicBlock *_nextBlock;
 
-    QV4::ExecutableAllocator *_executableAllocator;
+    QV4::ExecutableAllocator::WriteBatch *_writeBatch;
     QV4::Compiler::JSUnitGenerator *_jsGenerator;
 };
 
@@ -71,6 +71,7 @@ InstructionSelection<JITAssembler>::InstructionSelection(QQmlEnginePrivate *qmlE
     , _as(0)
     , compilationUnit(new CompilationUnit)
     , qmlEngine(qmlEngine)
+    , writeBatch(execAllocator)
 {
     compilationUnit->codeRefs.resize(module->functions.size());
     module->unitFlags |= QV4::CompiledData::Unit::ContainsMachineCode;
@@ -108,7 +109,7 @@ void InstructionSelection<JITAssembler>::run(int functionIndex)
     qSwap(_removableJumps, removableJumps);
 
     JITAssembler* oldAssembler = _as;
-    _as = new JITAssembler(jsGenerator, _function, executableAllocator);
+    _as = new JITAssembler(jsGenerator, _function, &writeBatch);
     _as->setStackLayout(6, // 6 == max argc for calls to built-ins with an argument array
                         regularRegistersToSave.size(),
                         fpRegistersToSave.size());
@@ -158,6 +159,9 @@ void InstructionSelection<JITAssembler>::run(int functionIndex)
 template <typename JITAssembler>
 QQmlRefPointer<QV4::CompiledData::CompilationUnit> InstructionSelection<JITAssembler>::backendCompileStep()
 {
+    // None of the functions can be run before their code is executable.
+    writeBatch.commit();
+
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> result;
     result.adopt(compilationUnit.take());
     return result;
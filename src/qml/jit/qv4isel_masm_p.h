@@ -286,6 +286,7 @@ private:
 
     QScopedPointer<CompilationUnit> compilationUnit;
     QQmlEnginePrivate *qmlEngine;
+    QV4::ExecutableAllocator::WriteBatch writeBatch;
     RegisterInformation regularRegistersToSave;
     RegisterInformation fpRegistersToSave;
 };
@@ -1107,6 +1107,7 @@ typedef QSet<QV4::Heap::Object *> V4ObjectSet;
 static QVariant toVariant(QV4::ExecutionEngine *e, const QV4::Value &value, int typeHint, bool createJSValueForObjects, V4ObjectSet *visitedObjects);
 static QObject *qtObjectFromJS(QV4::ExecutionEngine *engine, const QV4::Value &value);
 static QVariant objectToVariant(QV4::ExecutionEngine *e, const QV4::Object *o, V4ObjectSet *visitedObjects = 0);
+static QVariantList arrayToVariantList(QV4::ExecutionEngine *e, const QV4::ArrayObject *a, V4ObjectSet *visitedObjects);
 static bool convertToNativeQObject(QV4::ExecutionEngine *e, const QV4::Value &value,
                             const QByteArray &targetType,
                             void **result);
@@ -1242,19 +1243,8 @@ static QVariant objectToVariant(QV4::ExecutionEngine *e, const QV4::Object *o, V
 
     QVariant result;
 
-    if (o->as<ArrayObject>()) {
-        QV4::Scope scope(e);
-        QV4::ScopedArrayObject a(scope, o->asReturnedValue());
-        QV4::ScopedValue v(scope);
-        QVariantList list;
-
-        int length = a->getLength();
-        for (int ii = 0; ii < length; ++ii) {
-            v = a->getIndexed(ii);
-            list << ::toVariant(e, v, -1, /*createJSValueForObjects*/false, visitedObjects);
-        }
-
-        result = list;
+    if (const ArrayObject *a = o->as<ArrayObject>()) {
+        result = arrayToVariantList(e, a, visitedObjects);
     } else if (!o->as<FunctionObject>()) {
         QVariantMap map;
         QV4::Scope scope(e);
@@ -1436,11 +1426,35 @@ QV4::ReturnedValue QV4::ExecutionEngine::fromVariant(const QVariant &variant)
     return QV4::Encode(newVariantObject(variant));
 }
 
+// The elements of the array, converted like toVariant() does. The caller guards
+// against recursion by adding the array to visitedObjects.
+static QVariantList arrayToVariantList(QV4::ExecutionEngine *e, const QV4::ArrayObject *a, V4ObjectSet *visitedObjects)
+{
+    QV4::Scope scope(e);
+    QV4::ScopedValue v(scope);
+    QVariantList list;
+
+    int length = a->getLength();
+    list.reserve(length);
+    for (int ii = 0; ii < length; ++ii) {
+        v = a->getIndexed(ii);
+        list << ::toVariant(e, v, -1, /*createJSValueForObjects*/false, visitedObjects);
+    }
+    return list;
+}
+
 QVariantMap ExecutionEngine::variantMapFromJS(const Object *o)
 {
     return objectToVariant(this, o).toMap();
 }
 
+QVariantList ExecutionEngine::variantListFromJS(const ArrayObject *a)
+{
+    V4ObjectSet visitedObjects;
+    visitedObjects.insert(a->d());
+    return arrayToVariantList(this, a, &visitedObjects);
+}
+
 
 // Converts a QVariantList to JS.
 // The result is a new Array object with length equal to the length
@@ -1676,7 +1690,7 @@ bool ExecutionEngine::metaTypeFromJS(const Value *value, int type, void *data)
     case QMetaType::QVariantList: {
         const QV4::ArrayObject *a = value->as<QV4::ArrayObject>();
         if (a) {
-            *reinterpret_cast<QVariantList *>(data) = toVariant(*a, /*typeHint*/-1, /*createJSValueForObjects*/false).toList();
+            *reinterpret_cast<QVariantList *>(data) = variantListFromJS(a);
             return true;
         }
         break;
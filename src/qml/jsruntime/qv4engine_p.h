@@ -455,6 +455,7 @@ public:
     QV4::ReturnedValue fromVariant(const QVariant &);
 
     QVariantMap variantMapFromJS(const QV4::Object *o);
+    QVariantList variantListFromJS(const QV4::ArrayObject *a);
 
     bool metaTypeFromJS(const Value *value, int type, void *data);
     QV4::ReturnedValue metaTypeToJS(int type, const void *data);
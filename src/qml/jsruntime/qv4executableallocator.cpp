@@ -40,10 +40,91 @@
 #include "qv4executableallocator_p.h"
 
 #include <wtf/StdLibExtras.h>
-#include <wtf/PageAllocation.h>
+#include <wtf/PageAllocationAligned.h>
+
+#if defined(Q_OS_WIN)
+#include <qt_windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 using namespace QV4;
 
+// Functions are packed into chunks of at least this size instead of getting a mapping of
+// their own, at this granularity. Anything larger than a quarter of a chunk gets a chunk
+// of its own, so that the memory goes back to the system as soon as the function is freed.
+static const size_t minimumChunkSize = 64 * 1024;
+static const size_t hugePageSize = 2 * 1024 * 1024;
+static const size_t allocationGranularity = 16;
+
+static bool useHugePages()
+{
+#if defined(Q_OS_LINUX) && defined(MADV_HUGEPAGE)
+    static const bool enabled = qEnvironmentVariableIsSet("QV4_JIT_HUGE_PAGES");
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+static ExecutableAllocator::SizeClass sizeClassFor(size_t size)
+{
+    if (size <= 256)
+        return ExecutableAllocator::TinyFunctions;
+    if (size <= 1024)
+        return ExecutableAllocator::SmallFunctions;
+    if (size <= 4096)
+        return ExecutableAllocator::MediumFunctions;
+    if (size <= minimumChunkSize / 4)
+        return ExecutableAllocator::LargeFunctions;
+    return ExecutableAllocator::HugeFunction;
+}
+
+enum Protection {
+    ReadWrite,
+    ReadExecute,
+    ReadWriteExecute
+};
+
+static bool setProtection(void *addr, size_t size, Protection protection)
+{
+#if defined(V4_BOOTSTRAP)
+    // The code is only ever written to disk, never run.
+    Q_UNUSED(addr);
+    Q_UNUSED(size);
+    Q_UNUSED(protection);
+    return true;
+#elif defined(Q_OS_WIN)
+    DWORD oldProtect;
+    DWORD newProtect = PAGE_EXECUTE_READWRITE;
+    if (protection == ReadWrite)
+        newProtect = PAGE_READWRITE;
+    else if (protection == ReadExecute)
+        newProtect = PAGE_EXECUTE_READ;
+#  if defined(Q_OS_WINRT)
+    return VirtualProtectFromApp(addr, size, newProtect, &oldProtect);
+#  else
+    return VirtualProtect(addr, size, newProtect, &oldProtect);
+#  endif
+#else
+    int mode = PROT_READ;
+    if (protection != ReadExecute)
+        mode |= PROT_WRITE;
+    if (protection != ReadWrite)
+        mode |= PROT_EXEC;
+    return mprotect(addr, size, mode) == 0;
+#endif
+}
+
+static void setPageProtection(void *addr, size_t size, Protection protection)
+{
+    const quintptr pageSize = WTF::pageSize();
+    const quintptr iaddr = reinterpret_cast<quintptr>(addr);
+    const quintptr roundAddr = iaddr & ~(pageSize - 1);
+    if (!setProtection(reinterpret_cast<void *>(roundAddr), size + (iaddr - roundAddr), protection))
+        qFatal("Could not change the protection of JIT code");
+}
+
 void *ExecutableAllocator::Allocation::start() const
 {
     return reinterpret_cast<void*>(addr);
@@ -70,6 +151,7 @@ ExecutableAllocator::Allocation *ExecutableAllocator::Allocation::split(size_t d
 
     remainder->size = size - dividingSize;
     remainder->free = free;
+    remainder->chunk = chunk;
     remainder->addr = addr + dividingSize;
     size = dividingSize;
 
@@ -79,11 +161,12 @@ ExecutableAllocator::Allocation *ExecutableAllocator::Allocation::split(size_t d
 bool ExecutableAllocator::Allocation::mergeNext(ExecutableAllocator *allocator)
 {
     Q_ASSERT(free);
-    if (!next || !next->free)
+    // Free space on executable pages is never reused, don't let it grow into reusable space.
+    if (!next || !next->free || addr < chunk->executableEnd)
         return false;
 
-    allocator->freeAllocations.remove(size, this);
-    allocator->freeAllocations.remove(next->size, next);
+    allocator->removeFreeAllocation(this);
+    allocator->removeFreeAllocation(next);
 
     size += next->size;
     Allocation *newNext = next->next;
@@ -92,25 +175,25 @@ bool ExecutableAllocator::Allocation::mergeNext(ExecutableAllocator *allocator)
     if (next)
         next->prev = this;
 
-    allocator->freeAllocations.insert(size, this);
+    allocator->insertFreeAllocation(this);
     return true;
 }
 
 bool ExecutableAllocator::Allocation::mergePrevious(ExecutableAllocator *allocator)
 {
     Q_ASSERT(free);
-    if (!prev || !prev->free)
+    if (!prev || !prev->free || prev->addr < chunk->executableEnd)
         return false;
 
-    allocator->freeAllocations.remove(size, this);
-    allocator->freeAllocations.remove(prev->size, prev);
+    allocator->removeFreeAllocation(this);
+    allocator->removeFreeAllocation(prev);
 
     prev->size += size;
     if (next)
         next->prev = prev;
     prev->next = next;
 
-    allocator->freeAllocations.insert(prev->size, prev);
+    allocator->insertFreeAllocation(prev);
 
     delete this;
     return true;
@@ -142,12 +225,16 @@ bool ExecutableAllocator::ChunkOfPages::contains(Allocation *alloc) const
 
 ExecutableAllocator::ExecutableAllocator()
     : mutex(QMutex::NonRecursive)
+    , usedBytes()
+    , allocationCount(0)
+    , protectionChangeCount(0)
 {
 }
 
 ExecutableAllocator::~ExecutableAllocator()
 {
     for (ChunkOfPages *chunk : qAsConst(chunks)) {
+        Q_ASSERT(!chunk->writeBatch);
         for (Allocation *allocation = chunk->firstAllocation; allocation; allocation = allocation->next)
             if (!allocation->free)
                 allocation->invalidate();
@@ -156,44 +243,141 @@ ExecutableAllocator::~ExecutableAllocator()
     qDeleteAll(chunks);
 }
 
-ExecutableAllocator::Allocation *ExecutableAllocator::allocate(size_t size)
+bool ExecutableAllocator::writeXorExecute()
 {
-    QMutexLocker locker(&mutex);
-    Allocation *allocation = 0;
+#if defined(Q_OS_WINRT)
+    return true;
+#else
+    static const bool enabled = !qEnvironmentVariableIsSet("QV4_JIT_RWX");
+    return enabled;
+#endif
+}
 
-    // Code is best aligned to 16-byte boundaries.
-    size = WTF::roundUpToMultipleOf(16, size);
+void ExecutableAllocator::makeWritable(void *addr, size_t size)
+{
+    setPageProtection(addr, size, writeXorExecute() ? ReadWrite : ReadWriteExecute);
+}
 
-    QMultiMap<size_t, Allocation*>::Iterator it = freeAllocations.lowerBound(size);
-    if (it != freeAllocations.end()) {
-        allocation = *it;
-        freeAllocations.erase(it);
+void ExecutableAllocator::makeExecutable(void *addr, size_t size)
+{
+    setPageProtection(addr, size, writeXorExecute() ? ReadExecute : ReadWriteExecute);
+}
+
+ExecutableAllocator::ChunkOfPages *ExecutableAllocator::allocateChunk(size_t size, Pool pool, SizeClass sizeClass)
+{
+    ChunkOfPages *chunk = new ChunkOfPages;
+    chunk->pool = pool;
+    chunk->sizeClass = sizeClass;
+
+    size_t allocSize = WTF::roundUpToMultipleOf(WTF::pageSize(), size);
+    size_t alignment = WTF::pageSize();
+    if (sizeClass != HugeFunction) {
+        allocSize = minimumChunkSize;
+        // Hot code is packed into huge pages where possible, to reduce iTLB misses.
+        // The kernel only backs a range with a huge page if it is aligned to one.
+        if (pool == HotCode && useHugePages())
+            alignment = allocSize = hugePageSize;
     }
 
-    if (!allocation) {
-        ChunkOfPages *chunk = new ChunkOfPages;
-        size_t allocSize = WTF::roundUpToMultipleOf(WTF::pageSize(), size);
-        chunk->pages = new WTF::PageAllocation(WTF::PageAllocation::allocate(allocSize, OSAllocator::JSJITCodePages));
-        chunks.insert(reinterpret_cast<quintptr>(chunk->pages->base()) - 1, chunk);
-        allocation = new Allocation;
-        allocation->addr = reinterpret_cast<quintptr>(chunk->pages->base());
-        allocation->size = allocSize;
-        allocation->free = true;
-        chunk->firstAllocation = allocation;
+    chunk->pages = new WTF::PageAllocationAligned(WTF::PageAllocationAligned::allocate(allocSize, alignment, OSAllocator::JSJITCodePages));
+    void *base = chunk->pages->base();
+#if defined(Q_OS_LINUX) && defined(MADV_HUGEPAGE)
+    // With write-xor-execute the kernel can only keep the chunk in one huge page once all
+    // of it is executable; until then it has two protections.
+    if (allocSize == hugePageSize && alignment == hugePageSize)
+        chunk->hugePagesAdvised = madvise(base, allocSize, MADV_HUGEPAGE) == 0;
+#endif
+    if (!writeXorExecute() && !setProtection(base, allocSize, ReadWriteExecute))
+        qFatal("Could not make JIT code memory executable");
+
+    chunk->executableEnd = chunk->writtenEnd = reinterpret_cast<quintptr>(base);
+    chunks.insert(reinterpret_cast<quintptr>(base) - 1, chunk);
+
+    Allocation *allocation = new Allocation;
+    allocation->addr = reinterpret_cast<quintptr>(base);
+    allocation->size = allocSize;
+    allocation->free = true;
+    allocation->chunk = chunk;
+    chunk->firstAllocation = allocation;
+    return chunk;
+}
+
+void ExecutableAllocator::releaseChunk(ChunkOfPages *chunk)
+{
+    Q_ASSERT(!chunk->allocationCount);
+    Q_ASSERT(!chunk->writeBatch);
+
+    for (Allocation *allocation = chunk->firstAllocation; allocation; allocation = allocation->next)
+        removeFreeAllocation(allocation);
+    chunks.remove(reinterpret_cast<quintptr>(chunk->pages->base()) - 1);
+    delete chunk;
+}
+
+void ExecutableAllocator::insertFreeAllocation(Allocation *allocation)
+{
+    Q_ASSERT(allocation->chunk->sizeClass != HugeFunction);
+    freeAllocations[allocation->chunk->pool][allocation->chunk->sizeClass].insert(allocation->size, allocation);
+}
+
+void ExecutableAllocator::removeFreeAllocation(Allocation *allocation)
+{
+    if (allocation->chunk->sizeClass != HugeFunction)
+        freeAllocations[allocation->chunk->pool][allocation->chunk->sizeClass].remove(allocation->size, allocation);
+}
+
+ExecutableAllocator::Allocation *ExecutableAllocator::allocate(size_t size, WriteBatch *batch, Pool pool)
+{
+    QMutexLocker locker(&mutex);
+    Q_ASSERT(batch && batch->allocator == this);
+
+    const bool wx = writeXorExecute();
+    size = WTF::roundUpToMultipleOf(allocationGranularity, size);
+    const SizeClass sizeClass = sizeClassFor(size);
+
+    Allocation *allocation = 0;
+    if (sizeClass != HugeFunction) {
+        QMultiMap<size_t, Allocation*> &freeList = freeAllocations[pool][sizeClass];
+        for (QMultiMap<size_t, Allocation*>::Iterator it = freeList.lowerBound(size); it != freeList.end(); ++it) {
+            // Committing a batch makes all pages it wrote to executable, including
+            // the parts of them that another batch might be writing to.
+            const WriteBatch *chunkBatch = (*it)->chunk->writeBatch;
+            if (wx && chunkBatch && chunkBatch != batch)
+                continue;
+            allocation = *it;
+            freeList.erase(it);
+            break;
+        }
     }
 
+    if (!allocation)
+        allocation = allocateChunk(size, pool, sizeClass)->firstAllocation;
+
     Q_ASSERT(allocation);
     Q_ASSERT(allocation->free);
+    Q_ASSERT(allocation->chunk->pool == pool);
 
     allocation->free = false;
 
-    if (allocation->size > size) {
+    if (allocation->size > size && sizeClass != HugeFunction) {
         Allocation *remainder = allocation->split(size);
         remainder->free = true;
         if (!remainder->mergeNext(this))
-            freeAllocations.insert(remainder->size, remainder);
+            insertFreeAllocation(remainder);
     }
 
+    ChunkOfPages *chunk = allocation->chunk;
+    ++chunk->allocationCount;
+    if (wx) {
+        if (!chunk->writeBatch) {
+            chunk->writeBatch = batch;
+            batch->chunks.append(chunk);
+        }
+        chunk->writtenEnd = qMax<quintptr>(chunk->writtenEnd, allocation->addr + allocation->size);
+    }
+
+    usedBytes[pool] += allocation->size;
+    ++allocationCount;
+
     return allocation;
 }
 
@@ -202,40 +386,96 @@ void ExecutableAllocator::free(Allocation *allocation)
     QMutexLocker locker(&mutex);
 
     Q_ASSERT(allocation);
+    ChunkOfPages *chunk = allocation->chunk;
+    Q_ASSERT(chunk->contains(allocation));
 
     allocation->free = true;
 
-    QMap<quintptr, ChunkOfPages*>::Iterator it = chunks.lowerBound(allocation->addr);
-    if (it != chunks.begin())
-        --it;
-    Q_ASSERT(it != chunks.end());
-    ChunkOfPages *chunk = *it;
-    Q_ASSERT(chunk->contains(allocation));
+    usedBytes[chunk->pool] -= allocation->size;
+    --allocationCount;
+
+    // A chunk that a batch wrote to is released when the batch is committed.
+    if (!--chunk->allocationCount && !chunk->writeBatch) {
+        releaseChunk(chunk);
+        return;
+    }
+
+    // Code may still be running on the pages around the allocation, see commit().
+    if (chunk->sizeClass == HugeFunction || allocation->addr < chunk->executableEnd)
+        return;
 
     bool merged = allocation->mergeNext(this);
     merged |= allocation->mergePrevious(this);
     if (!merged)
-        freeAllocations.insert(allocation->size, allocation);
+        insertFreeAllocation(allocation);
+}
 
-    allocation = 0;
+void ExecutableAllocator::commit(WriteBatch *batch)
+{
+    QMutexLocker locker(&mutex);
 
-    if (!chunk->firstAllocation->next) {
-        freeAllocations.remove(chunk->firstAllocation->size, chunk->firstAllocation);
-        chunks.erase(it);
-        delete chunk;
-        return;
+    for (ChunkOfPages *chunk : qAsConst(batch->chunks)) {
+        Q_ASSERT(chunk->writeBatch == batch);
+        chunk->writeBatch = 0;
+
+        const quintptr end = WTF::roundUpToMultipleOf(WTF::pageSize(), chunk->writtenEnd);
+        if (end > chunk->executableEnd) {
+            if (!setProtection(reinterpret_cast<void *>(chunk->executableEnd), end - chunk->executableEnd, ReadExecute))
+                qFatal("Could not make JIT code executable");
+            ++protectionChangeCount;
+            chunk->executableEnd = end;
+
+            // Whatever is left free on the pages that just became executable can't be
+            // written to again without taking the execute permission away from code that
+            // may be running. It is only given back with the whole chunk.
+            for (Allocation *allocation = chunk->firstAllocation; allocation && allocation->addr < end; allocation = allocation->next) {
+                if (!allocation->free)
+                    continue;
+                removeFreeAllocation(allocation);
+                if (allocation->addr + allocation->size > end) {
+                    insertFreeAllocation(allocation->split(end - allocation->addr));
+                    break;
+                }
+            }
+        }
+
+        if (!chunk->allocationCount)
+            releaseChunk(chunk);
     }
+    batch->chunks.clear();
 }
 
-ExecutableAllocator::ChunkOfPages *ExecutableAllocator::chunkForAllocation(Allocation *allocation) const
+ExecutableAllocator::Statistics ExecutableAllocator::statistics() const
 {
     QMutexLocker locker(&mutex);
 
-    QMap<quintptr, ChunkOfPages*>::ConstIterator it = chunks.lowerBound(allocation->addr);
-    if (it != chunks.begin())
-        --it;
-    if (it == chunks.end())
-        return 0;
-    return *it;
+    Statistics stats;
+    stats.chunkCount = chunks.count();
+    for (const ChunkOfPages *chunk : chunks) {
+        stats.reservedBytes += chunk->pages->size();
+        if (chunk->hugePagesAdvised)
+            ++stats.hugePageAdvisedChunkCount;
+    }
+    for (int pool = 0; pool < PoolCount; ++pool) {
+        stats.usedBytesPerPool[pool] = usedBytes[pool];
+        stats.usedBytes += usedBytes[pool];
+    }
+    stats.allocationCount = allocationCount;
+    stats.protectionChangeCount = protectionChangeCount;
+    return stats;
+}
+
+int ExecutableAllocator::freeAllocationCount() const
+{
+    int count = 0;
+    for (int pool = 0; pool < PoolCount; ++pool) {
+        for (int sizeClass = 0; sizeClass < SizeClassCount; ++sizeClass)
+            count += freeAllocations[pool][sizeClass].count();
+    }
+    return count;
 }
 
+ExecutableAllocator::ChunkOfPages *ExecutableAllocator::chunkForAllocation(Allocation *allocation) const
+{
+    return allocation->chunk;
+}
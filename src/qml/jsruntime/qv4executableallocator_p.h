@@ -60,11 +60,10 @@
 #include <QMutex>
 
 namespace WTF {
-class PageAllocation;
+class PageAllocationAligned;
 }
 
 QT_BEGIN_NAMESPACE
-
 namespace QV4 {
 
 class Q_QML_AUTOTEST_EXPORT ExecutableAllocator
@@ -72,19 +71,98 @@ class Q_QML_AUTOTEST_EXPORT ExecutableAllocator
 public:
     struct ChunkOfPages;
     struct Allocation;
+    class WriteBatch;
+
+    // Code that is run only once (such as the global code of a script) is kept apart
+    // from the rest, so that frequently executed functions are packed densely.
+    enum Pool {
+        HotCode,
+        ColdCode,
+        PoolCount
+    };
+
+    // Functions of similar size share chunks, so that the hole a function leaves behind
+    // when it is freed fits the next function of its class. Functions larger than the
+    // largest class get a chunk of their own.
+    enum SizeClass {
+        TinyFunctions,
+        SmallFunctions,
+        MediumFunctions,
+        LargeFunctions,
+        SizeClassCount,
+        HugeFunction = SizeClassCount
+    };
+
+    struct Statistics
+    {
+        Statistics()
+            : chunkCount(0)
+            , hugePageAdvisedChunkCount(0)
+            , reservedBytes(0)
+            , usedBytes(0)
+            , allocationCount(0)
+            , usedBytesPerPool()
+            , protectionChangeCount(0)
+        {}
+
+        int chunkCount;
+        // Chunks that are aligned to and advised for huge pages; whether the kernel
+        // actually backs them with one is up to it.
+        int hugePageAdvisedChunkCount;
+        size_t reservedBytes;
+        size_t usedBytes;
+        int allocationCount;
+        size_t usedBytesPerPool[PoolCount];
+        // Number of times the protection of a range of code was changed to make newly
+        // written code executable.
+        int protectionChangeCount;
+    };
+
+    // Code is written into memory that is not executable yet. All memory allocated
+    // through a batch is made executable when the batch is committed, with one
+    // protection change per chunk that was written to, no matter how many functions
+    // went into it. The code must not be run before that.
+    class WriteBatch
+    {
+    public:
+        explicit WriteBatch(ExecutableAllocator *allocator)
+            : allocator(allocator)
+        {}
+        ~WriteBatch() { commit(); }
+
+        void commit() { allocator->commit(this); }
+
+        ExecutableAllocator *const allocator;
+
+    private:
+        Q_DISABLE_COPY(WriteBatch)
+        friend class ExecutableAllocator;
+
+        QVector<ChunkOfPages *> chunks;
+    };
 
     ExecutableAllocator();
     ~ExecutableAllocator();
 
-    Allocation *allocate(size_t size);
+    Allocation *allocate(size_t size, WriteBatch *batch, Pool pool = HotCode);
     void free(Allocation *allocation);
 
+    Statistics statistics() const;
+
+    // With write-xor-execute, memory that holds code is never writable and executable at
+    // the same time. It is the default; setting QV4_JIT_RWX maps JIT code writable and
+    // executable at once instead, which saves the protection changes altogether.
+    static bool writeXorExecute();
+    static void makeWritable(void *addr, size_t size);
+    static void makeExecutable(void *addr, size_t size);
+
     struct Allocation
     {
         Allocation()
             : addr(0)
             , size(0)
             , free(true)
+            , chunk(0)
             , next(0)
             , prev(0)
         {}
@@ -106,12 +184,13 @@ public:
         quintptr addr;
         uint size : 31; // More than 2GB of function code? nah :)
         uint free : 1;
+        ChunkOfPages *chunk;
         Allocation *next;
         Allocation *prev;
     };
 
     // for debugging / unit-testing
-    int freeAllocationCount() const { return freeAllocations.count(); }
+    int freeAllocationCount() const;
     int chunkCount() const { return chunks.count(); }
 
     struct ChunkOfPages
@@ -119,11 +198,29 @@ public:
         ChunkOfPages()
             : pages(0)
             , firstAllocation(0)
+            , pool(HotCode)
+            , sizeClass(HugeFunction)
+            , hugePagesAdvised(false)
+            , allocationCount(0)
+            , executableEnd(0)
+            , writeBatch(0)
+            , writtenEnd(0)
         {}
         ~ChunkOfPages();
 
-        WTF::PageAllocation *pages;
+        WTF::PageAllocationAligned *pages;
         Allocation *firstAllocation;
+        Pool pool;
+        SizeClass sizeClass;
+        bool hugePagesAdvised;
+        int allocationCount;
+
+        // With write-xor-execute, the pages of a chunk below executableEnd hold code that
+        // may be running, the ones above it are writable. A chunk takes new code for one
+        // batch at a time, and only into its writable pages.
+        quintptr executableEnd;
+        WriteBatch *writeBatch;
+        quintptr writtenEnd;
 
         bool contains(Allocation *alloc) const;
     };
@@ -131,9 +228,19 @@ public:
     ChunkOfPages *chunkForAllocation(Allocation *allocation) const;
 
 private:
-    QMultiMap<size_t, Allocation*> freeAllocations;
+    ChunkOfPages *allocateChunk(size_t size, Pool pool, SizeClass sizeClass);
+    void releaseChunk(ChunkOfPages *chunk);
+    void commit(WriteBatch *batch);
+    void insertFreeAllocation(Allocation *allocation);
+    void removeFreeAllocation(Allocation *allocation);
+
+    QMultiMap<size_t, Allocation*> freeAllocations[PoolCount][SizeClassCount];
     QMap<quintptr, ChunkOfPages*> chunks;
     mutable QMutex mutex;
+
+    size_t usedBytes[PoolCount];
+    int allocationCount;
+    int protectionChangeCount;
 };
 
 }
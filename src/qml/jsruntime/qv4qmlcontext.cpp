@@ -152,6 +152,38 @@ ReturnedValue QmlContextWrapper::get(const Managed *m, String *name, bool *hasPr
 
     QQmlEnginePrivate *ep = QQmlEnginePrivate::get(v4->qmlEngine());
 
+    auto contextProperty = [&](QQmlContextData *context, int propertyIdx) -> ReturnedValue {
+        if (hasProperty)
+            *hasProperty = true;
+
+        if (propertyIdx < context->idValueCount) {
+            if (ep->propertyCapture)
+                ep->propertyCapture->captureProperty(&context->idValues[propertyIdx].bindings);
+            return QV4::QObjectWrapper::wrap(v4, context->idValues[propertyIdx]);
+        }
+
+        QQmlContextPrivate *cp = context->asQQmlContextPrivate();
+
+        if (ep->propertyCapture)
+            ep->propertyCapture->captureProperty(context->asQQmlContext(), -1, propertyIdx + cp->notifyIndex);
+
+        const QVariant &value = cp->propertyValues.at(propertyIdx);
+        if (value.userType() == qMetaTypeId<QList<QObject*> >()) {
+            QQmlListProperty<QObject> prop(context->asQQmlContext(), (void*) qintptr(propertyIdx),
+                                                   QQmlContextPrivate::context_count,
+                                                   QQmlContextPrivate::context_at);
+            return QmlListWrapper::create(v4, prop, qMetaTypeId<QQmlListProperty<QObject> >());
+        }
+        return scope.engine->fromVariant(value);
+    };
+
+    // Past the scope object, the search only depends on the context chain. Names found
+    // as ids or context properties of parent contexts are remembered by the expression
+    // context as (depth, index) pairs, so that later evaluations skip the walk.
+    const int lookupGeneration = QQmlContextData::currentParentLookupGeneration();
+    const bool parentLookupCacheValid = expressionContext->parentLookupGeneration == lookupGeneration;
+    int depth = 0;
+
     while (context) {
         // Search context properties
         const QV4::IdentifierHash<int> &properties = context->propertyNames();
@@ -159,33 +191,15 @@ ReturnedValue QmlContextWrapper::get(const Managed *m, String *name, bool *hasPr
             int propertyIdx = properties.value(name);
 
             if (propertyIdx != -1) {
-
-                if (propertyIdx < context->idValueCount) {
-
-                    if (ep->propertyCapture)
-                        ep->propertyCapture->captureProperty(&context->idValues[propertyIdx].bindings);
-                    if (hasProperty)
-                        *hasProperty = true;
-                    return QV4::QObjectWrapper::wrap(v4, context->idValues[propertyIdx]);
-                } else {
-
-                    QQmlContextPrivate *cp = context->asQQmlContextPrivate();
-
-                    if (ep->propertyCapture)
-                        ep->propertyCapture->captureProperty(context->asQQmlContext(), -1, propertyIdx + cp->notifyIndex);
-
-                    const QVariant &value = cp->propertyValues.at(propertyIdx);
-                    if (hasProperty)
-                        *hasProperty = true;
-                    if (value.userType() == qMetaTypeId<QList<QObject*> >()) {
-                        QQmlListProperty<QObject> prop(context->asQQmlContext(), (void*) qintptr(propertyIdx),
-                                                               QQmlContextPrivate::context_count,
-                                                               QQmlContextPrivate::context_at);
-                        return QmlListWrapper::create(v4, prop, qMetaTypeId<QQmlListProperty<QObject> >());
-                    } else {
-                        return scope.engine->fromVariant(cp->propertyValues.at(propertyIdx));
+                if (depth > 0 && QQmlContextData::canEncodeParentLookup(depth, propertyIdx)) {
+                    if (!parentLookupCacheValid || expressionContext->parentLookupCache.isEmpty()) {
+                        expressionContext->parentLookupCache = QV4::IdentifierHash<int>(v4);
+                        expressionContext->parentLookupGeneration = lookupGeneration;
                     }
+                    if (expressionContext->parentLookupCache.value(name) == -1)
+                        expressionContext->parentLookupCache.add(name->d(), QQmlContextData::encodeParentLookup(depth, propertyIdx));
                 }
+                return contextProperty(context, propertyIdx);
             }
         }
 
@@ -202,6 +216,16 @@ ReturnedValue QmlContextWrapper::get(const Managed *m, String *name, bool *hasPr
         }
         scopeObject = 0;
 
+        if (depth == 0 && parentLookupCacheValid && !expressionContext->parentLookupCache.isEmpty()) {
+            const int cached = expressionContext->parentLookupCache.value(name);
+            if (cached != -1) {
+                QQmlContextData *parentContext = context;
+                for (int i = QQmlContextData::parentLookupDepth(cached); parentContext && i > 0; --i)
+                    parentContext = parentContext->parent;
+                if (parentContext)
+                    return contextProperty(parentContext, QQmlContextData::parentLookupIndex(cached));
+            }
+        }
 
         // Search context object
         if (context->contextObject) {
@@ -215,6 +239,7 @@ ReturnedValue QmlContextWrapper::get(const Managed *m, String *name, bool *hasPr
         }
 
         context = context->parent;
+        ++depth;
     }
 
     expressionContext->unresolvedNames = true;
@@ -1057,6 +1057,8 @@ private:
         QString *qstringPtr;
         QByteArray *qbyteArrayPtr;
         QVariant *qvariantPtr;
+        QVariantList *qvariantListPtr;
+        QVariantMap *qvariantMapPtr;
         QList<QObject *> *qlistPtr;
         QJSValue *qjsValuePtr;
         QQmlV4Handle *handlePtr;
@@ -1456,6 +1458,10 @@ void CallArgument::cleanup()
         qjsValuePtr->~QJSValue();
     } else if (type == qMetaTypeId<QList<QObject *> >()) {
         qlistPtr->~QList<QObject *>();
+    } else if (type == QMetaType::QVariantList) {
+        qvariantListPtr->~QVariantList();
+    } else if (type == QMetaType::QVariantMap) {
+        qvariantMapPtr->~QVariantMap();
     }  else if (type == QMetaType::QJsonArray) {
         jsonArrayPtr->~QJsonArray();
     }  else if (type == QMetaType::QJsonObject) {
@@ -1500,6 +1506,12 @@ void CallArgument::initAsType(int callType)
     } else if (callType == qMetaTypeId<QList<QObject *> >()) {
         type = callType;
         qlistPtr = new (&allocData) QList<QObject *>();
+    } else if (callType == QMetaType::QVariantList) {
+        type = callType;
+        qvariantListPtr = new (&allocData) QVariantList();
+    } else if (callType == QMetaType::QVariantMap) {
+        type = callType;
+        qvariantMapPtr = new (&allocData) QVariantMap();
     } else if (callType == qMetaTypeId<QQmlV4Handle>()) {
         type = callType;
         handlePtr = new (&allocData) QQmlV4Handle;
@@ -1583,6 +1595,15 @@ void CallArgument::fromValue(int callType, QV4::ExecutionEngine *engine, const Q
             qlistPtr->append(o);
         }
         type = callType;
+    } else if (callType == QMetaType::QVariantList && value.as<QV4::ArrayObject>()) {
+        // Arrays and plain objects are converted in place, anything else needs to go through
+        // the generic QVariant conversion below.
+        qvariantListPtr = new (&allocData) QVariantList(scope.engine->variantListFromJS(value.as<QV4::ArrayObject>()));
+        type = callType;
+    } else if (callType == QMetaType::QVariantMap && value.as<QV4::Object>()
+               && value.as<QV4::Object>()->d()->vtable() == QV4::Object::staticVTable()) {
+        qvariantMapPtr = new (&allocData) QVariantMap(scope.engine->variantMapFromJS(value.as<QV4::Object>()));
+        type = callType;
     } else if (callType == qMetaTypeId<QQmlV4Handle>()) {
         handlePtr = new (&allocData) QQmlV4Handle(value.asReturnedValue());
         type = callType;
@@ -1667,6 +1688,10 @@ QV4::ReturnedValue CallArgument::toValue(QV4::ExecutionEngine *engine)
             array->arrayPut(ii, (v = QV4::QObjectWrapper::wrap(scope.engine, list.at(ii))));
         array->setArrayLengthUnchecked(list.count());
         return array.asReturnedValue();
+    } else if (type == QMetaType::QVariantList) {
+        return scope.engine->metaTypeToJS(type, qvariantListPtr);
+    } else if (type == QMetaType::QVariantMap) {
+        return scope.engine->metaTypeToJS(type, qvariantMapPtr);
     } else if (type == qMetaTypeId<QQmlV4Handle>()) {
         return *handlePtr;
     } else if (type == QMetaType::QJsonArray) {
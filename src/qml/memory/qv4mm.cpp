@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qv4engine_p.h"
+#include "qv4executableallocator_p.h"
 #include "qv4object_p.h"
 #include "qv4objectproto_p.h"
 #include "qv4mm_p.h"
@@ -998,6 +999,12 @@ void MemoryManager::runGC()
             qDebug() << "Large item memory after GC:" << largeItemsAfter;
             qDebug() << "Large item memory freed up:" << (largeItemsBefore - largeItemsAfter);
         }
+        const ExecutableAllocator::Statistics jitStats = engine->executableAllocator->statistics();
+        qDebug() << "JIT code memory:" << jitStats.reservedBytes << "bytes in" << jitStats.chunkCount << "chunks,"
+                 << jitStats.hugePageAdvisedChunkCount << "of them advised for huge pages";
+        qDebug() << "    used by" << jitStats.allocationCount << "functions:" << jitStats.usedBytes
+                 << "bytes (cold code:" << jitStats.usedBytesPerPool[ExecutableAllocator::ColdCode] << "bytes)";
+        qDebug() << "    made executable with" << jitStats.protectionChangeCount << "protection changes";
         qDebug() << "======== End GC ========";
     }
 
@@ -17,6 +17,8 @@ SOURCES += \
     $$PWD/qqmlstringconverters.cpp \
     $$PWD/qqmlparserstatus.cpp \
     $$PWD/qqmltypeloader.cpp \
+    $$PWD/qqmlstartupmanifest.cpp \
+    $$PWD/qqmltypedbinding.cpp \
     $$PWD/qqmlinfo.cpp \
     $$PWD/qqmlerror.cpp \
     $$PWD/qqmlvaluetype.cpp \
@@ -30,6 +32,7 @@ SOURCES += \
     $$PWD/qqmlnetworkaccessmanagerfactory.cpp \
     $$PWD/qqmlextensionplugin.cpp \
     $$PWD/qqmlimport.cpp \
+    $$PWD/qqmlimportresolutioncache.cpp \
     $$PWD/qqmllist.cpp \
     $$PWD/qqmllocale.cpp \
     $$PWD/qqmljavascriptexpression.cpp \
@@ -46,6 +49,7 @@ SOURCES += \
     $$PWD/qqmltypewrapper.cpp \
     $$PWD/qqmlfileselector.cpp \
     $$PWD/qqmlobjectcreator.cpp \
+    $$PWD/qqmlcreationarena.cpp \
     $$PWD/qqmldirparser.cpp \
     $$PWD/qqmldelayedcallqueue.cpp \
     $$PWD/qqmlloggingcategory.cpp
@@ -80,6 +84,8 @@ HEADERS += \
     $$PWD/qqmlproperty_p.h \
     $$PWD/qqmlcontext_p.h \
     $$PWD/qqmltypeloader_p.h \
+    $$PWD/qqmlstartupmanifest_p.h \
+    $$PWD/qqmltypedbinding_p.h \
     $$PWD/qqmllist.h \
     $$PWD/qqmllist_p.h \
     $$PWD/qqmldata_p.h \
@@ -97,6 +103,8 @@ HEADERS += \
     $$PWD/qqmlnetworkaccessmanagerfactory.h \
     $$PWD/qqmlextensioninterface.h \
     $$PWD/qqmlimport_p.h \
+    $$PWD/qqmlimportresolutioncache_p.h \
+    $$PWD/qqmlimportresolutioncacheformat_p.h \
     $$PWD/qqmlextensionplugin.h \
     $$PWD/qqmlscriptstring_p.h \
     $$PWD/qqmllocale_p.h \
@@ -116,6 +124,7 @@ HEADERS += \
     $$PWD/qqmlfileselector_p.h \
     $$PWD/qqmlfileselector.h \
     $$PWD/qqmlobjectcreator_p.h \
+    $$PWD/qqmlcreationarena_p.h \
     $$PWD/qqmldirparser_p.h \
     $$PWD/qqmldelayedcallqueue_p.h \
     $$PWD/qqmlloggingcategory_p.h
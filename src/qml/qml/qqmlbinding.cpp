@@ -54,6 +54,7 @@
 
 #include <QVariant>
 #include <QtCore/qdebug.h>
+#include <QtCore/qvarlengtharray.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -111,9 +112,10 @@ QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QString
 }
 
 QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, QV4::Function *function,
-                                 QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope)
+                                 QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope,
+                                 QQmlCreationArena *arena)
 {
-    QQmlBinding *b = newBinding(QQmlEnginePrivate::get(ctxt), property);
+    QQmlBinding *b = newBinding(QQmlEnginePrivate::get(ctxt), property, arena);
 
     b->setNotifyOnValueChanged(true);
     b->QQmlJavaScriptExpression::setContext(ctxt);
@@ -145,12 +147,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        printBindingLoopError();
         return;
     }
     setUpdatingFlag(true);
@@ -202,8 +199,13 @@ protected:
 
         bool isUndefined = false;
 
-        QV4::ScopedCallData callData(scope);
-        QQmlJavaScriptExpression::evaluate(callData, &isUndefined, scope);
+        double typedResult;
+        if (evaluateTyped(&typedResult)) {
+            scope.result = QV4::Primitive::fromDouble(typedResult);
+        } else {
+            QV4::ScopedCallData callData(scope);
+            QQmlJavaScriptExpression::evaluate(callData, &isUndefined, scope);
+        }
 
         bool error = false;
         if (!watcher.wasDeleted() && isAddedToObject() && !hasError())
@@ -429,8 +431,25 @@ QString QQmlBinding::expressionIdentifier() const
     return url + QString::asprintf(":%u:%u", uint(lineNumber), uint(columnNumber));
 }
 
+void QQmlBinding::printBindingLoopError()
+{
+    QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 void QQmlBinding::expressionChanged()
 {
+    if (QQmlContextData *ctxt = context()) {
+        QQmlBindingBatch *batch = ctxt->engine ? QQmlEnginePrivate::get(ctxt->engine)->bindingBatch : 0;
+        if (batch && batch->isActive()) {
+            batch->schedule(this);
+            return;
+        }
+    }
     update();
 }
 
@@ -594,31 +613,167 @@ protected:
     }
 };
 
-QQmlBinding *QQmlBinding::newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property)
+QQmlBinding *QQmlBinding::newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property,
+                                     QQmlCreationArena *arena)
 {
     if (property && property->isQObject())
-        return new QObjectPointerBinding(engine, property->propType());
+        return new (arena) QObjectPointerBinding(engine, property->propType());
 
     const int type = (property && property->isFullyResolved()) ? property->propType() : QMetaType::UnknownType;
 
     if (type == qMetaTypeId<QQmlBinding *>()) {
-        return new QQmlBindingBinding;
+        return new (arena) QQmlBindingBinding;
     }
 
     switch (type) {
     case QMetaType::Bool:
-        return new GenericBinding<QMetaType::Bool>;
+        return new (arena) GenericBinding<QMetaType::Bool>;
     case QMetaType::Int:
-        return new GenericBinding<QMetaType::Int>;
+        return new (arena) GenericBinding<QMetaType::Int>;
     case QMetaType::Double:
-        return new GenericBinding<QMetaType::Double>;
+        return new (arena) GenericBinding<QMetaType::Double>;
     case QMetaType::Float:
-        return new GenericBinding<QMetaType::Float>;
+        return new (arena) GenericBinding<QMetaType::Float>;
     case QMetaType::QString:
-        return new GenericBinding<QMetaType::QString>;
+        return new (arena) GenericBinding<QMetaType::QString>;
     default:
-        return new GenericBinding<QMetaType::UnknownType>;
+        return new (arena) GenericBinding<QMetaType::UnknownType>;
+    }
+}
+
+void QQmlBindingBatch::schedule(QQmlBinding *binding)
+{
+    const int index = addNode(binding);
+    nodes[index].dirty = true;
+    // A binding that already settled is notified again by a binding loop, or by a
+    // dependency that was not known when the batch looked up its dependents.
+    if (flushing && nodes.at(index).waiting == 0)
+        enqueue(index);
+}
+
+int QQmlBindingBatch::addNode(QQmlBinding *binding)
+{
+    const auto it = nodeIndex.constFind(binding);
+    if (it != nodeIndex.constEnd())
+        return *it;
+
+    const int index = nodes.count();
+    nodes.append(Node());
+    nodes.last().binding = binding;
+    nodeIndex.insert(binding, index);
+
+    // Look up the bindings that depend on the target property of the new nodes.
+    QVarLengthArray<int, 16> unvisited;
+    unvisited.append(index);
+    while (!unvisited.isEmpty()) {
+        const int node = unvisited.takeLast();
+        QQmlBinding *source = static_cast<QQmlBinding *>(nodes.at(node).binding.data());
+        if (!source->isAddedToObject() || !source->context())
+            continue;
+
+        QQmlPropertyData *property = 0;
+        source->getPropertyData(&property, 0);
+        const int notifyIndex = property->notifyIndex();
+        QQmlData *ddata = QQmlData::get(source->targetObject());
+        if (notifyIndex == -1 || !ddata || !ddata->signalHasEndpoint(notifyIndex))
+            continue;
+
+        for (QQmlNotifierEndpoint *ep = ddata->notify(notifyIndex); ep; ep = ep->next) {
+            if (ep->callback != QQmlNotifierEndpoint::QQmlJavaScriptExpressionGuard)
+                continue;
+            QQmlBinding *dependent = static_cast<QQmlJavaScriptExpressionGuard *>(ep)->expression->asBinding();
+            if (!dependent)
+                continue;
+
+            int dependentIndex = nodeIndex.value(dependent, -1);
+            if (dependentIndex == -1) {
+                dependentIndex = nodes.count();
+                nodes.append(Node());
+                nodes.last().binding = dependent;
+                nodeIndex.insert(dependent, dependentIndex);
+                unvisited.append(dependentIndex);
+            } else if (nodes.at(dependentIndex).settled) {
+                continue;
+            }
+            nodes[node].dependents.append(dependentIndex);
+            ++nodes[dependentIndex].waiting;
+        }
+    }
+    return index;
+}
+
+void QQmlBindingBatch::enqueue(int index)
+{
+    Node &node = nodes[index];
+    if (node.queued || (node.settled && !node.dirty))
+        return;
+    node.queued = true;
+    ready.enqueue(index);
+}
+
+void QQmlBindingBatch::flush()
+{
+    // Evaluating a binding this many times in one batch means that it depends on itself.
+    static const int maximumEvaluations = 100;
+
+    if (flushing)
+        return;
+    flushing = true;
+
+    for (int i = 0; i < nodes.count(); ++i) {
+        if (nodes.at(i).waiting == 0)
+            enqueue(i);
+    }
+
+    int unsettled = 0;
+    for (;;) {
+        if (ready.isEmpty()) {
+            // The remaining nodes wait for each other. Settle the oldest one to break the cycle.
+            while (unsettled < nodes.count() && nodes.at(unsettled).settled)
+                ++unsettled;
+            if (unsettled == nodes.count())
+                break;
+            nodes[unsettled].waiting = 0;
+            enqueue(unsettled);
+        }
+
+        const int index = ready.dequeue();
+        nodes[index].queued = false;
+        // A dependency was found after the node was queued; it is queued again once that settled.
+        if (nodes.at(index).waiting > 0)
+            continue;
+
+        if (nodes.at(index).dirty) {
+            nodes[index].dirty = false;
+            QQmlBinding *binding = static_cast<QQmlBinding *>(nodes.at(index).binding.data());
+            // The binding was removed or its target object destroyed while it was waiting.
+            if (binding->isAddedToObject()) {
+                const int evaluations = nodes.at(index).evaluations;
+                if (evaluations < maximumEvaluations) {
+                    nodes[index].evaluations = evaluations + 1;
+                    binding->update();
+                } else if (evaluations == maximumEvaluations) {
+                    nodes[index].evaluations = evaluations + 1;
+                    binding->printBindingLoopError();
+                }
+            }
+        }
+
+        if (nodes.at(index).settled)
+            continue;
+        nodes[index].settled = true;
+        const QVector<int> dependents = nodes.at(index).dependents;
+        for (int dependent : dependents) {
+            // Nodes forced out of a cycle already stopped waiting.
+            if (nodes.at(dependent).waiting > 0 && --nodes[dependent].waiting == 0)
+                enqueue(dependent);
+        }
     }
+
+    ready.clear();
+    nodeIndex.clear();
+    nodes.clear();
+    flushing = false;
 }
 
 QT_END_NAMESPACE
@@ -60,6 +60,9 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QMetaProperty>
+#include <QtCore/QHash>
+#include <QtCore/QQueue>
+#include <QtCore/QVector>
 
 #include <private/qqmlabstractbinding_p.h>
 #include <private/qqmljavascriptexpression_p.h>
@@ -67,16 +70,19 @@
 QT_BEGIN_NAMESPACE
 
 class QQmlContext;
+class QQmlBindingBatch;
 class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
     friend class QQmlAbstractBinding;
+    friend class QQmlBindingBatch;
 public:
     static QQmlBinding *create(const QQmlPropertyData *, const QQmlScriptString &, QObject *, QQmlContext *);
     static QQmlBinding *create(const QQmlPropertyData *, const QString &, QObject *, QQmlContextData *,
                                const QString &url = QString(), quint16 lineNumber = 0);
     static QQmlBinding *create(const QQmlPropertyData *property, QV4::Function *function,
-                               QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope);
+                               QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope,
+                               QQmlCreationArena *arena = 0);
     ~QQmlBinding();
 
     void setTarget(const QQmlProperty &);
@@ -99,6 +105,7 @@ public:
 
     QString expressionIdentifier() const override;
     void expressionChanged() override;
+    QQmlBinding *asBinding() override { return this; }
 
 protected:
     virtual void doUpdate(const DeleteWatcher &watcher,
@@ -116,7 +123,55 @@ private:
     inline bool enabledFlag() const;
     inline void setEnabledFlag(bool);
 
-    static QQmlBinding *newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property);
+    void printBindingLoopError();
+
+    static QQmlBinding *newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property,
+                                   QQmlCreationArena *arena = 0);
+};
+
+// Bindings whose dependencies changed between QQmlEngine::beginBindingBatch() and
+// endBindingBatch(). When a binding is marked as dirty, the bindings that depend on its
+// target property are looked up through the notifier endpoints of that property, and so
+// on transitively. Each node of that graph counts the nodes it depends on that have not
+// settled yet. When the batch is flushed, a node is only processed once that count drops
+// to zero: it is evaluated if one of its dependencies changed, and then settles. This
+// evaluates each binding once, after all of its inputs, as long as the dependencies do
+// not change while the batch is flushed. When only nodes waiting for each other are
+// left, the oldest of them stops waiting to break the cycle.
+//
+// Nodes keep their binding alive, but not its target object; bindings that were removed
+// from their object in the meantime are not evaluated.
+class QQmlBindingBatch
+{
+public:
+    QQmlBindingBatch() : depth(0), flushing(false) {}
+
+    bool isActive() const { return depth > 0 || flushing; }
+    void schedule(QQmlBinding *binding);
+    void flush();
+
+    int depth;
+
+private:
+    struct Node {
+        Node() : waiting(0), evaluations(0), dirty(false), queued(false), settled(false) {}
+
+        QQmlAbstractBinding::Ptr binding;
+        QVector<int> dependents;
+        int waiting;
+        int evaluations;
+        bool dirty;
+        bool queued;
+        bool settled;
+    };
+
+    int addNode(QQmlBinding *binding);
+    void enqueue(int index);
+
+    bool flushing;
+    QVector<Node> nodes;
+    QHash<QQmlBinding *, int> nodeIndex;
+    QQueue<int> ready;
 };
 
 bool QQmlBinding::updatingFlag() const
@@ -60,6 +60,7 @@
 #include <private/qqmlrefcount_p.h>
 #include <private/qqmlglobal_p.h>
 #include <private/qbitfield_p.h>
+#include <private/qqmlcreationarena_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -78,6 +79,8 @@ public:
     QQmlBoundSignalExpression(QObject *target, int index,
                               QQmlContextData *ctxt, QObject *scope, QV4::Function *runtimeFunction);
 
+    QQML_CREATION_ARENA_ALLOCATED
+
     // inherited from QQmlJavaScriptExpression.
     QString expressionIdentifier() const override;
     void expressionChanged() override;
@@ -108,6 +111,8 @@ public:
     QQmlBoundSignal(QObject *target, int signal, QObject *owner, QQmlEngine *engine);
     ~QQmlBoundSignal();
 
+    QQML_CREATION_ARENA_ALLOCATED
+
     void removeFromObject();
 
     QQmlBoundSignalExpression *expression() const;
@@ -282,6 +282,7 @@ void QQmlContext::setContextObject(QObject *object)
     }
 
     data->contextObject = object;
+    QQmlContextData::invalidateParentLookups();
     data->refreshExpressions();
 }
 
@@ -315,10 +316,11 @@ void QQmlContext::setContextProperty(const QString &name, const QVariant &value)
         }
     }
 
-    QV4::IdentifierHash<int> &properties = data->detachedPropertyNames();
-    int idx = properties.value(name);
+    // Only adding a name detaches the names, which invalidates the parent lookups
+    // cached by the child contexts.
+    int idx = data->propertyNames().value(name);
     if (idx == -1) {
-        properties.add(name, data->idValueCount + d->propertyValues.count());
+        data->detachedPropertyNames().add(name, data->idValueCount + d->propertyValues.count());
         d->propertyValues.append(value);
 
         data->refreshExpressions();
@@ -351,11 +353,10 @@ void QQmlContext::setContextProperty(const QString &name, QObject *value)
         return;
     }
 
-    QV4::IdentifierHash<int> &properties = data->detachedPropertyNames();
-    int idx = properties.value(name);
+    int idx = data->propertyNames().value(name);
 
     if (idx == -1) {
-        properties.add(name, data->idValueCount + d->propertyValues.count());
+        data->detachedPropertyNames().add(name, data->idValueCount + d->propertyValues.count());
         d->propertyValues.append(QVariant::fromValue(value));
 
         data->refreshExpressions();
@@ -837,11 +838,19 @@ const QV4::IdentifierHash<int> &QQmlContextData::propertyNames() const
 
 QV4::IdentifierHash<int> &QQmlContextData::detachedPropertyNames()
 {
+    invalidateParentLookups();
     propertyNames();
     propertyNameCache.detach();
     return propertyNameCache;
 }
 
+/*
+    Bumped whenever a context gains a property, a context object is replaced or a
+    dynamic meta object gains a property. Any of these may make a name resolve in a
+    closer context than before, so contexts drop their cached parent lookups.
+*/
+QBasicAtomicInt QQmlContextData::parentLookupGenerationCounter = Q_BASIC_ATOMIC_INITIALIZER(1);
+
 QUrl QQmlContextData::url() const
 {
     if (typeCompilationUnit)
@@ -162,6 +162,18 @@ public:
     const QV4::IdentifierHash<int> &propertyNames() const;
     QV4::IdentifierHash<int> &detachedPropertyNames();
 
+    // Names that expressions in this context resolved to an id or context property of
+    // a parent context, mapped to the parent's depth and property index. Valid while
+    // parentLookupGeneration matches currentParentLookupGeneration().
+    QV4::IdentifierHash<int> parentLookupCache;
+    int parentLookupGeneration = 0;
+    static int encodeParentLookup(int depth, int propertyIndex) { return (depth << 16) | propertyIndex; }
+    static bool canEncodeParentLookup(int depth, int propertyIndex) { return depth < 0x8000 && propertyIndex < 0x10000; }
+    static int parentLookupDepth(int encoded) { return encoded >> 16; }
+    static int parentLookupIndex(int encoded) { return encoded & 0xffff; }
+    static int currentParentLookupGeneration() { return parentLookupGenerationCounter.load(); }
+    static void invalidateParentLookups() { parentLookupGenerationCounter.ref(); }
+
     // Context object
     QObject *contextObject;
 
@@ -226,6 +238,7 @@ public:
 private:
     friend class QQmlContextDataRef;
     friend class QQmlContext; // needs to do manual refcounting :/
+    static QBasicAtomicInt parentLookupGenerationCounter;
     void refreshExpressionsRecursive(bool isGlobal);
     void refreshExpressionsRecursive(QQmlJavaScriptExpression *);
     ~QQmlContextData();
@@ -0,0 +1,243 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmlcreationarena_p.h"
+
+#include <private/qqmlglobal_p.h>
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(disableCreationArena, QML_DISABLE_CREATION_ARENA)
+DEFINE_BOOL_CONFIG_OPTION(creationArenaStatistics, QML_CREATION_ARENA_STATISTICS)
+
+namespace {
+
+// Precedes every allocation while arenas are in use, so that deallocate() knows where
+// the memory came from
+union AllocationHeader {
+    QQmlCreationArena *arena;
+    double forAlignment1;
+    qint64 forAlignment2;
+};
+
+enum {
+    MinimumChunkSize = 2048,
+    MaximumChunkSize = 32768
+};
+
+inline size_t alignedSize(size_t size)
+{
+    const size_t alignment = sizeof(AllocationHeader);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Whether arenas are used in this process is decided once. Without them, heap
+// allocations do not need a header to tell them apart and are plain malloc() blocks.
+inline bool hasAllocationHeaders()
+{
+    return !disableCreationArena();
+}
+
+// The counters cost an atomic increment per allocation, so they are only kept on request.
+bool statisticsEnabled = false;
+QBasicAtomicInt arenaCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+QBasicAtomicInt chunkCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+QBasicAtomicInt arenaAllocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+QBasicAtomicInt heapAllocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+#define QQML_CREATION_ARENA_COUNT(counter) \
+    do { if (Q_UNLIKELY(statisticsEnabled || creationArenaStatistics())) counter.ref(); } while (false)
+
+}
+
+struct QQmlCreationArena::Chunk
+{
+    Chunk *next;
+};
+
+/*!
+\class QQmlCreationArena
+\brief The QQmlCreationArena class allocates the engine side structures of one component instance in bulk.
+\internal
+
+The top level QQmlObjectCreator owns an arena for as long as it runs, and
+places the bindings, bound signals and signal expressions it creates in it.
+Each allocation holds a reference to the arena. The chunks
+are freed together when the creator has released the arena and the last
+allocation has been deallocated, which usually happens when the root object
+of the instance is destroyed.
+
+Memory of structures deleted earlier is not reused. Structures created after
+the creator finished, for example by state changes, are allocated on the heap.
+These carry the same header as arena allocations, unless arenas are disabled
+with QML_DISABLE_CREATION_ARENA.
+
+A single allocation that outlives the instance keeps all chunks of its arena
+alive. Only structures that are owned by the objects of the instance are
+therefore placed in the arena. Contexts are not: JavaScript functions,
+components and QQmlContext handles can keep them alive for an arbitrary time,
+so QQmlObjectCreator allocates them on the heap.
+
+Set QML_CREATION_ARENA_STATISTICS, or call setStatisticsEnabled(), to count
+the arenas, chunks and allocations made in the process.
+*/
+
+QQmlCreationArena::QQmlCreationArena()
+    : m_chunks(0), m_next(0), m_end(0), m_nextChunkSize(MinimumChunkSize), m_refCount(1)
+{
+}
+
+QQmlCreationArena::~QQmlCreationArena()
+{
+    while (m_chunks) {
+        Chunk *next = m_chunks->next;
+        ::free(m_chunks);
+        m_chunks = next;
+    }
+}
+
+QQmlCreationArena *QQmlCreationArena::create()
+{
+    if (disableCreationArena())
+        return 0;
+    QQML_CREATION_ARENA_COUNT(arenaCount);
+    return new QQmlCreationArena;
+}
+
+/*!
+Drops the reference of the creator. No allocations must be made afterwards.
+*/
+void QQmlCreationArena::release()
+{
+    deref();
+}
+
+void QQmlCreationArena::deref()
+{
+    if (!m_refCount.deref())
+        delete this;
+}
+
+void *QQmlCreationArena::allocateFromChunk(size_t size)
+{
+    size = alignedSize(size);
+    const size_t chunkHeaderSize = alignedSize(sizeof(Chunk));
+
+    if (size > size_t(m_end - m_next)) {
+        const size_t chunkSize = qMax(m_nextChunkSize, chunkHeaderSize + size);
+        Chunk *chunk = static_cast<Chunk *>(::malloc(chunkSize));
+        Q_CHECK_PTR(chunk);
+        chunk->next = m_chunks;
+        m_chunks = chunk;
+        m_next = reinterpret_cast<char *>(chunk) + chunkHeaderSize;
+        m_end = reinterpret_cast<char *>(chunk) + chunkSize;
+        m_nextChunkSize = qMin(m_nextChunkSize * 2, size_t(MaximumChunkSize));
+        QQML_CREATION_ARENA_COUNT(chunkCount);
+    }
+
+    void *memory = m_next;
+    m_next += size;
+    return memory;
+}
+
+void *QQmlCreationArena::allocate(QQmlCreationArena *arena, size_t size)
+{
+    AllocationHeader *header;
+    if (arena) {
+        header = static_cast<AllocationHeader *>(arena->allocateFromChunk(sizeof(AllocationHeader) + size));
+        arena->m_refCount.ref();
+        QQML_CREATION_ARENA_COUNT(arenaAllocationCount);
+    } else {
+        QQML_CREATION_ARENA_COUNT(heapAllocationCount);
+        if (!hasAllocationHeaders()) {
+            void *memory = ::malloc(size);
+            Q_CHECK_PTR(memory);
+            return memory;
+        }
+        header = static_cast<AllocationHeader *>(::malloc(sizeof(AllocationHeader) + size));
+        Q_CHECK_PTR(header);
+    }
+    header->arena = arena;
+    return header + 1;
+}
+
+void QQmlCreationArena::deallocate(void *memory)
+{
+    if (!memory)
+        return;
+
+    if (!hasAllocationHeaders()) {
+        ::free(memory);
+        return;
+    }
+
+    AllocationHeader *header = static_cast<AllocationHeader *>(memory) - 1;
+    if (header->arena)
+        header->arena->deref();
+    else
+        ::free(header);
+}
+
+void QQmlCreationArena::setStatisticsEnabled(bool enabled)
+{
+    statisticsEnabled = enabled;
+}
+
+QQmlCreationArena::Statistics QQmlCreationArena::statistics()
+{
+    Statistics statistics;
+    statistics.arenas = arenaCount.load();
+    statistics.chunks = chunkCount.load();
+    statistics.arenaAllocations = arenaAllocationCount.load();
+    statistics.heapAllocations = heapAllocationCount.load();
+    return statistics;
+}
+
+void QQmlCreationArena::resetStatistics()
+{
+    arenaCount.store(0);
+    chunkCount.store(0);
+    arenaAllocationCount.store(0);
+    heapAllocationCount.store(0);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLCREATIONARENA_P_H
+#define QQMLCREATIONARENA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+#include <QtCore/qatomic.h>
+
+QT_BEGIN_NAMESPACE
+
+// Memory for the bindings and bound signals created by one
+// QQmlObjectCreator run. Allocations are carved out of a few large chunks,
+// and the chunks are freed together once the creator is done and the last
+// structure allocated from them has been deleted.
+class Q_QML_PRIVATE_EXPORT QQmlCreationArena
+{
+public:
+    struct Statistics {
+        Statistics() : arenas(0), chunks(0), arenaAllocations(0), heapAllocations(0) {}
+        int arenas;
+        int chunks;
+        int arenaAllocations;
+        int heapAllocations;
+    };
+
+    // Returns 0 if QML_DISABLE_CREATION_ARENA is set.
+    static QQmlCreationArena *create();
+    void release();
+
+    // Allocates from the arena, or from the heap if arena is 0. The memory
+    // must be freed with deallocate().
+    static void *allocate(QQmlCreationArena *arena, size_t size);
+    static void deallocate(void *memory);
+
+    // Process wide counts, for benchmarks. Only kept while enabled, or if
+    // QML_CREATION_ARENA_STATISTICS is set.
+    static void setStatisticsEnabled(bool enabled);
+    static Statistics statistics();
+    static void resetStatistics();
+
+private:
+    QQmlCreationArena();
+    ~QQmlCreationArena();
+
+    void *allocateFromChunk(size_t size);
+    void deref();
+
+    struct Chunk;
+    Chunk *m_chunks;
+    char *m_next;
+    char *m_end;
+    size_t m_nextChunkSize;
+    QAtomicInt m_refCount;
+};
+
+// Class specific allocation functions, so that "new (arena) T" places an
+// instance in a creation arena and "new T" keeps working as before.
+#define QQML_CREATION_ARENA_ALLOCATED \
+    static void *operator new(size_t size) \
+    { return QQmlCreationArena::allocate(0, size); } \
+    static void *operator new(size_t size, QQmlCreationArena *arena) \
+    { return QQmlCreationArena::allocate(arena, size); } \
+    static void operator delete(void *memory) \
+    { QQmlCreationArena::deallocate(memory); } \
+    static void operator delete(void *memory, QQmlCreationArena *) \
+    { QQmlCreationArena::deallocate(memory); }
+
+QT_END_NAMESPACE
+
+#endif // QQMLCREATIONARENA_P_H
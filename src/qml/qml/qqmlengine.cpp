@@ -60,6 +60,7 @@
 #include "qqmlincubator.h"
 #include "qqmlabstracturlinterceptor.h"
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlbinding_p.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qmetaobject.h>
@@ -664,7 +665,7 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
   profiler(0),
 #endif
   outputWarningsToMsgLog(true),
-  cleanup(0), erroredBindings(0), inProgressCreations(0),
+  cleanup(0), erroredBindings(0), inProgressCreations(0), bindingBatch(0),
   workerScriptEngine(0),
   activeObjectCreator(0),
 #if QT_CONFIG(qml_network)
@@ -1020,6 +1021,10 @@ QQmlEngine::~QQmlEngine()
 
     d->typeLoader.invalidate();
 
+    // Drop bindings still waiting for an unfinished batch.
+    delete d->bindingBatch;
+    d->bindingBatch = 0;
+
     // Emit onDestruction signals for the root context before
     // we destroy the contexts, engine, Singleton Types etc. that
     // may be required to handle the destruction signal.
@@ -1079,6 +1084,63 @@ void QQmlEngine::clearComponentCache()
     d->typeLoader.clearCache();
 }
 
+/*!
+  \since 5.10
+
+  Starts a batch of property changes. Until the matching endBindingBatch() call,
+  bindings affected by a property change are not evaluated immediately but marked
+  as dirty. When the outermost batch ends, every dirty binding is evaluated once,
+  after the bindings it depends on, so that intermediate values of a set of related
+  changes are not propagated and bindings with several changed dependencies do not
+  run several times.
+
+  The order is learned from the bindings that mark each other as dirty while
+  batches are flushed. Until it has settled, a binding that depends on a changed
+  property both directly and through a longer chain of bindings may still be
+  evaluated before the chain has been updated, and then once more afterwards.
+
+  Batches can be nested. Bindings are only evaluated when the outermost batch ends.
+
+  \sa endBindingBatch(), isBindingBatchActive()
+*/
+void QQmlEngine::beginBindingBatch()
+{
+    Q_D(QQmlEngine);
+    if (!d->bindingBatch)
+        d->bindingBatch = new QQmlBindingBatch;
+    ++d->bindingBatch->depth;
+}
+
+/*!
+  \since 5.10
+
+  Ends a batch started with beginBindingBatch(). If this ends the outermost batch,
+  the bindings that were marked as dirty in the meantime are evaluated.
+
+  \sa beginBindingBatch()
+*/
+void QQmlEngine::endBindingBatch()
+{
+    Q_D(QQmlEngine);
+    if (!d->bindingBatch || d->bindingBatch->depth == 0) {
+        qWarning("QQmlEngine::endBindingBatch: no batch is active");
+        return;
+    }
+    if (--d->bindingBatch->depth == 0)
+        d->bindingBatch->flush();
+}
+
+/*!
+  \since 5.10
+
+  Returns true if binding evaluation is currently being deferred by beginBindingBatch().
+*/
+bool QQmlEngine::isBindingBatchActive() const
+{
+    Q_D(const QQmlEngine);
+    return d->bindingBatch && d->bindingBatch->depth > 0;
+}
+
 /*!
   Trims the engine's internal component cache.
 
@@ -105,6 +105,10 @@ public:
     void clearComponentCache();
     void trimComponentCache();
 
+    void beginBindingBatch();
+    void endBindingBatch();
+    bool isBindingBatchActive() const;
+
     QStringList importPathList() const;
     void setImportPathList(const QStringList &paths);
     void addImportPath(const QString& dir);
@@ -95,6 +95,7 @@ class QQmlTypeNameCache;
 class QQmlComponentAttached;
 class QQmlCleanup;
 class QQmlDelayedError;
+class QQmlBindingBatch;
 class QQuickWorkerScriptEngine;
 class QQmlObjectCreator;
 class QDir;
@@ -150,6 +151,9 @@ public:
     QQmlDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // Bindings deferred by QQmlEngine::beginBindingBatch()
+    QQmlBindingBatch *bindingBatch;
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
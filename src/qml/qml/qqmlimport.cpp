@@ -54,6 +54,8 @@
 #include <private/qqmltypenamecache_p.h>
 #include <private/qqmlengine_p.h>
 #include <private/qfieldlist_p.h>
+#include <private/qqmlstartupmanifest_p.h>
+#include <private/qqmlimportresolutioncache_p.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
 
@@ -1214,6 +1216,30 @@ QString QQmlImportsPrivate::resolvedUri(const QString &dir_arg, QQmlImportDataba
     return stableRelativePath;
 }
 
+/*
+Returns \a path if it names an existing file, consulting the persistent import
+resolution cache for local paths before asking the type loader.
+*/
+static QString resolveImportFilePath(QQmlTypeLoader *typeLoader, const QString &path)
+{
+    QQmlImportResolutionCache *cache = QQmlImportResolutionCache::instance();
+    if (!cache || path.isEmpty() || path.at(0) == Colon || path.startsWith(QLatin1String("qrc:"), Qt::CaseInsensitive))
+        return typeLoader->absoluteFilePath(path);
+
+    switch (cache->lookupFile(path)) {
+    case QQmlImportResolutionCache::Present:
+        return path;
+    case QQmlImportResolutionCache::Missing:
+        return QString();
+    case QQmlImportResolutionCache::Unknown:
+        break;
+    }
+
+    const QString absoluteFilePath = typeLoader->absoluteFilePath(path);
+    cache->recordFile(path, !absoluteFilePath.isEmpty());
+    return absoluteFilePath;
+}
+
 /*
 Locates the qmldir file for \a uri version \a vmaj.vmin.  Returns true if found,
 and fills in outQmldirFilePath and outQmldirUrl appropriately.  Otherwise returns
@@ -1250,7 +1276,7 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
     // Search local import paths for a matching version
     const QStringList qmlDirPaths = QQmlImports::completeQmldirPaths(uri, localImportPaths, vmaj, vmin);
     for (const QString &qmldirPath : qmlDirPaths) {
-        QString absoluteFilePath = typeLoader.absoluteFilePath(qmldirPath);
+        QString absoluteFilePath = resolveImportFilePath(&typeLoader, qmldirPath);
         if (!absoluteFilePath.isEmpty()) {
             QString url;
             const QStringRef absolutePath = absoluteFilePath.leftRef(absoluteFilePath.lastIndexOf(Slash) + 1);
@@ -1756,7 +1782,7 @@ QString QQmlImportDatabase::resolvePlugin(QQmlTypeLoader *typeLoader,
 
         resolvedPath += prefix + baseName;
         for (const QString &suffix : suffixes) {
-            const QString absolutePath = typeLoader->absoluteFilePath(resolvedPath + suffix);
+            const QString absolutePath = resolveImportFilePath(typeLoader, resolvedPath + suffix);
             if (!absolutePath.isEmpty())
                 return absolutePath;
         }
@@ -1944,9 +1970,9 @@ bool QQmlImportDatabase::registerPluginTypes(QObject *instance, const QString &b
 
     QStringList registrationFailures;
     {
-        // Create a scope for QWriteLocker to keep it as narrow as possible, and
+        // Create a scope for the locker to keep it as narrow as possible, and
         // to ensure that we release it before the call to initalizeEngine below
-        QMutexLocker lock(QQmlMetaType::typeRegistrationLock());
+        QQmlTypeRegistrationLocker lock;
 
         if (!typeNamespace.isEmpty()) {
             // This is an 'identified' module
@@ -1987,7 +2013,7 @@ bool QQmlImportDatabase::registerPluginTypes(QObject *instance, const QString &b
 
         registrationFailures = QQmlMetaType::typeRegistrationFailures();
         QQmlMetaType::setTypeRegistrationNamespace(QString());
-    } // QWriteLocker lock(QQmlMetaType::typeRegistrationLock())
+    } // QQmlTypeRegistrationLocker lock
 
     if (!registrationFailures.isEmpty()) {
         if (errors) {
@@ -2090,6 +2116,7 @@ bool QQmlImportDatabase::importDynamicPlugin(const QString &filePath, const QStr
                 delete loader;
                 return false;
             }
+            QQmlStartupManifest::record(QQmlStartupManifest::Plugin, absoluteFilePath);
         } else {
             loader = plugins->value(absoluteFilePath).loader;
         }
@@ -0,0 +1,473 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmlimportresolutioncache_p.h"
+#include "qqmlimportresolutioncacheformat_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+\class QQmlImportResolutionCache
+\brief The QQmlImportResolutionCache class persists the results of import path lookups.
+\internal
+
+Resolving a module import probes a list of candidate qmldir locations in every import
+path, and resolving a plugin probes a list of candidate library names. Most of these
+candidates do not exist, and on slow storage the probing, together with reading the
+qmldir files, takes a noticeable part of the startup time.
+
+The cache stores for every probed file whether it existed. A file that existed is
+trusted as long as its modification time is unchanged; a file that did not exist is
+trusted as long as the deepest directory on its path that did exist keeps its
+modification time, as creating the file or any missing directory in between modifies
+that directory. The contents of qmldir files are kept along with their entries.
+
+Candidates that are not in the cache, for example because the application was started
+with additional import paths, are probed as usual and added to the cache, which is
+written back when the application exits. The file format is a JSON object so that
+qmlimportscanner can produce it ahead of time.
+
+Modification times taken at build time are meaningless on the device the application
+is deployed to, so qmlimportscanner records its results relative to each import path
+instead, together with the listings of the directories they depend on: every directory
+from the import path down to the file, or down to the deepest one that exists. A file
+that is not in the cache by its absolute path is looked up there. The recorded result
+is only used if all of those directories have exactly the recorded listing on the
+device, which proves that the file exists or is missing there. It is then added to the
+cache with the modification times found on the device. The contents of qmldir files
+are not taken from qmlimportscanner, as a listing says nothing about them; they are
+cached once the application has read them.
+*/
+
+using namespace QQmlImportResolutionCacheFormat;
+
+namespace {
+
+class GlobalImportResolutionCache : public QQmlImportResolutionCache
+{
+public:
+    GlobalImportResolutionCache();
+};
+
+}
+
+Q_GLOBAL_STATIC(GlobalImportResolutionCache, importResolutionCache)
+
+static void saveImportResolutionCache()
+{
+    if (importResolutionCache.exists())
+        importResolutionCache()->save();
+}
+
+GlobalImportResolutionCache::GlobalImportResolutionCache()
+    : QQmlImportResolutionCache(QString::fromLocal8Bit(qgetenv("QML_IMPORT_CACHE")))
+{
+    qAddPostRoutine(saveImportResolutionCache);
+}
+
+QQmlImportResolutionCache::QQmlImportResolutionCache(const QString &cacheFilePath)
+    : m_cacheFilePath(cacheFilePath)
+    , m_dirty(false)
+{
+    if (!m_cacheFilePath.isEmpty())
+        load();
+}
+
+/*!
+Returns the process wide cache, or null if QML_IMPORT_CACHE is not set.
+*/
+QQmlImportResolutionCache *QQmlImportResolutionCache::instance()
+{
+    static const bool enabled = qEnvironmentVariableIsSet("QML_IMPORT_CACHE");
+    return enabled ? importResolutionCache() : 0;
+}
+
+/*!
+Returns the modification time of \a path in milliseconds since the epoch, or -1 if it
+does not exist.
+*/
+qint64 QQmlImportResolutionCache::lastModified(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return -1;
+    const QDateTime modified = info.lastModified();
+    return modified.isValid() ? modified.toMSecsSinceEpoch() : 0;
+}
+
+/*!
+Returns the deepest existing directory on the path to \a filePath, or an empty string
+if there is none.
+*/
+QString QQmlImportResolutionCache::existingAncestor(const QString &filePath)
+{
+    QString directory = filePath;
+    for (;;) {
+        const int slash = directory.lastIndexOf(QLatin1Char('/'));
+        if (slash < 0)
+            return QString();
+        directory.truncate(slash > 0 ? slash : 1);
+        if (QFileInfo(directory).isDir())
+            return directory;
+        if (slash == 0)
+            return QString();
+    }
+}
+
+/*!
+Returns the names in \a directory, sorted, as recorded for import paths by
+qmlimportscanner.
+*/
+QStringList QQmlImportResolutionCache::directoryEntries(const QString &directory)
+{
+    return QDir(directory).entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+                                     QDir::Name);
+}
+
+bool QQmlImportResolutionCache::load()
+{
+    QFile file(m_cacheFilePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value(versionKey()).toInt() != Version)
+        return false;
+
+    const QJsonObject directories = root.value(directoriesKey()).toObject();
+    for (auto it = directories.constBegin(), end = directories.constEnd(); it != end; ++it)
+        m_directories.insert(it.key(), qint64(it.value().toDouble()));
+
+    const QJsonObject missing = root.value(missingKey()).toObject();
+    for (auto it = missing.constBegin(), end = missing.constEnd(); it != end; ++it) {
+        const QString ancestor = it.value().toString();
+        if (m_directories.contains(ancestor))
+            m_missing.insert(it.key(), ancestor);
+    }
+
+    const QJsonObject files = root.value(filesKey()).toObject();
+    for (auto it = files.constBegin(), end = files.constEnd(); it != end; ++it) {
+        const QJsonObject entry = it.value().toObject();
+        File cached;
+        cached.modified = qint64(entry.value(modifiedKey()).toDouble());
+        const QJsonValue content = entry.value(contentKey());
+        if (content.isString()) {
+            cached.hasContent = true;
+            cached.content = content.toString();
+        }
+        m_files.insert(it.key(), cached);
+    }
+
+    const QJsonArray importPaths = root.value(importPathsKey()).toArray();
+    for (const QJsonValue &value : importPaths) {
+        const QJsonObject entry = value.toObject();
+        ImportPath importPath;
+        const QJsonObject directories = entry.value(directoriesKey()).toObject();
+        for (auto it = directories.constBegin(), end = directories.constEnd(); it != end; ++it) {
+            QStringList &names = importPath.directories[it.key()];
+            for (const QJsonValue &name : it.value().toArray())
+                names += name.toString();
+        }
+        for (const QJsonValue &relativePath : entry.value(missingKey()).toArray())
+            importPath.missing.insert(relativePath.toString());
+        for (const QJsonValue &relativePath : entry.value(filesKey()).toArray())
+            importPath.files.insert(relativePath.toString());
+        m_importPaths += importPath;
+    }
+
+    return true;
+}
+
+bool QQmlImportResolutionCache::isDirectoryUnchanged(const QString &directory)
+{
+    auto checked = m_checkedDirectories.constFind(directory);
+    if (checked != m_checkedDirectories.constEnd())
+        return *checked;
+
+    const qint64 recorded = m_directories.value(directory, -1);
+    const bool unchanged = recorded >= 0 && QFileInfo(directory).isDir() && lastModified(directory) == recorded;
+    m_checkedDirectories.insert(directory, unchanged);
+
+    if (!unchanged) {
+        // Everything that was missing below this directory may exist now.
+        m_directories.remove(directory);
+        for (auto it = m_missing.begin(); it != m_missing.end(); ) {
+            if (*it == directory)
+                it = m_missing.erase(it);
+            else
+                ++it;
+        }
+        m_dirty = true;
+    }
+    return unchanged;
+}
+
+bool QQmlImportResolutionCache::isFileUnchanged(const QString &filePath)
+{
+    auto checked = m_checkedFiles.constFind(filePath);
+    if (checked != m_checkedFiles.constEnd())
+        return *checked;
+
+    const bool unchanged = lastModified(filePath) == m_files.value(filePath).modified;
+    m_checkedFiles.insert(filePath, unchanged);
+    if (!unchanged) {
+        m_files.remove(filePath);
+        m_dirty = true;
+    }
+    return unchanged;
+}
+
+const QStringList &QQmlImportResolutionCache::cachedDirectoryEntries(const QString &directory)
+{
+    auto it = m_directoryEntries.find(directory);
+    if (it == m_directoryEntries.end())
+        it = m_directoryEntries.insert(directory, directoryEntries(directory));
+    return *it;
+}
+
+/*!
+Returns whether the listings recorded in \a importPath for the directories between
+\a root and \a relativePath match the device, and show that the file exists or is
+missing as given by \a exists.
+*/
+bool QQmlImportResolutionCache::matchesImportPath(const ImportPath &importPath, const QString &root,
+                                                  const QString &relativePath, bool exists)
+{
+    const QVector<QStringRef> names = relativePath.splitRef(QLatin1Char('/'));
+    QString relativeDirectory;
+    for (int i = 0; i < names.count(); ++i) {
+        auto recorded = importPath.directories.constFind(relativeDirectory);
+        if (recorded == importPath.directories.constEnd())
+            return false;
+        QString directory = root;
+        if (!relativeDirectory.isEmpty()) {
+            if (!directory.endsWith(QLatin1Char('/')))
+                directory += QLatin1Char('/');
+            directory += relativeDirectory;
+        }
+        if (cachedDirectoryEntries(directory) != *recorded)
+            return false;
+
+        const QString name = names.at(i).toString();
+        if (!recorded->contains(name))
+            return !exists;
+        if (i == names.count() - 1)
+            return exists;
+        if (!relativeDirectory.isEmpty())
+            relativeDirectory += QLatin1Char('/');
+        relativeDirectory += name;
+    }
+    return false;
+}
+
+/*!
+Looks \a filePath up in the results recorded relative to import paths.
+*/
+QQmlImportResolutionCache::Lookup QQmlImportResolutionCache::lookupImportPaths(const QString &filePath)
+{
+    if (m_importPaths.isEmpty())
+        return Unknown;
+
+    for (int slash = filePath.indexOf(QLatin1Char('/')); slash >= 0;
+         slash = filePath.indexOf(QLatin1Char('/'), slash + 1)) {
+        const QString relativePath = filePath.mid(slash + 1);
+        const QString root = slash > 0 ? filePath.left(slash) : QStringLiteral("/");
+        for (const ImportPath &importPath : qAsConst(m_importPaths)) {
+            const bool exists = importPath.files.contains(relativePath);
+            if (!exists && !importPath.missing.contains(relativePath))
+                continue;
+            if (matchesImportPath(importPath, root, relativePath, exists))
+                return exists ? Present : Missing;
+        }
+    }
+    return Unknown;
+}
+
+QQmlImportResolutionCache::File &QQmlImportResolutionCache::insertFile(const QString &filePath)
+{
+    m_missing.remove(filePath);
+    File &cached = m_files[filePath];
+    cached.modified = lastModified(filePath);
+    m_checkedFiles.insert(filePath, true);
+    m_dirty = true;
+    return cached;
+}
+
+void QQmlImportResolutionCache::insertMissing(const QString &filePath)
+{
+    const QString ancestor = existingAncestor(filePath);
+    if (ancestor.isEmpty())
+        return;
+    m_files.remove(filePath);
+    m_missing.insert(filePath, ancestor);
+    if (!m_checkedDirectories.value(ancestor)) {
+        m_directories.insert(ancestor, lastModified(ancestor));
+        m_checkedDirectories.insert(ancestor, true);
+    }
+    m_dirty = true;
+}
+
+/*!
+Returns whether \a filePath is known to exist or to be missing. Returns Unknown if
+it was never recorded or the recorded state can no longer be trusted.
+*/
+QQmlImportResolutionCache::Lookup QQmlImportResolutionCache::lookupFile(const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_files.contains(filePath))
+        return isFileUnchanged(filePath) ? Present : Unknown;
+
+    auto missing = m_missing.constFind(filePath);
+    if (missing != m_missing.constEnd())
+        return isDirectoryUnchanged(*missing) ? Missing : Unknown;
+
+    // The listings have just shown the state of the file, so the modification times
+    // found now can be recorded.
+    const Lookup lookup = lookupImportPaths(filePath);
+    if (lookup == Present)
+        insertFile(filePath);
+    else if (lookup == Missing)
+        insertMissing(filePath);
+    return lookup;
+}
+
+void QQmlImportResolutionCache::recordFile(const QString &filePath, bool exists)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (exists)
+        insertFile(filePath);
+    else
+        insertMissing(filePath);
+}
+
+/*!
+Sets \a content to the cached contents of the qmldir file \a filePath and returns true,
+if they are known and the file did not change since.
+*/
+bool QQmlImportResolutionCache::qmldirContent(const QString &filePath, QString *content)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto cached = m_files.constFind(filePath);
+    if (cached == m_files.constEnd() || !cached->hasContent || !isFileUnchanged(filePath))
+        return false;
+    *content = m_files.value(filePath).content;
+    return true;
+}
+
+void QQmlImportResolutionCache::recordQmldirContent(const QString &filePath, const QString &content)
+{
+    QMutexLocker locker(&m_mutex);
+
+    File &cached = insertFile(filePath);
+    cached.hasContent = true;
+    cached.content = content;
+}
+
+/*!
+Writes the cache back to its file if anything was added or invalidated.
+*/
+bool QQmlImportResolutionCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_dirty || m_cacheFilePath.isEmpty())
+        return true;
+
+    QJsonObject directories;
+    for (auto it = m_directories.constBegin(), end = m_directories.constEnd(); it != end; ++it)
+        directories.insert(it.key(), double(it.value()));
+
+    QJsonObject missing;
+    for (auto it = m_missing.constBegin(), end = m_missing.constEnd(); it != end; ++it)
+        missing.insert(it.key(), it.value());
+
+    QJsonObject files;
+    for (auto it = m_files.constBegin(), end = m_files.constEnd(); it != end; ++it) {
+        QJsonObject entry;
+        entry.insert(modifiedKey(), double(it->modified));
+        if (it->hasContent)
+            entry.insert(contentKey(), it->content);
+        files.insert(it.key(), entry);
+    }
+
+    QJsonArray importPaths;
+    for (const ImportPath &importPath : qAsConst(m_importPaths)) {
+        QJsonObject seededDirectories;
+        for (auto it = importPath.directories.constBegin(), end = importPath.directories.constEnd(); it != end; ++it)
+            seededDirectories.insert(it.key(), QJsonArray::fromStringList(it.value()));
+        QJsonObject entry;
+        entry.insert(directoriesKey(), seededDirectories);
+        entry.insert(missingKey(), QJsonArray::fromStringList(importPath.missing.toList()));
+        entry.insert(filesKey(), QJsonArray::fromStringList(importPath.files.toList()));
+        importPaths.append(entry);
+    }
+
+    QJsonObject root;
+    root.insert(versionKey(), int(Version));
+    root.insert(directoriesKey(), directories);
+    root.insert(missingKey(), missing);
+    root.insert(filesKey(), files);
+    root.insert(importPathsKey(), importPaths);
+
+    QSaveFile file(m_cacheFilePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+        return false;
+
+    m_dirty = false;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLIMPORTRESOLUTIONCACHE_P_H
+#define QQMLIMPORTRESOLUTIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonObject;
+
+// Remembers across process starts which qmldir and plugin candidates exist in the
+// import paths, and the contents of the qmldir files found there. Missing candidates
+// are validated by the modification time of their deepest existing ancestor directory,
+// existing files by their own modification time. Enabled by QML_IMPORT_CACHE=<file>;
+// the file can also be generated at build time by qmlimportscanner -importCache, which
+// records paths relative to import paths, validated by directory listings instead.
+class Q_QML_PRIVATE_EXPORT QQmlImportResolutionCache
+{
+public:
+    enum Lookup {
+        Unknown,
+        Missing,
+        Present
+    };
+
+    QQmlImportResolutionCache(const QString &cacheFilePath = QString());
+
+    static QQmlImportResolutionCache *instance();
+
+    QString cacheFilePath() const { return m_cacheFilePath; }
+
+    Lookup lookupFile(const QString &filePath);
+    void recordFile(const QString &filePath, bool exists);
+
+    bool qmldirContent(const QString &filePath, QString *content);
+    void recordQmldirContent(const QString &filePath, const QString &content);
+
+    bool isDirty() const { return m_dirty; }
+    bool save();
+
+    static qint64 lastModified(const QString &path);
+    static QString existingAncestor(const QString &filePath);
+    static QStringList directoryEntries(const QString &directory);
+
+private:
+    struct File {
+        File() : modified(0), hasContent(false) {}
+        qint64 modified;
+        bool hasContent;
+        QString content;
+    };
+
+    struct ImportPath {
+        QHash<QString, QStringList> directories;
+        QSet<QString> missing;
+        QSet<QString> files;
+    };
+
+    bool load();
+    bool isDirectoryUnchanged(const QString &directory);
+    bool isFileUnchanged(const QString &filePath);
+    const QStringList &cachedDirectoryEntries(const QString &directory);
+    bool matchesImportPath(const ImportPath &importPath, const QString &root,
+                           const QString &relativePath, bool exists);
+    Lookup lookupImportPaths(const QString &filePath);
+    File &insertFile(const QString &filePath);
+    void insertMissing(const QString &filePath);
+
+    QString m_cacheFilePath;
+    QMutex m_mutex;
+    bool m_dirty;
+
+    QHash<QString, qint64> m_directories;
+    QHash<QString, QString> m_missing;
+    QHash<QString, File> m_files;
+
+    // Lookups relative to an import path, as generated by qmlimportscanner.
+    QVector<ImportPath> m_importPaths;
+
+    // Results of validating the recorded modification times, once per process.
+    QHash<QString, bool> m_checkedDirectories;
+    QHash<QString, bool> m_checkedFiles;
+    QHash<QString, QStringList> m_directoryEntries;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLIMPORTRESOLUTIONCACHE_P_H
@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLIMPORTRESOLUTIONCACHEFORMAT_P_H
+#define QQMLIMPORTRESOLUTIONCACHEFORMAT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+// The keys of the JSON file read and written by QQmlImportResolutionCache, shared with
+// qmlimportscanner, which generates the importPaths part of it at build time:
+//
+// {
+//     "version": 2,
+//     "directories": { "<absolute directory>": <modified> },
+//     "missing": { "<absolute file>": "<deepest existing directory>" },
+//     "files": { "<absolute file>": { "modified": <modified>, "content": "<qmldir>" } },
+//     "importPaths": [ {
+//         "directories": { "<directory relative to the import path>": [ "<name>", ... ] },
+//         "missing": [ "<file relative to the import path>", ... ],
+//         "files": [ "<file relative to the import path>", ... ]
+//     } ]
+// }
+//
+// The importPaths entries carry no modification times, which would not be valid on the
+// target. Instead they list every directory between the import path ("") and the files,
+// down to the deepest one that exists; a result is used on the target when all of those
+// directories hold exactly the listed names there.
+namespace QQmlImportResolutionCacheFormat {
+
+enum { Version = 3 };
+
+inline QString versionKey()     { return QStringLiteral("version"); }
+inline QString directoriesKey() { return QStringLiteral("directories"); }
+inline QString missingKey()     { return QStringLiteral("missing"); }
+inline QString filesKey()       { return QStringLiteral("files"); }
+inline QString modifiedKey()    { return QStringLiteral("modified"); }
+inline QString contentKey()     { return QStringLiteral("content"); }
+inline QString importPathsKey() { return QStringLiteral("importPaths"); }
+
+}
+
+QT_END_NAMESPACE
+
+#endif // QQMLIMPORTRESOLUTIONCACHEFORMAT_P_H
@@ -49,6 +49,8 @@
 #include <private/qqmlglobal_p.h>
 #include <private/qv4qobjectwrapper_p.h>
 #include <private/qqmlbuiltinfunctions_p.h>
+#include <private/qqmltypedbinding_p.h>
+#include <private/qv4qmlcontext_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -253,25 +255,141 @@ void QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, bool *isUndefin
     ep->propertyCapture = lastPropertyCapture;
 }
 
+// Evaluates the typed form of the function, see QQmlTypedBinding. Returns false if there is none
+// or it cannot compute the value, in which case evaluate() has to call the function instead.
+bool QQmlJavaScriptExpression::evaluateTyped(double *result)
+{
+    Q_ASSERT(m_context && m_context->engine);
+
+    QV4::Function *v4Function = function();
+    if (!v4Function || !v4Function->compiledFunction->hasTypedBinding() || !QQmlTypedBinding::isEnabled())
+        return false;
+
+    const QV4::QmlContext *qmlScope = m_qmlScope.as<QV4::QmlContext>();
+    if (!qmlScope)
+        return false;
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(m_context->engine);
+
+    DeleteWatcher watcher(this);
+
+    Q_ASSERT(notifyOnValueChanged() || activeGuards.isEmpty());
+    QQmlPropertyCapture capture(m_context->engine, this, &watcher);
+
+    QQmlPropertyCapture *lastPropertyCapture = ep->propertyCapture;
+    ep->propertyCapture = notifyOnValueChanged() ? &capture : 0;
+
+    if (notifyOnValueChanged())
+        capture.guards.copyAndClearPrepend(activeGuards);
+
+    // The properties of the scope and context object that the function reads are
+    // permanent dependencies once it ran.
+    const bool evaluated = QQmlTypedBinding::evaluate(ep->v4engine(), v4Function,
+                                                      qmlScope->qmlContext(), qmlScope->qmlScope(),
+                                                      ep->propertyCapture,
+                                                      !m_permanentDependenciesRegistered, result);
+
+    if (evaluated || watcher.wasDeleted()) {
+        if (evaluated && !watcher.wasDeleted() && hasDelayedError())
+            delayedError()->clearError();
+
+        while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
+            g->Delete();
+    } else {
+        // Hand the guards of the previous evaluation that were not captured again over
+        // to the function, so that it can still reuse them. Prepending one by one
+        // reverses them, so go through a temporary list to keep the order evaluate()
+        // sees the same as without the typed attempt.
+        QForwardFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next> reversed;
+        while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
+            reversed.prepend(g);
+        while (QQmlJavaScriptExpressionGuard *g = reversed.takeFirst())
+            activeGuards.prepend(g);
+    }
+
+    ep->propertyCapture = lastPropertyCapture;
+
+    return evaluated || watcher.wasDeleted();
+}
+
+namespace {
+
+struct NotifierMatch
+{
+    QQmlNotifier *notifier;
+    bool operator()(const QQmlJavaScriptExpressionGuard *g) const { return g->isConnected(notifier); }
+};
+
+struct SignalMatch
+{
+    QObject *object;
+    int signalIndex;
+    bool operator()(const QQmlJavaScriptExpressionGuard *g) const { return g->isConnected(object, signalIndex); }
+};
+
+}
+
+/*! \internal
+
+    Moves the guard of the previous evaluation that is connected to the same notifier as \a match
+    to the expression, and returns true. Also returns true, without doing anything, if this
+    evaluation already captured the same notifier. Returns false if a new guard is needed.
+
+    Most expressions capture the same dependencies in the same order on every evaluation, so the
+    first remaining guard usually matches. If it does not, for example because a condition in the
+    expression changed, the next few guards are searched as well before giving up; unmatched
+    guards are deleted at the end of the evaluation.
+*/
+template<typename Match>
+bool QQmlPropertyCapture::reuseGuard(const Match &match, Duration duration)
+{
+    static const int lookahead = 4;
+
+    QQmlJavaScriptExpressionGuard *g = guards.first();
+    if (g && match(g)) {
+        guards.takeFirst();
+    } else {
+        g = 0;
+        int scanned = 0;
+        for (QQmlJavaScriptExpressionGuard *prev = guards.first(); prev && scanned < lookahead;
+             prev = guards.next(prev), ++scanned) {
+            QQmlJavaScriptExpressionGuard *candidate = guards.next(prev);
+            if (candidate && match(candidate)) {
+                g = guards.takeAfter(prev);
+                break;
+            }
+        }
+    }
+
+    auto &captured = (duration == Permanently) ? expression->permanentGuards : expression->activeGuards;
+    if (!g) {
+        // The same property read twice in one evaluation needs only one guard.
+        int scanned = 0;
+        for (QQmlJavaScriptExpressionGuard *it = captured.first(); it && scanned < lookahead;
+             it = captured.next(it), ++scanned) {
+            if (match(it))
+                return true;
+        }
+        return false;
+    }
+
+    g->cancelNotify();
+    captured.prepend(g);
+    return true;
+}
+
 void QQmlPropertyCapture::captureProperty(QQmlNotifier *n, Duration duration)
 {
     if (watcher->wasDeleted())
         return;
 
     Q_ASSERT(expression);
-    // Try and find a matching guard
-    while (!guards.isEmpty() && !guards.first()->isConnected(n))
-        guards.takeFirst()->Delete();
-
-    QQmlJavaScriptExpressionGuard *g = 0;
-    if (!guards.isEmpty()) {
-        g = guards.takeFirst();
-        g->cancelNotify();
-        Q_ASSERT(g->isConnected(n));
-    } else {
-        g = QQmlJavaScriptExpressionGuard::New(expression, engine);
-        g->connect(n);
-    }
+    const NotifierMatch match = { n };
+    if (reuseGuard(match, duration))
+        return;
+
+    QQmlJavaScriptExpressionGuard *g = QQmlJavaScriptExpressionGuard::New(expression, engine);
+    g->connect(n);
 
     if (duration == Permanently)
         expression->permanentGuards.prepend(g);
@@ -308,19 +426,12 @@ void QQmlPropertyCapture::captureProperty(QObject *o, int c, int n, Duration dur
         errorString->append(error);
     } else {
 
-        // Try and find a matching guard
-        while (!guards.isEmpty() && !guards.first()->isConnected(o, n))
-            guards.takeFirst()->Delete();
-
-        QQmlJavaScriptExpressionGuard *g = 0;
-        if (!guards.isEmpty()) {
-            g = guards.takeFirst();
-            g->cancelNotify();
-            Q_ASSERT(g->isConnected(o, n));
-        } else {
-            g = QQmlJavaScriptExpressionGuard::New(expression, engine);
-            g->connect(o, n, engine, doNotify);
-        }
+        const SignalMatch match = { o, n };
+        if (reuseGuard(match, duration))
+            return;
+
+        QQmlJavaScriptExpressionGuard *g = QQmlJavaScriptExpressionGuard::New(expression, engine);
+        g->connect(o, n, engine, doNotify);
 
         if (duration == Permanently)
             expression->permanentGuards.prepend(g);
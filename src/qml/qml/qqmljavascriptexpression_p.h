@@ -58,6 +58,7 @@
 QT_BEGIN_NAMESPACE
 
 struct QQmlSourceLocation;
+class QQmlBinding;
 
 class QQmlDelayedError
 {
@@ -102,8 +103,10 @@ public:
 
     virtual QString expressionIdentifier() const = 0;
     virtual void expressionChanged() = 0;
+    virtual QQmlBinding *asBinding() { return 0; }
 
     void evaluate(QV4::CallData *callData, bool *isUndefined, QV4::Scope &scope);
+    bool evaluateTyped(double *result);
 
     inline bool notifyOnValueChanged() const;
 
@@ -211,6 +214,10 @@ public:
     QQmlJavaScriptExpression::DeleteWatcher *watcher;
     QFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next> guards;
     QStringList *errorString;
+
+private:
+    template<typename Match>
+    bool reuseGuard(const Match &match, Duration duration);
 };
 
 QQmlJavaScriptExpression::DeleteWatcher::DeleteWatcher(QQmlJavaScriptExpression *e)
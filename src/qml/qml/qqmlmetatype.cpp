@@ -50,6 +50,7 @@
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qbitarray.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qthreadstorage.h>
 #include <QtCore/private/qmetaobject_p.h>
 
 #include <qmetatype.h>
@@ -142,7 +143,123 @@ public:
 };
 
 Q_GLOBAL_STATIC(QQmlMetaTypeData, metaTypeData)
-Q_GLOBAL_STATIC_WITH_ARGS(QMutex, metaTypeDataLock, (QMutex::Recursive))
+
+/*
+    Guards QQmlMetaTypeData. Type lookups vastly outnumber registrations, so lookups
+    share the lock while registrations and cache insertions take it exclusively.
+
+    The underlying QReadWriteLock is not recursive, which keeps uncontended and
+    concurrent reads on its atomic fast path. Recursion is tracked per thread
+    instead: a thread that already holds the lock does not lock again, and a thread
+    holding a read lock that needs to write releases its shared lock for the
+    duration of the write. Read sections must therefore not hold iterators into the
+    data across calls that may register types.
+*/
+class QQmlMetaTypeDataLock
+{
+public:
+    void lockForRead()
+    {
+        LockState &state = lockState.localData();
+        if (state.readDepth++ || state.writeDepth)
+            return;
+        lock.lockForRead();
+    }
+
+    void unlockForRead()
+    {
+        LockState &state = lockState.localData();
+        Q_ASSERT(state.readDepth > 0);
+        if (--state.readDepth || state.writeDepth)
+            return;
+        lock.unlock();
+    }
+
+    void lockForWrite()
+    {
+        LockState &state = lockState.localData();
+        if (state.writeDepth++)
+            return;
+        if (state.readDepth)
+            lock.unlock();
+        lock.lockForWrite();
+    }
+
+    void unlockForWrite()
+    {
+        LockState &state = lockState.localData();
+        Q_ASSERT(state.writeDepth > 0);
+        if (--state.writeDepth)
+            return;
+        lock.unlock();
+        if (state.readDepth)
+            lock.lockForRead();
+    }
+
+private:
+    struct LockState
+    {
+        LockState() : readDepth(0), writeDepth(0) {}
+        int readDepth;
+        int writeDepth;
+    };
+
+    QReadWriteLock lock;
+    QThreadStorage<LockState> lockState;
+};
+
+// Like QMutexLocker, the lockers accept the null lock returned after the
+// global static has been destroyed.
+class QQmlMetaTypeDataReadLocker
+{
+public:
+    explicit QQmlMetaTypeDataReadLocker(QQmlMetaTypeDataLock *lock)
+        : m_lock(lock), m_locked(lock != 0)
+    {
+        if (m_locked)
+            m_lock->lockForRead();
+    }
+    ~QQmlMetaTypeDataReadLocker() { unlock(); }
+
+    void unlock()
+    {
+        if (m_locked) {
+            m_locked = false;
+            m_lock->unlockForRead();
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(QQmlMetaTypeDataReadLocker)
+    QQmlMetaTypeDataLock *m_lock;
+    bool m_locked;
+};
+
+class QQmlMetaTypeDataWriteLocker
+{
+public:
+    explicit QQmlMetaTypeDataWriteLocker(QQmlMetaTypeDataLock *lock)
+        : m_lock(lock)
+    {
+        if (m_lock)
+            m_lock->lockForWrite();
+    }
+    ~QQmlMetaTypeDataWriteLocker()
+    {
+        if (m_lock)
+            m_lock->unlockForWrite();
+    }
+
+private:
+    Q_DISABLE_COPY(QQmlMetaTypeDataWriteLocker)
+    QQmlMetaTypeDataLock *m_lock;
+};
+
+Q_GLOBAL_STATIC(QQmlMetaTypeDataLock, metaTypeDataLock)
+
+// Serializes the lazy setup of QQmlTypePrivate, which only reads QQmlMetaTypeData.
+// Always taken after a read lock on metaTypeDataLock, never the other way around.
+Q_GLOBAL_STATIC_WITH_ARGS(QMutex, typeSetupLock, (QMutex::Recursive))
 
 static uint qHash(const QQmlMetaTypeData::VersionedUri &v)
 {
@@ -679,7 +796,8 @@ void QQmlTypePrivate::init() const
     if (isSetup)
         return;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
+    QMutexLocker setupLock(typeSetupLock());
     if (isSetup)
         return;
 
@@ -751,7 +869,6 @@ void QQmlTypePrivate::init() const
     }
 
     isSetup = true;
-    lock.unlock();
 }
 
 void QQmlTypePrivate::initEnums() const
@@ -760,7 +877,8 @@ void QQmlTypePrivate::initEnums() const
 
     init();
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
+    QMutexLocker setupLock(typeSetupLock());
     if (isEnumSetup) return;
 
     if (baseMetaObject) // could be singleton type without metaobject
@@ -1239,7 +1357,7 @@ void QQmlTypeModulePrivate::remove(const QQmlTypePrivate *type)
 
 QQmlType QQmlTypeModule::type(const QHashedStringRef &name, int minor) const
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
 
     QList<QQmlTypePrivate *> *types = d->typeHash.value(name);
     if (types) {
@@ -1253,7 +1371,7 @@ QQmlType QQmlTypeModule::type(const QHashedStringRef &name, int minor) const
 
 QQmlType QQmlTypeModule::type(const QV4::String *name, int minor) const
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
 
     QList<QQmlTypePrivate *> *types = d->typeHash.value(name);
     if (types) {
@@ -1267,14 +1385,20 @@ QQmlType QQmlTypeModule::type(const QV4::String *name, int minor) const
 
 void QQmlTypeModule::walkCompositeSingletons(const std::function<void(const QQmlType &)> &callback) const
 {
-    QMutexLocker lock(metaTypeDataLock());
-    for (auto typeCandidates = d->typeHash.begin(), end = d->typeHash.end();
-         typeCandidates != end; ++typeCandidates) {
-        for (auto type: typeCandidates.value()) {
-            if (type->regType == QQmlType::CompositeSingletonType)
-                callback(QQmlType(type));
+    // The callback may load types, so it runs after the lock is released.
+    QVector<QQmlType> singletons;
+    {
+        QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
+        for (auto typeCandidates = d->typeHash.begin(), end = d->typeHash.end();
+             typeCandidates != end; ++typeCandidates) {
+            for (auto type: typeCandidates.value()) {
+                if (type->regType == QQmlType::CompositeSingletonType)
+                    singletons.append(QQmlType(type));
+            }
         }
     }
+    for (const QQmlType &type : qAsConst(singletons))
+        callback(type);
 }
 
 QQmlTypeModuleVersion::QQmlTypeModuleVersion()
@@ -1328,7 +1452,7 @@ QQmlType QQmlTypeModuleVersion::type(const QV4::String *name) const
 void qmlClearTypeRegistrations() // Declared in qqml.h
 {
     //Only cleans global static, assumed no running engine
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     for (QQmlMetaTypeData::TypeModules::const_iterator i = data->uriToModule.constBegin(), cend = data->uriToModule.constEnd(); i != cend; ++i)
@@ -1351,7 +1475,7 @@ void qmlClearTypeRegistrations() // Declared in qqml.h
 
 static int registerAutoParentFunction(QQmlPrivate::RegisterAutoParent &autoparent)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     data->parentFunctions.append(autoparent.function);
@@ -1364,7 +1488,7 @@ QQmlType registerInterface(const QQmlPrivate::RegisterInterface &interface)
     if (interface.version > 0)
         qFatal("qmlRegisterType(): Cannot mix incompatible QML versions.");
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlType type(data, interface);
@@ -1401,7 +1525,7 @@ QString registrationTypeString(QQmlType::RegistrationType typeType)
     return typeStr;
 }
 
-// NOTE: caller must hold a QMutexLocker on "data"
+// NOTE: caller must hold a write lock on "data"
 bool checkRegistration(QQmlType::RegistrationType typeType, QQmlMetaTypeData *data, const char *uri, const QString &typeName, int majorVersion = -1)
 {
     if (!typeName.isEmpty()) {
@@ -1452,7 +1576,7 @@ bool checkRegistration(QQmlType::RegistrationType typeType, QQmlMetaTypeData *da
     return true;
 }
 
-// NOTE: caller must hold a QMutexLocker on "data"
+// NOTE: caller must hold a write lock on "data"
 QQmlTypeModule *getTypeModule(const QHashedString &uri, int majorVersion, QQmlMetaTypeData *data)
 {
     QQmlMetaTypeData::VersionedUri versionedUri(uri, majorVersion);
@@ -1465,7 +1589,7 @@ QQmlTypeModule *getTypeModule(const QHashedString &uri, int majorVersion, QQmlMe
     return module;
 }
 
-// NOTE: caller must hold a QMutexLocker on "data"
+// NOTE: caller must hold a write lock on "data"
 void addTypeToData(QQmlTypePrivate *type, QQmlMetaTypeData *data)
 {
     Q_ASSERT(type);
@@ -1501,7 +1625,7 @@ void addTypeToData(QQmlTypePrivate *type, QQmlMetaTypeData *data)
 
 QQmlType registerType(const QQmlPrivate::RegisterType &type)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QString elementName = QString::fromUtf8(type.elementName);
     if (!checkRegistration(QQmlType::CppType, data, type.uri, elementName, type.versionMajor))
@@ -1518,7 +1642,7 @@ QQmlType registerType(const QQmlPrivate::RegisterType &type)
 
 QQmlType registerSingletonType(const QQmlPrivate::RegisterSingletonType &type)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     if (!checkRegistration(QQmlType::SingletonType, data, type.uri, typeName, type.versionMajor))
@@ -1534,7 +1658,7 @@ QQmlType registerSingletonType(const QQmlPrivate::RegisterSingletonType &type)
 QQmlType QQmlMetaType::registerCompositeSingletonType(const QQmlPrivate::RegisterCompositeSingletonType &type)
 {
     // Assumes URL is absolute and valid. Checking of user input should happen before the URL enters type.
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     bool fileImport = false;
@@ -1556,7 +1680,7 @@ QQmlType QQmlMetaType::registerCompositeSingletonType(const QQmlPrivate::Registe
 QQmlType QQmlMetaType::registerCompositeType(const QQmlPrivate::RegisterCompositeType &type)
 {
     // Assumes URL is absolute and valid. Checking of user input should happen before the URL enters type.
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QString typeName = QString::fromUtf8(type.typeName);
     bool fileImport = false;
@@ -1597,7 +1721,7 @@ void QQmlMetaType::registerInternalCompositeType(QV4::CompiledData::CompilationU
     compilationUnit->metaTypeId = ptr_type;
     compilationUnit->listMetaTypeId = lst_type;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *d = metaTypeData();
     d->qmlLists.insert(lst_type, ptr_type);
 }
@@ -1607,7 +1731,7 @@ void QQmlMetaType::unregisterInternalCompositeType(QV4::CompiledData::Compilatio
     int ptr_type = compilationUnit->metaTypeId;
     int lst_type = compilationUnit->listMetaTypeId;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *d = metaTypeData();
     d->qmlLists.remove(lst_type);
 
@@ -1619,7 +1743,7 @@ int registerQmlUnitCacheHook(const QQmlPrivate::RegisterQmlUnitCacheHook &hookRe
 {
     if (hookRegistration.version > 0)
         qFatal("qmlRegisterType(): Cannot mix incompatible QML versions.");
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     data->lookupCachedQmlUnit << hookRegistration.lookupCachedQmlUnit;
     return 0;
@@ -1650,7 +1774,7 @@ int QQmlPrivate::qmlregister(RegistrationType type, void *data)
     else
         return -1;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *typeData = metaTypeData();
     typeData->undeletableTypes.insert(dtype);
 
@@ -1660,7 +1784,7 @@ int QQmlPrivate::qmlregister(RegistrationType type, void *data)
 //From qqml.h
 bool qmlProtectModule(const char *uri, int majVersion)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlMetaTypeData::VersionedUri versionedUri;
@@ -1677,7 +1801,7 @@ bool qmlProtectModule(const char *uri, int majVersion)
 //From qqml.h
 void qmlRegisterModule(const char *uri, int versionMajor, int versionMinor)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlTypeModule *module = getTypeModule(QString::fromUtf8(uri), versionMajor, data);
@@ -1723,9 +1847,16 @@ QStringList QQmlMetaType::typeRegistrationFailures()
     return data->typeRegistrationFailures;
 }
 
-QMutex *QQmlMetaType::typeRegistrationLock()
+void QQmlMetaType::lockTypeRegistration()
 {
-    return metaTypeDataLock();
+    if (QQmlMetaTypeDataLock *lock = metaTypeDataLock())
+        lock->lockForWrite();
+}
+
+void QQmlMetaType::unlockTypeRegistration()
+{
+    if (QQmlMetaTypeDataLock *lock = metaTypeDataLock())
+        lock->unlockForWrite();
 }
 
 /*
@@ -1733,7 +1864,7 @@ QMutex *QQmlMetaType::typeRegistrationLock()
 */
 bool QQmlMetaType::isAnyModule(const QString &uri)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     for (QQmlMetaTypeData::TypeModules::ConstIterator iter = data->uriToModule.cbegin();
@@ -1750,7 +1881,7 @@ bool QQmlMetaType::isAnyModule(const QString &uri)
 */
 bool QQmlMetaType::isLockedModule(const QString &uri, int majVersion)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlMetaTypeData::VersionedUri versionedUri;
@@ -1771,7 +1902,7 @@ bool QQmlMetaType::isLockedModule(const QString &uri, int majVersion)
 bool QQmlMetaType::isModule(const QString &module, int versionMajor, int versionMinor)
 {
     Q_ASSERT(versionMajor >= 0 && versionMinor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
 
     QQmlMetaTypeData *data = metaTypeData();
 
@@ -1786,14 +1917,14 @@ bool QQmlMetaType::isModule(const QString &module, int versionMajor, int version
 
 QQmlTypeModule *QQmlMetaType::typeModule(const QString &uri, int majorVersion)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     return data->uriToModule.value(QQmlMetaTypeData::VersionedUri(uri, majorVersion));
 }
 
 QList<QQmlPrivate::AutoParentFunction> QQmlMetaType::parentFunctions()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     return data->parentFunctions;
 }
@@ -1815,7 +1946,7 @@ bool QQmlMetaType::isQObject(int userType)
     if (userType == QMetaType::QObjectStar)
         return true;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     return userType >= 0 && userType < data->objects.size() && data->objects.testBit(userType);
 }
@@ -1825,7 +1956,7 @@ bool QQmlMetaType::isQObject(int userType)
  */
 int QQmlMetaType::listType(int id)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QHash<int, int>::ConstIterator iter = data->qmlLists.constFind(id);
     if (iter != data->qmlLists.cend())
@@ -1839,10 +1970,12 @@ int QQmlMetaType::listType(int id)
 
 int QQmlMetaType::attachedPropertiesFuncId(QQmlEnginePrivate *engine, const QMetaObject *mo)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlType type(data->metaObjectToType.value(mo));
+    lock.unlock();
+    // Resolving the base of a composite type may load it, which registers types.
     if (type.attachedPropertiesFunction(engine))
         return type.attachedPropertiesId(engine);
     else
@@ -1853,9 +1986,11 @@ QQmlAttachedPropertiesFunc QQmlMetaType::attachedPropertiesFuncById(QQmlEnginePr
 {
     if (id < 0)
         return 0;
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
-    return data->types.at(id).attachedPropertiesFunction(engine);
+    const QQmlType type = data->types.at(id);
+    lock.unlock();
+    return type.attachedPropertiesFunction(engine);
 }
 
 QMetaProperty QQmlMetaType::defaultProperty(const QMetaObject *metaObject)
@@ -1917,7 +2052,7 @@ QQmlMetaType::TypeCategory QQmlMetaType::typeCategory(int userType)
     if (userType == QMetaType::QObjectStar)
         return Object;
 
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     if (data->qmlLists.contains(userType))
         return List;
@@ -1931,14 +2066,14 @@ QQmlMetaType::TypeCategory QQmlMetaType::typeCategory(int userType)
 
 bool QQmlMetaType::isInterface(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     return userType >= 0 && userType < data->interfaces.size() && data->interfaces.testBit(userType);
 }
 
 const char *QQmlMetaType::interfaceIId(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     QQmlType type(data->idToType.value(userType));
     lock.unlock();
@@ -1950,7 +2085,7 @@ const char *QQmlMetaType::interfaceIId(int userType)
 
 bool QQmlMetaType::isList(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     if (data->qmlLists.contains(userType))
         return true;
@@ -1974,7 +2109,7 @@ bool QQmlMetaType::isList(int userType)
  */
 void QQmlMetaType::registerCustomStringConverter(int type, StringConverter converter)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
 
     QQmlMetaTypeData *data = metaTypeData();
     if (data->stringConverters.contains(type))
@@ -1988,7 +2123,7 @@ void QQmlMetaType::registerCustomStringConverter(int type, StringConverter conve
  */
 QQmlMetaType::StringConverter QQmlMetaType::customStringConverter(int type)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
 
     QQmlMetaTypeData *data = metaTypeData();
     return data->stringConverters.value(type);
@@ -2017,7 +2152,7 @@ QQmlType QQmlMetaType::qmlType(const QString &qualifiedName, int version_major,
 QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlMetaTypeData::Names::ConstIterator it = data->nameToType.constFind(name);
@@ -2038,7 +2173,7 @@ QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedString
 */
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     return QQmlType(data->metaObjectToType.value(metaObject));
@@ -2052,7 +2187,7 @@ QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlMetaTypeData::MetaObjects::const_iterator it = data->metaObjectToType.constFind(metaObject);
@@ -2072,7 +2207,7 @@ QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStrin
 */
 QQmlType QQmlMetaType::qmlType(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlTypePrivate *type = data->idToType.value(userType);
@@ -2090,7 +2225,7 @@ QQmlType QQmlMetaType::qmlType(int userType)
 */
 QQmlType QQmlMetaType::qmlType(const QUrl &url, bool includeNonFileImports /* = false */)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QQmlType type(data->urlToType.value(url));
@@ -2121,8 +2256,14 @@ QQmlPropertyCache *QQmlMetaTypeData::propertyCache(const QMetaObject *metaObject
 
 QQmlPropertyCache *QQmlMetaType::propertyCache(const QMetaObject *metaObject)
 {
-    QMutexLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
+    {
+        QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
+        if (QQmlPropertyCache *rv = data->propertyCaches.value(metaObject))
+            return rv;
+    }
+
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     return data->propertyCache(metaObject);
 }
 
@@ -2233,14 +2374,20 @@ QQmlPropertyCache *QQmlMetaTypeData::propertyCache(const QQmlType &type, int min
 
 QQmlPropertyCache *QQmlMetaType::propertyCache(const QQmlType &type, int minorVersion)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    {
+        QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
+        if (QQmlPropertyCache *pc = type.key()->propertyCacheForMinorVersion(minorVersion))
+            return pc;
+    }
+
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
     return data->propertyCache(type, minorVersion);
 }
 
 void QQmlMetaType::freeUnusedTypesAndCaches()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataWriteLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     {
@@ -2279,7 +2426,9 @@ void QQmlMetaType::freeUnusedTypesAndCaches()
             QHash<const QMetaObject *, QQmlPropertyCache *>::Iterator it = data->propertyCaches.begin();
             while (it != data->propertyCaches.end()) {
 
-                if ((*it)->count() == 1) {
+                // The caches of registered C++ types are shared by all engines in the
+                // process and kept for the next engine, their meta objects are static.
+                if ((*it)->count() == 1 && !data->metaObjectToType.contains(it.key())) {
                     QQmlPropertyCache *pc = Q_NULLPTR;
                     qSwap(pc, *it);
                     it = data->propertyCaches.erase(it);
@@ -2298,7 +2447,7 @@ void QQmlMetaType::freeUnusedTypesAndCaches()
 */
 QList<QString> QQmlMetaType::qmlTypeNames()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QList<QString> names;
@@ -2318,7 +2467,7 @@ QList<QString> QQmlMetaType::qmlTypeNames()
 */
 QList<QQmlType> QQmlMetaType::qmlTypes()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     const QQmlMetaTypeData *data = metaTypeData();
 
     QList<QQmlType> types;
@@ -2333,7 +2482,7 @@ QList<QQmlType> QQmlMetaType::qmlTypes()
 */
 QList<QQmlType> QQmlMetaType::qmlAllTypes()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     return data->types;
@@ -2344,7 +2493,7 @@ QList<QQmlType> QQmlMetaType::qmlAllTypes()
 */
 QList<QQmlType> QQmlMetaType::qmlSingletonTypes()
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     QList<QQmlType> retn;
@@ -2358,7 +2507,7 @@ QList<QQmlType> QQmlMetaType::qmlSingletonTypes()
 
 const QQmlPrivate::CachedQmlUnit *QQmlMetaType::findCachedCompilationUnit(const QUrl &uri)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeDataReadLocker lock(metaTypeDataLock());
     QQmlMetaTypeData *data = metaTypeData();
 
     for (const auto lookup : qAsConst(data->lookupCachedQmlUnit)) {
@@ -140,11 +140,22 @@ public:
     static void setTypeRegistrationNamespace(const QString &);
     static QStringList typeRegistrationFailures();
 
-    static QMutex *typeRegistrationLock();
+    static void lockTypeRegistration();
+    static void unlockTypeRegistration();
 
     static QString prettyTypeName(const QObject *object);
 };
 
+class QQmlTypeRegistrationLocker
+{
+public:
+    QQmlTypeRegistrationLocker() { QQmlMetaType::lockTypeRegistration(); }
+    ~QQmlTypeRegistrationLocker() { QQmlMetaType::unlockTypeRegistration(); }
+
+private:
+    Q_DISABLE_COPY(QQmlTypeRegistrationLocker)
+};
+
 struct QQmlMetaTypeData;
 class QHashedCStringRef;
 class Q_QML_PRIVATE_EXPORT QQmlType
@@ -112,6 +112,7 @@ public:
 private:
     friend class QQmlData;
     friend class QQmlNotifier;
+    friend class QQmlBindingBatch;
 
     // Contains either the QObject*, or the QQmlNotifier* that this
     // endpoint is connected to.  While the endpoint is notifying, the
@@ -89,6 +89,7 @@ QQmlObjectCreator::QQmlObjectCreator(QQmlContextData *parentContext, QV4::Compil
     sharedState->allJavaScriptObjects = 0;
     sharedState->creationContext = creationContext;
     sharedState->rootContext = 0;
+    sharedState->arena = QQmlCreationArena::create();
 
     if (auto profiler = QQmlEnginePrivate::get(engine)->profiler) {
         Q_QML_PROFILE_IF_ENABLED(QQmlProfilerDefinitions::ProfileCreating, profiler,
@@ -169,6 +170,7 @@ QObject *QQmlObjectCreator::create(int subComponentIndex, QObject *parent, QQmlI
         objectToCreate = compObj->bindingTable()->value.objectIndex;
     }
 
+    // Not in the arena, as contexts can be kept alive long after the instance is gone.
     context = new QQmlContextData;
     context->isInternal = true;
     context->imports = compilationUnit->typeNameCache;
@@ -810,9 +812,9 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
 
         if (binding->flags & QV4::CompiledData::Binding::IsSignalHandlerExpression) {
             int signalIndex = _propertyCache->methodIndexToSignalIndex(property->coreIndex());
-            QQmlBoundSignal *bs = new QQmlBoundSignal(_bindingTarget, signalIndex, _scopeObject, engine);
-            QQmlBoundSignalExpression *expr = new QQmlBoundSignalExpression(_bindingTarget, signalIndex,
-                                                                            context, _scopeObject, runtimeFunction, qmlContext);
+            QQmlBoundSignal *bs = new (sharedState->arena) QQmlBoundSignal(_bindingTarget, signalIndex, _scopeObject, engine);
+            QQmlBoundSignalExpression *expr = new (sharedState->arena) QQmlBoundSignalExpression(_bindingTarget, signalIndex,
+                                                                                                     context, _scopeObject, runtimeFunction, qmlContext);
 
             bs->takeExpression(expr);
         } else {
@@ -828,7 +830,8 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
                 prop = _valueTypeProperty;
                 subprop = property;
             }
-            qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, qmlContext);
+            qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, qmlContext,
+                                             sharedState->arena);
             qmlBinding->setTarget(_bindingTarget, *prop, subprop);
 
             sharedState->allCreatedBindings.push(QQmlAbstractBinding::Ptr(qmlBinding));
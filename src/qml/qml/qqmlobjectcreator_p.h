@@ -57,6 +57,7 @@
 #include <private/qfinitestack_p.h>
 #include <private/qrecursionwatcher_p.h>
 #include <private/qqmlprofiler_p.h>
+#include <private/qqmlcreationarena_p.h>
 
 #include <qpointer.h>
 
@@ -69,6 +70,9 @@ class QQmlIncubatorPrivate;
 
 struct QQmlObjectCreatorSharedState : public QSharedData
 {
+    QQmlObjectCreatorSharedState() : arena(0) {}
+    ~QQmlObjectCreatorSharedState() { if (arena) arena->release(); }
+
     QQmlContextData *rootContext;
     QQmlContextData *creationContext;
     QFiniteStack<QQmlAbstractBinding::Ptr> allCreatedBindings;
@@ -79,6 +83,7 @@ struct QQmlObjectCreatorSharedState : public QSharedData
     QList<QQmlEnginePrivate::FinalizeCallback> finalizeCallbacks;
     QQmlVmeProfiler profiler;
     QRecursionNode recursionNode;
+    QQmlCreationArena *arena; // bindings and bound signals of this instance
 };
 
 class QQmlObjectCreator
@@ -40,6 +40,7 @@
 #include "qqmlopenmetaobject_p.h"
 #include <private/qqmlpropertycache_p.h>
 #include <private/qqmldata_p.h>
+#include <private/qqmlcontext_p.h>
 #include <private/qmetaobjectbuilder_p.h>
 #include <private/qv8engine_p.h>
 #include <qqmlengine.h>
@@ -153,6 +154,9 @@ int QQmlOpenMetaObjectType::createProperty(const QByteArray &name)
         ++it;
     }
 
+    // A context object using this type may now shadow names of parent contexts.
+    QQmlContextData::invalidateParentLookups();
+
     return d->propertyOffset + id;
 }
 
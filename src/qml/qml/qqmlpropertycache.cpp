@@ -74,6 +74,10 @@ public:
     QString *signalParameterStringForJS;
     int parameterError:1;
     int argumentsValid:1;
+    int returnTypeValid:1;
+
+    // resolved return type, see QQmlMetaObject::methodReturnType()
+    int returnType;
 
     QList<QByteArray> *names;
 
@@ -227,7 +231,9 @@ void QQmlPropertyData::lazyLoad(const QMetaMethod &m)
     const int paramCount = m.parameterCount();
     if (paramCount) {
         _flags.hasArguments = true;
-        if ((paramCount == 1) && (m.parameterTypes().constFirst() == "QQmlV4Function*")) {
+        // Only look at the type name, which builds a list, if the type is not registered
+        if (paramCount == 1 && m.parameterType(0) == QMetaType::UnknownType
+                && m.parameterTypes().constFirst() == "QQmlV4Function*") {
             _flags.isV4Function = true;
         }
     }
@@ -463,6 +469,16 @@ QQmlPropertyCache::copyAndAppend(const QMetaObject *metaObject,
     return rv;
 }
 
+/*! \internal
+    Appends the members of \a metaObject to this cache.
+
+    The name tables for properties, methods and signal handlers are filled
+    eagerly: lookups by name, override detection and the caches derived
+    from this one all need every name as soon as the cache exists. What is
+    expensive per member is deferred instead. Property and method types are
+    resolved on first use through QQmlPropertyData::notFullyResolved(), and
+    method argument lists are built on demand by methodParameterTypes().
+*/
 void QQmlPropertyCache::append(const QMetaObject *metaObject,
                                int revision,
                                QQmlPropertyData::Flags propertyFlags,
@@ -603,6 +619,13 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
     // update() should have reserved enough space in the vector that this doesn't cause a realloc
     // and invalidate the stringCache.
     propertyIndexCache.resize(propCount - propertyIndexCacheStart);
+
+    bool isGadget = true;
+    for (const QMetaObject *it = metaObject; it != nullptr; it = it->superClass()) {
+        if (it == &QObject::staticMetaObject)
+            isGadget = false;
+    }
+
     for (int ii = propOffset; ii < propCount; ++ii) {
         QMetaProperty p = metaObject->property(ii);
         if (!p.isScriptable())
@@ -640,12 +663,6 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
             setNamedProperty(propName, ii, data, (old != 0));
         }
 
-        bool isGadget = true;
-        for (const QMetaObject *it = metaObject; it != nullptr; it = it->superClass()) {
-            if (it == &QObject::staticMetaObject)
-                isGadget = false;
-        }
-
         if (isGadget) // always dispatch over a 'normal' meta-call so the QQmlValueType can intercept
             data->_flags.isDirect = false;
         else
@@ -909,6 +926,8 @@ QQmlPropertyCacheMethodArguments *QQmlPropertyCache::createArgumentsObject(int a
     A *args = static_cast<A *>(malloc(sizeof(A) + (argc) * sizeof(int)));
     args->arguments[0] = argc;
     args->argumentsValid = false;
+    args->returnTypeValid = false;
+    args->returnType = QMetaType::UnknownType;
     args->signalParameterStringForJS = 0;
     args->parameterError = false;
     args->names = argc ? new QList<QByteArray>(names) : 0;
@@ -1568,19 +1587,33 @@ int QQmlMetaObject::methodReturnType(const QQmlPropertyData &data, QByteArray *u
 
     int type = data.propType();
 
+    // Builtin types are never enums or flags and need no further resolution
+    if (type > QMetaType::UnknownType && type < QMetaType::User)
+        return type;
+
+    typedef QQmlPropertyCacheMethodArguments A;
+
+    QQmlPropertyCache *c = 0;
+    QQmlPropertyData *rv = 0;
+    if (_m.isT1()) {
+        c = _m.asT1();
+        Q_ASSERT(data.coreIndex() < c->methodIndexCacheStart + c->methodIndexCache.count());
+
+        while (data.coreIndex() < c->methodIndexCacheStart)
+            c = c->_parent;
+
+        rv = const_cast<QQmlPropertyData *>(&c->methodIndexCache.at(data.coreIndex() - c->methodIndexCacheStart));
+        if (rv->arguments() && static_cast<A *>(rv->arguments())->returnTypeValid)
+            return static_cast<A *>(rv->arguments())->returnType;
+    }
+
     const char *propTypeName = 0;
 
     if (type == QMetaType::UnknownType) {
         // Find the return type name from the method info
         QMetaMethod m;
 
-        if (_m.isT1()) {
-            QQmlPropertyCache *c = _m.asT1();
-            Q_ASSERT(data.coreIndex() < c->methodIndexCacheStart + c->methodIndexCache.count());
-
-            while (data.coreIndex() < c->methodIndexCacheStart)
-                c = c->_parent;
-
+        if (c) {
             const QMetaObject *metaObject = c->createMetaObject();
             Q_ASSERT(metaObject);
             m = metaObject->method(data.coreIndex());
@@ -1604,6 +1637,17 @@ int QQmlMetaObject::methodReturnType(const QQmlPropertyData &data, QByteArray *u
 
     if (type == QMetaType::UnknownType) {
         if (unknownTypeError) *unknownTypeError = propTypeName;
+    } else if (rv) {
+        // Remember the result, it is asked for every time the method is called from JS
+        if (!rv->arguments()) {
+            const QMetaObject *metaObject = c->createMetaObject();
+            Q_ASSERT(metaObject);
+            QMetaMethod m = metaObject->method(data.coreIndex());
+            rv->setArguments(c->createArgumentsObject(m.parameterCount(), m.parameterNames()));
+        }
+        A *args = static_cast<A *>(rv->arguments());
+        args->returnType = type;
+        args->returnTypeValid = true;
     }
 
     return type;
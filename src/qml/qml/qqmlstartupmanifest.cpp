@@ -0,0 +1,290 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmlstartupmanifest_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qthreadpool.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+\class QQmlStartupManifest
+\brief The QQmlStartupManifest class remembers the files touched during application startup.
+\internal
+
+When the QML_STARTUP_MANIFEST environment variable is set, every QML document that had to
+be parsed, every script, qmldir file, compilation cache file and plugin that was loaded is
+recorded together with its modification time. The list is written to the file named by the
+variable when the application exits.
+
+On the next start the entries whose modification time still matches are replayed: the type
+loader hands the QML documents to its background parser as soon as the first type is
+requested, and the remaining files, plugins included, are read on the global thread pool so
+that they are in the page cache by the time the load thread needs them. Plugins are only
+read, not loaded: their static initializers must run on the thread that imports them.
+Entries that no longer match are skipped and the manifest is rewritten at exit.
+*/
+
+static const char manifestHeader[] = "# qml-startup-manifest 1 " QT_VERSION_STR;
+
+static const char *const entryTypeNames[] = {
+    "qml",
+    "js",
+    "qmldir",
+    "cache",
+    "plugin"
+};
+
+Q_GLOBAL_STATIC(QQmlStartupManifest, startupManifest)
+
+static void saveStartupManifest()
+{
+    if (startupManifest.exists())
+        startupManifest()->save();
+}
+
+namespace {
+
+class FileWarmer : public QRunnable
+{
+public:
+    FileWarmer(const QStringList &files) : files(files) {}
+
+    void run() override
+    {
+        // Reading the files once is enough to get them into the page cache.
+        QByteArray buffer(64 * 1024, Qt::Uninitialized);
+        for (const QString &path : qAsConst(files)) {
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly))
+                continue;
+            while (file.read(buffer.data(), buffer.size()) > 0) {}
+        }
+    }
+
+private:
+    QStringList files;
+};
+
+}
+
+QQmlStartupManifest::QQmlStartupManifest()
+    : m_manifestPath(QString::fromLocal8Bit(qgetenv("QML_STARTUP_MANIFEST")))
+    , m_stale(true)
+    , m_prefetchStarted(false)
+{
+    m_stale = !load();
+}
+
+/*!
+Returns the process wide manifest, or null if QML_STARTUP_MANIFEST is not set.
+*/
+QQmlStartupManifest *QQmlStartupManifest::instance()
+{
+    static const bool enabled = qEnvironmentVariableIsSet("QML_STARTUP_MANIFEST");
+    if (!enabled)
+        return 0;
+    static const bool saveRegistered = (qAddPostRoutine(saveStartupManifest), true);
+    Q_UNUSED(saveRegistered);
+    return startupManifest();
+}
+
+qint64 QQmlStartupManifest::lastModified(const QString &filePath)
+{
+    const QDateTime dt = QFileInfo(filePath).lastModified();
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : 0;
+}
+
+bool QQmlStartupManifest::load()
+{
+    QFile file(m_manifestPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    if (file.readLine().trimmed() != manifestHeader)
+        return false;
+
+    bool upToDate = true;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        const QList<QByteArray> fields = line.left(line.size() - (line.endsWith('\n') ? 1 : 0)).split('\t');
+        if (fields.count() != 3) {
+            upToDate = false;
+            continue;
+        }
+
+        int type = 0;
+        const int typeCount = sizeof(entryTypeNames) / sizeof(entryTypeNames[0]);
+        while (type < typeCount && fields.at(0) != entryTypeNames[type])
+            ++type;
+        bool ok = false;
+        const qint64 modified = fields.at(1).toLongLong(&ok);
+        if (type == typeCount || !ok) {
+            upToDate = false;
+            continue;
+        }
+
+        Entry entry;
+        entry.type = EntryType(type);
+        entry.lastModified = modified;
+        entry.filePath = QString::fromUtf8(fields.at(2));
+        if (!QFileInfo::exists(entry.filePath) || lastModified(entry.filePath) != modified) {
+            upToDate = false;
+            continue;
+        }
+        m_valid.append(entry);
+    }
+    return upToDate;
+}
+
+void QQmlStartupManifest::addEntry(EntryType type, const QString &filePath)
+{
+    if (filePath.isEmpty())
+        return;
+
+    QString key = filePath;
+    key.prepend(QLatin1Char(':')).prepend(QLatin1String(entryTypeNames[type]));
+
+    QMutexLocker locker(&m_mutex);
+    if (m_recordedKeys.contains(key))
+        return;
+    m_recordedKeys.insert(key);
+
+    Entry entry;
+    entry.type = type;
+    entry.lastModified = lastModified(filePath);
+    entry.filePath = filePath;
+    m_recorded.append(entry);
+}
+
+/*!
+Returns the URLs of the QML documents that were parsed during the last recorded startup
+and have not changed since.
+*/
+QVector<QUrl> QQmlStartupManifest::documentsToPrefetch() const
+{
+    QVector<QUrl> urls;
+    for (const Entry &entry : m_valid) {
+        if (entry.type != QmlDocument)
+            continue;
+        if (entry.filePath.startsWith(QLatin1Char(':')))
+            urls.append(QUrl(QLatin1String("qrc") + entry.filePath));
+        else
+            urls.append(QUrl::fromLocalFile(entry.filePath));
+    }
+    return urls;
+}
+
+/*!
+Starts reading the recorded script, qmldir, cache and plugin files on the global thread pool.
+Only the first call in a process has any effect.
+*/
+void QQmlStartupManifest::prefetchFiles()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_prefetchStarted)
+            return;
+        m_prefetchStarted = true;
+    }
+
+    QStringList files;
+    for (const Entry &entry : qAsConst(m_valid)) {
+        // QML documents are parsed by the type loader, which reads the file itself.
+        if (entry.type != QmlDocument && !entry.filePath.startsWith(QLatin1Char(':')))
+            files.append(entry.filePath);
+    }
+
+    if (!files.isEmpty())
+        QThreadPool::globalInstance()->start(new FileWarmer(files));
+}
+
+/*!
+Writes the entries recorded in this process to the manifest file, unless they are identical
+to what was loaded from it.
+*/
+bool QQmlStartupManifest::save()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_stale && m_recorded.count() == m_valid.count()) {
+        bool same = true;
+        for (int i = 0; same && i < m_recorded.count(); ++i) {
+            const Entry &a = m_recorded.at(i);
+            const Entry &b = m_valid.at(i);
+            same = a.type == b.type && a.lastModified == b.lastModified && a.filePath == b.filePath;
+        }
+        if (same)
+            return true;
+    }
+
+    if (m_recorded.isEmpty())
+        return false;
+
+    QSaveFile file(m_manifestPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QByteArray data(manifestHeader);
+    data += '\n';
+    for (const Entry &entry : qAsConst(m_recorded)) {
+        data += entryTypeNames[entry.type];
+        data += '\t';
+        data += QByteArray::number(entry.lastModified);
+        data += '\t';
+        data += entry.filePath.toUtf8();
+        data += '\n';
+    }
+    file.write(data);
+    if (!file.commit())
+        return false;
+
+    m_valid = m_recorded;
+    m_stale = false;
+    return true;
+}
+
+QT_END_NAMESPACE
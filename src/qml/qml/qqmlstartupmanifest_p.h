@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLSTARTUPMANIFEST_P_H
+#define QQMLSTARTUPMANIFEST_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+// Records which files an application touches while starting up and replays
+// that list on the next start, so that the type loader can parse documents and
+// warm qmldir, script, cache and plugin files before it actually asks for them.
+// Enabled by pointing QML_STARTUP_MANIFEST at a (possibly not yet existing) file.
+class Q_QML_PRIVATE_EXPORT QQmlStartupManifest
+{
+public:
+    enum EntryType {
+        QmlDocument,
+        Script,
+        Qmldir,
+        CompilationCache,
+        Plugin
+    };
+
+    struct Entry {
+        EntryType type;
+        qint64 lastModified;
+        QString filePath;
+    };
+
+    QQmlStartupManifest();
+
+    static QQmlStartupManifest *instance();
+
+    static void record(EntryType type, const QString &filePath)
+    {
+        if (QQmlStartupManifest *manifest = instance())
+            manifest->addEntry(type, filePath);
+    }
+
+    QString manifestPath() const { return m_manifestPath; }
+    QVector<Entry> validEntries() const { return m_valid; }
+    QVector<QUrl> documentsToPrefetch() const;
+    void prefetchFiles();
+
+    void addEntry(EntryType type, const QString &filePath);
+    bool save();
+
+    static qint64 lastModified(const QString &filePath);
+
+private:
+    bool load();
+
+    QString m_manifestPath;
+    QVector<Entry> m_valid;
+    bool m_stale;
+    bool m_prefetchStarted;
+
+    QMutex m_mutex;
+    QVector<Entry> m_recorded;
+    QSet<QString> m_recordedKeys;
+};
+
+Q_DECLARE_TYPEINFO(QQmlStartupManifest::Entry, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QQMLSTARTUPMANIFEST_P_H
@@ -0,0 +1,351 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmltypedbinding_p.h"
+
+#include <private/qqmlcontext_p.h>
+#include <private/qqmldata_p.h>
+#include <private/qqmlglobal_p.h>
+#include <private/qqmljavascriptexpression_p.h>
+#include <private/qqmlpropertycache_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4scopedvalue_p.h>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(disableTypedBindings, QML_DISABLE_TYPED_BINDINGS)
+
+/*!
+\class QQmlTypedBinding
+\brief The QQmlTypedBinding class evaluates binding expressions without calling into JavaScript.
+\internal
+
+The compiler generates a typed form next to the JavaScript function of binding expressions
+that only do arithmetic on numbers and numeric properties, such as \c {parent.width - 10}.
+The typed form is a short list of QV4::CompiledData::TypedBindingInstruction operating on a
+stack of numbers and objects.
+
+Names and properties are looked up the way the JavaScript function would look them up and
+the same dependencies are captured, but the properties are read directly and none of the
+values is converted to a JavaScript value. Whenever the typed form meets something it does not
+handle, such as a null object, a property that is not a number or an object, or a name that
+is not a property, evaluate() gives up and the JavaScript function has to be called instead,
+which then also reports any error.
+
+Setting the QML_DISABLE_TYPED_BINDINGS environment variable always calls the function.
+*/
+
+namespace {
+
+struct Operand
+{
+    double number;
+    QObject *object;
+    bool isObject;
+
+    void setNumber(double n) { number = n; object = 0; isObject = false; }
+    void setObject(QObject *o) { number = 0; object = o; isObject = true; }
+};
+
+enum LookupResult {
+    Found,
+    NotFound,
+    Unsupported
+};
+
+}
+
+// See loadProperty() in qv4qobjectwrapper.cpp
+static bool readProperty(QObject *object, QQmlPropertyData *property, QQmlPropertyCapture *capture,
+                         Operand *result)
+{
+    if (property->isFunction() || property->isVarProperty() || property->isQList())
+        return false;
+
+    const int type = property->propType();
+    if (!property->isQObject() && !property->isEnum() && type != QMetaType::Int
+        && type != QMetaType::UInt && type != QMetaType::Float && type != QMetaType::Double)
+        return false;
+
+    QQmlData::flushPendingBinding(object, QQmlPropertyIndex(property->coreIndex()));
+
+    if (capture && !property->isConstant())
+        capture->captureProperty(object, property->coreIndex(), property->notifyIndex());
+
+    if (property->isQObject()) {
+        QObject *value = 0;
+        property->readProperty(object, &value);
+        result->setObject(value);
+    } else if (type == QMetaType::Double) {
+        double value = 0;
+        property->readProperty(object, &value);
+        result->setNumber(value);
+    } else if (type == QMetaType::Float) {
+        float value = 0;
+        property->readProperty(object, &value);
+        result->setNumber(value);
+    } else if (type == QMetaType::UInt) {
+        uint value = 0;
+        property->readProperty(object, &value);
+        result->setNumber(value);
+    } else {
+        int value = 0;
+        property->readProperty(object, &value);
+        result->setNumber(value);
+    }
+    return true;
+}
+
+// See QV4::QObjectWrapper::getQmlProperty()
+static LookupResult readNamedProperty(QV4::ExecutionEngine *engine, QObject *object, QV4::String *name,
+                                      QQmlContextData *context, bool checkRevision,
+                                      QQmlPropertyCapture *capture, Operand *result)
+{
+    if (QQmlData::wasDeleted(object))
+        return NotFound;
+
+    if (name->equals(engine->id_destroy()) || name->equals(engine->id_toString()))
+        return Unsupported;
+
+    QQmlData *ddata = QQmlData::get(object, true);
+    if (!ddata)
+        return NotFound;
+
+    QQmlPropertyData local;
+    QQmlPropertyData *property = ddata->propertyCache
+            ? ddata->propertyCache->property(name, object, context)
+            : QQmlPropertyCache::property(engine->jsEngine(), object, name, context, local);
+
+    if (!property) {
+        // JavaScript would go on with the properties of the wrapper object and its prototypes
+        QV4::Scope scope(engine);
+        QV4::ScopedObject wrapper(scope, QV4::QObjectWrapper::wrap(engine, object));
+        return wrapper && wrapper->hasProperty(name) ? Unsupported : NotFound;
+    }
+
+    if (checkRevision && property->hasRevision() && ddata->propertyCache
+        && !ddata->propertyCache->isAllowedInRevision(property))
+        return NotFound;
+
+    return readProperty(object, property, capture, result) ? Found : Unsupported;
+}
+
+// See QV4::QmlContextWrapper::get()
+static LookupResult lookupName(QV4::ExecutionEngine *engine, QV4::String *name, QQmlContextData *context,
+                               QObject *scopeObject, QQmlPropertyCapture *capture, Operand *result)
+{
+    // Names of the global object come before the QML names, type names are not supported
+    if (engine->globalObject->hasProperty(name) || name->startsWithUpper())
+        return Unsupported;
+
+    for (; context; context = context->parent) {
+        const QV4::IdentifierHash<int> &properties = context->propertyNames();
+        if (properties.count()) {
+            const int propertyIndex = properties.value(name);
+            if (propertyIndex != -1) {
+                if (propertyIndex < context->idValueCount) {
+                    if (capture)
+                        capture->captureProperty(&context->idValues[propertyIndex].bindings);
+                    result->setObject(context->idValues[propertyIndex].data());
+                    return Found;
+                }
+
+                QQmlContextPrivate *cp = context->asQQmlContextPrivate();
+                const QVariant &value = cp->propertyValues.at(propertyIndex);
+                switch (value.userType()) {
+                case QMetaType::Int:
+                case QMetaType::UInt:
+                case QMetaType::Float:
+                case QMetaType::Double:
+                    result->setNumber(value.toDouble());
+                    break;
+                case QMetaType::QObjectStar:
+                    result->setObject(*static_cast<QObject *const *>(value.constData()));
+                    break;
+                default:
+                    return Unsupported;
+                }
+                if (capture)
+                    capture->captureProperty(context->asQQmlContext(), -1, propertyIndex + cp->notifyIndex);
+                return Found;
+            }
+        }
+
+        if (scopeObject) {
+            const LookupResult lookup = readNamedProperty(engine, scopeObject, name, context,
+                                                          /*checkRevision*/true, capture, result);
+            if (lookup != NotFound)
+                return lookup;
+        }
+        scopeObject = 0;
+
+        if (context->contextObject) {
+            const LookupResult lookup = readNamedProperty(engine, context->contextObject, name, context,
+                                                          /*checkRevision*/true, capture, result);
+            if (lookup != NotFound)
+                return lookup;
+        }
+    }
+
+    // Leave the ReferenceError to JavaScript
+    return Unsupported;
+}
+
+bool QQmlTypedBinding::isEnabled()
+{
+    static const bool enabled = !disableTypedBindings();
+    return enabled;
+}
+
+/*!
+Evaluates the typed form of \a function in the QML \a context with the given \a scopeObject,
+capturing the properties read with \a capture. Properties of the scope and context object that
+the compiler resolved are only captured if \a captureScopeProperties is set; otherwise they are
+permanent dependencies of the binding already.
+
+Returns true and stores the value in \a result if the typed form could compute it. Returns false
+if the JavaScript function has to be called.
+*/
+bool QQmlTypedBinding::evaluate(QV4::ExecutionEngine *engine, const QV4::Function *function,
+                                QQmlContextData *context, QObject *scopeObject,
+                                QQmlPropertyCapture *capture, bool captureScopeProperties,
+                                double *result)
+{
+    typedef QV4::CompiledData::TypedBindingInstruction Instruction;
+
+    const QV4::CompiledData::Function *compiledFunction = function->compiledFunction;
+    const Instruction *instruction = compiledFunction->typedBindingTable();
+    const Instruction *end = instruction + compiledFunction->nTypedBindingInstructions;
+    if (instruction == end || !context)
+        return false;
+
+    QV4::Scope scope(engine);
+    QV4::ScopedString name(scope);
+
+    Operand stack[Instruction::MaximumStackDepth];
+    int depth = 0;
+
+    for (; instruction != end; ++instruction) {
+        const quint32 index = instruction->index;
+        switch (instruction->type) {
+        case Instruction::LoadConstant:
+            if (depth == Instruction::MaximumStackDepth)
+                return false;
+            stack[depth++].setNumber(function->compilationUnit->constants[index].toNumber());
+            break;
+        case Instruction::LoadScopeProperty:
+        case Instruction::LoadContextProperty: {
+            if (depth == Instruction::MaximumStackDepth)
+                return false;
+            QObject *object = instruction->type == Instruction::LoadScopeProperty ? scopeObject : context->contextObject;
+            if (!object || QQmlData::wasDeleted(object))
+                return false;
+            QQmlData *ddata = QQmlData::get(object, false);
+            if (!ddata || !ddata->propertyCache)
+                return false;
+            QQmlPropertyData *property = ddata->propertyCache->property(int(index));
+            if (!property || !readProperty(object, property, captureScopeProperties ? capture : 0, &stack[depth]))
+                return false;
+            ++depth;
+            break;
+        }
+        case Instruction::LoadIdObject:
+            if (depth == Instruction::MaximumStackDepth || int(index) >= context->idValueCount)
+                return false;
+            if (capture)
+                capture->captureProperty(&context->idValues[index].bindings);
+            stack[depth++].setObject(context->idValues[index].data());
+            break;
+        case Instruction::LoadName:
+            if (depth == Instruction::MaximumStackDepth)
+                return false;
+            name = function->compilationUnit->runtimeStrings[index];
+            if (lookupName(engine, name, context, scopeObject, capture, &stack[depth]) != Found)
+                return false;
+            ++depth;
+            break;
+        case Instruction::LoadProperty: {
+            if (depth == 0 || !stack[depth - 1].isObject || !stack[depth - 1].object)
+                return false;
+            QObject *object = stack[depth - 1].object;
+            name = function->compilationUnit->runtimeStrings[index];
+            if (readNamedProperty(engine, object, name, context, /*checkRevision*/false,
+                                  capture, &stack[depth - 1]) != Found)
+                return false;
+            break;
+        }
+        case Instruction::Add:
+        case Instruction::Subtract:
+        case Instruction::Multiply:
+        case Instruction::Divide: {
+            // Strings and objects need the conversions of JavaScript
+            if (depth < 2 || stack[depth - 2].isObject || stack[depth - 1].isObject)
+                return false;
+            double &left = stack[depth - 2].number;
+            const double right = stack[depth - 1].number;
+            if (instruction->type == Instruction::Add)
+                left += right;
+            else if (instruction->type == Instruction::Subtract)
+                left -= right;
+            else if (instruction->type == Instruction::Multiply)
+                left *= right;
+            else
+                left /= right;
+            --depth;
+            break;
+        }
+        case Instruction::Negate:
+            if (depth == 0 || stack[depth - 1].isObject)
+                return false;
+            stack[depth - 1].number = -stack[depth - 1].number;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    if (depth != 1 || stack[0].isObject)
+        return false;
+    *result = stack[0].number;
+    return true;
+}
+
+QT_END_NAMESPACE
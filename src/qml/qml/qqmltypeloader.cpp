@@ -51,6 +51,8 @@
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
 #include <private/qdeferredcleanup_p.h>
+#include <private/qqmlstartupmanifest_p.h>
+#include <private/qqmlimportresolutioncache_p.h>
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
@@ -62,6 +64,8 @@
 #include <QtCore/qdiriterator.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qwaitcondition.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qrunnable.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtQml/qqmlextensioninterface.h>
 #include <QtCore/qcryptographichash.h>
@@ -102,6 +106,7 @@
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
 DEFINE_BOOL_CONFIG_OPTION(disableDiskCache, QML_DISABLE_DISK_CACHE);
 DEFINE_BOOL_CONFIG_OPTION(forceDiskCache, QML_FORCE_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(disableParallelParsing, QML_DISABLE_PARALLEL_PARSING);
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
@@ -160,6 +165,7 @@ public:
     void callCompleted(QQmlDataBlob *b);
     void callDownloadProgressChanged(QQmlDataBlob *b, qreal p);
     void initializeEngine(QQmlExtensionInterface *, const char *);
+    void prefetch(const QVector<QUrl> &urls);
 
 protected:
     void shutdownThread() override;
@@ -171,6 +177,7 @@ private:
     void callCompletedMain(QQmlDataBlob *b);
     void callDownloadProgressChangedMain(QQmlDataBlob *b, qreal p);
     void initializeEngineMain(QQmlExtensionInterface *iface, const char *uri);
+    void prefetchThread(const QVector<QUrl> &urls);
 
     QQmlTypeLoader *m_loader;
 #if QT_CONFIG(qml_network)
@@ -859,6 +866,11 @@ void QQmlTypeLoaderThread::initializeEngine(QQmlExtensionInterface *iface,
     callMethodInMain(&This::initializeEngineMain, iface, uri);
 }
 
+void QQmlTypeLoaderThread::prefetch(const QVector<QUrl> &urls)
+{
+    postMethodToThread(&This::prefetchThread, urls);
+}
+
 void QQmlTypeLoaderThread::shutdownThread()
 {
 #if QT_CONFIG(qml_network)
@@ -887,6 +899,11 @@ void QQmlTypeLoaderThread::loadWithCachedUnitThread(QQmlDataBlob *b, const QQmlP
     b->release();
 }
 
+void QQmlTypeLoaderThread::prefetchThread(const QVector<QUrl> &urls)
+{
+    m_loader->prefetchThread(urls);
+}
+
 void QQmlTypeLoaderThread::callCompletedMain(QQmlDataBlob *b)
 {
     QML_MEMORY_SCOPE_URL(b->url());
@@ -1274,6 +1291,9 @@ void QQmlTypeLoader::setData(QQmlDataBlob *blob, const QQmlDataBlob::SourceCodeD
     blob->m_inCallback = true;
 
     blob->dataReceived(d);
+    // A background parse result that was not used (for example because the disk cache
+    // was used instead) is of no further use.
+    cancelParseJob(blob);
 
     if (!blob->isError() && !blob->isWaiting())
         blob->allDependenciesDone();
@@ -1294,6 +1314,7 @@ void QQmlTypeLoader::setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::Cached
     blob->m_inCallback = true;
 
     blob->initializeFromCachedUnit(unit);
+    cancelParseJob(blob);
 
     if (!blob->isError() && !blob->isWaiting())
         blob->allDependenciesDone();
@@ -1306,6 +1327,214 @@ void QQmlTypeLoader::setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::Cached
     blob->tryDone();
 }
 
+class QQmlTypeLoader::ParseJob
+{
+public:
+    ParseJob() : debugMode(false), fromStartupManifest(false), done(false), parsed(false) {}
+
+    void run();
+    void wait();
+
+    QQmlDataBlob::SourceCodeData source;
+    QString urlString;
+    QSet<QString> illegalNames;
+    bool debugMode;
+    bool fromStartupManifest;
+    QAtomicInt cancelled;
+
+    QMutex mutex;
+    QWaitCondition finished;
+    bool done;
+
+    // Only accessed after wait() returned.
+    QScopedPointer<QmlIR::Document> document;
+    QString sourceError;
+    QList<QQmlJS::DiagnosticMessage> errors;
+    bool parsed;
+};
+
+class QQmlTypeLoader::ParseRunnable : public QRunnable
+{
+public:
+    ParseRunnable(const QSharedPointer<ParseJob> &job) : job(job) {}
+    void run() override { job->run(); }
+
+private:
+    QSharedPointer<ParseJob> job;
+};
+
+void QQmlTypeLoader::ParseJob::run()
+{
+    if (!cancelled.load()) {
+        const QString code = source.readAll(&sourceError);
+        if (sourceError.isEmpty()) {
+            document.reset(new QmlIR::Document(debugMode));
+            QmlIR::IRBuilder compiler(illegalNames);
+            parsed = compiler.generateFromQml(code, urlString, document.data());
+            if (!parsed) {
+                errors = compiler.errors;
+                document.reset();
+            }
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    done = true;
+    finished.wakeAll();
+}
+
+void QQmlTypeLoader::ParseJob::wait()
+{
+    QMutexLocker locker(&mutex);
+    while (!done)
+        finished.wait(&mutex);
+}
+
+/*!
+Starts parsing the local QML files at \a urls on a thread pool, so that siblings in the
+dependency graph are parsed in parallel while the load thread processes them one by one.
+The results are picked up by QQmlTypeData::loadFromSource(). Documents with a usable
+disk cache entry are skipped, as they are never parsed.
+*/
+void QQmlTypeLoader::parseInBackground(const QVector<QUrl> &urls, bool debugMode, bool fromStartupManifest)
+{
+    ASSERT_LOADTHREAD();
+
+    // Parsing a single file in the background only adds overhead.
+    if (urls.count() < 2 || disableParallelParsing())
+        return;
+
+    if (!m_parsePool) {
+        const int threadCount = QThread::idealThreadCount() - 1;
+        if (threadCount < 1)
+            return;
+        m_parsePool.reset(new QThreadPool);
+        m_parsePool->setMaxThreadCount(threadCount);
+    }
+
+    // Mirrors QQmlTypeData::tryLoadFromDiskCache()
+    const bool useDiskCache = (!disableDiskCache() || forceDiskCache()) && !debugMode;
+    const QSet<QString> illegalNames = QV8Engine::get(m_engine)->illegalNames();
+    for (const QUrl &typeUrl : urls) {
+        if (m_typeCache.contains(typeUrl))
+            continue;
+        const QUrl url = parseJobUrl(typeUrl);
+        if (m_parseJobs.contains(url) || !QQmlFile::isSynchronous(url))
+            continue;
+        if (QQmlMetaType::findCachedCompilationUnit(url))
+            continue;
+        QQmlDataBlob::SourceCodeData source;
+        source.fileInfo = QFileInfo(QQmlFile::urlToLocalFileOrQrc(url));
+        if (useDiskCache && QV4::CompiledData::CompilationUnit::hasCacheFile(url, source.sourceTimeStamp()))
+            continue;
+
+        QSharedPointer<ParseJob> job(new ParseJob);
+        job->source = source;
+        job->urlString = url.toString();
+        job->illegalNames = illegalNames;
+        job->debugMode = debugMode;
+        job->fromStartupManifest = fromStartupManifest;
+        m_parseJobs.insert(url, job);
+        m_parsePool->start(new ParseRunnable(job));
+    }
+}
+
+/*!
+\internal
+Returns the URL that a QQmlTypeData created for \a url loads its source from, which is what
+parse jobs are keyed by. This matches what the QQmlDataBlob constructor does; local files
+are never redirected.
+*/
+QUrl QQmlTypeLoader::parseJobUrl(const QUrl &url) const
+{
+    if (QQmlAbstractUrlInterceptor *interceptor = m_engine->urlInterceptor())
+        return interceptor->intercept(url, QQmlAbstractUrlInterceptor::QmlFile);
+    return url;
+}
+
+/*!
+\internal
+Takes the background parse of the QML document that \a blob loads, if there is one.
+*/
+QSharedPointer<QQmlTypeLoader::ParseJob> QQmlTypeLoader::takeParseJob(const QQmlDataBlob *blob)
+{
+    ASSERT_LOADTHREAD();
+    if (m_parseJobs.isEmpty())
+        return QSharedPointer<ParseJob>();
+    return m_parseJobs.take(blob->url());
+}
+
+void QQmlTypeLoader::cancelParseJob(const QQmlDataBlob *blob)
+{
+    if (m_parseJobs.isEmpty())
+        return;
+    if (QSharedPointer<ParseJob> job = m_parseJobs.take(blob->url()))
+        job->cancelled.store(1);
+}
+
+void QQmlTypeLoader::cancelParseJobs()
+{
+    for (const QSharedPointer<ParseJob> &job : qAsConst(m_parseJobs))
+        job->cancelled.store(1);
+    m_parseJobs.clear();
+}
+
+/*!
+\internal
+Called when \a typeData is done. Once the document whose request replayed the startup
+manifest is complete, the startup is over: documents of the manifest that it did not ask
+for have been removed from the application, and their parse results are dropped.
+*/
+void QQmlTypeLoader::startupDocumentDone(QQmlTypeData *typeData)
+{
+    if (typeData != m_startupDocument)
+        return;
+    m_startupDocument = 0;
+
+    for (auto it = m_parseJobs.begin(); it != m_parseJobs.end();) {
+        if ((*it)->fromStartupManifest) {
+            (*it)->cancelled.store(1);
+            it = m_parseJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*!
+\internal
+Replays the startup manifest, if one is configured, the first time a type is requested: the
+recorded QML documents are handed to the background parser and the remaining recorded files
+are prefetched. See QQmlStartupManifest.
+*/
+void QQmlTypeLoader::startupPrefetch()
+{
+    m_startupPrefetchDone = true;
+
+    QQmlStartupManifest *manifest = QQmlStartupManifest::instance();
+    if (!manifest)
+        return;
+
+    manifest->prefetchFiles();
+
+    const QVector<QUrl> documents = manifest->documentsToPrefetch();
+    if (documents.isEmpty())
+        return;
+    if (m_thread->isThisThread())
+        prefetchThread(documents);
+    else
+        m_thread->prefetch(documents);
+}
+
+void QQmlTypeLoader::prefetchThread(const QVector<QUrl> &urls)
+{
+    ASSERT_LOADTHREAD();
+
+    if (m_thread->isShutdown())
+        return;
+    parseInBackground(urls, QV8Engine::getV4(m_engine)->debugger() != 0, true);
+}
+
 void QQmlTypeLoader::shutdownThread()
 {
     if (m_thread && !m_thread->isShutdown())
@@ -1604,7 +1833,8 @@ Constructs a new type loader that uses the given \a engine.
 */
 QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
     : m_engine(engine), m_thread(new QQmlTypeLoaderThread(this)),
-      m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD)
+      m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD),
+      m_startupPrefetchDone(false), m_startupDocument(0)
 {
 }
 
@@ -1617,6 +1847,9 @@ QQmlTypeLoader::~QQmlTypeLoader()
     // Stop the loader thread before releasing resources
     shutdownThread();
 
+    cancelParseJobs();
+    m_parsePool.reset();
+
     clearCache();
 
     invalidate();
@@ -1638,6 +1871,10 @@ QQmlTypeData *QQmlTypeLoader::getType(const QUrl &url, Mode mode)
 
     LockHolder<QQmlTypeLoader> holder(this);
 
+    const bool replayStartupManifest = !m_startupPrefetchDone;
+    if (replayStartupManifest)
+        startupPrefetch();
+
     QQmlTypeData *typeData = m_typeCache.value(url);
 
     if (!typeData) {
@@ -1646,6 +1883,8 @@ QQmlTypeData *QQmlTypeLoader::getType(const QUrl &url, Mode mode)
             trimCache();
 
         typeData = new QQmlTypeData(url, this);
+        if (replayStartupManifest)
+            m_startupDocument = typeData;
         // TODO: if (compiledData == 0), is it safe to omit this insertion?
         m_typeCache.insert(url, typeData);
         if (const QQmlPrivate::CachedQmlUnit *cachedUnit = QQmlMetaType::findCachedCompilationUnit(typeData->url())) {
@@ -1893,12 +2132,19 @@ const QQmlTypeLoaderQmldirContent *QQmlTypeLoader::qmldirContent(const QString &
 #define NOT_READABLE_ERROR QString(QLatin1String("module \"$$URI$$\" definition \"%1\" not readable"))
 #define CASE_MISMATCH_ERROR QString(QLatin1String("cannot load module \"$$URI$$\": File name case mismatch for \"%1\""))
 
+        QQmlImportResolutionCache *importCache = QQmlImportResolutionCache::instance();
+        QString cachedContent;
         QFile file(filePath);
-        if (!QQml_isFileCaseCorrect(filePath)) {
+        if (importCache && importCache->qmldirContent(filePath, &cachedContent)) {
+            qmldir->setContent(filePath, cachedContent);
+        } else if (!QQml_isFileCaseCorrect(filePath)) {
             ERROR(CASE_MISMATCH_ERROR.arg(filePath));
         } else if (file.open(QFile::ReadOnly)) {
-            QByteArray data = file.readAll();
-            qmldir->setContent(filePath, QString::fromUtf8(data));
+            const QString content = QString::fromUtf8(file.readAll());
+            qmldir->setContent(filePath, content);
+            QQmlStartupManifest::record(QQmlStartupManifest::Qmldir, filePath);
+            if (importCache)
+                importCache->recordQmldirContent(filePath, content);
         } else {
             ERROR(NOT_READABLE_ERROR.arg(filePath));
         }
@@ -1935,6 +2181,11 @@ and qmldir information.
 */
 void QQmlTypeLoader::clearCache()
 {
+    // Parse jobs for documents that were never loaded would otherwise be kept until the
+    // next load of the same URL.
+    cancelParseJobs();
+    m_startupDocument = 0;
+
     for (TypeCache::Iterator iter = m_typeCache.begin(), end = m_typeCache.end(); iter != end; ++iter)
         (*iter)->release();
     for (ScriptCache::Iterator iter = m_scriptCache.begin(), end = m_scriptCache.end(); iter != end; ++iter)
@@ -2187,6 +2438,8 @@ static bool addTypeReferenceChecksumsToHash(const QList<QQmlTypeData::TypeRefere
 
 void QQmlTypeData::done()
 {
+    typeLoader()->startupDocumentDone(this);
+
     QDeferredCleanup cleanup([this]{
         m_document.reset();
         m_typeReferences.clear();
@@ -2411,8 +2664,45 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
     continueLoadFromIR();
 }
 
+void QQmlTypeData::setParseErrors(const QList<QQmlJS::DiagnosticMessage> &diagnostics)
+{
+    QList<QQmlError> errors;
+    errors.reserve(diagnostics.count());
+    for (const QQmlJS::DiagnosticMessage &msg : diagnostics) {
+        QQmlError e;
+        e.setUrl(finalUrl());
+        e.setLine(msg.loc.startLine);
+        e.setColumn(msg.loc.startColumn);
+        e.setDescription(msg.message);
+        errors << e;
+    }
+    setError(errors);
+}
+
 bool QQmlTypeData::loadFromSource()
 {
+    QQmlStartupManifest::record(QQmlStartupManifest::QmlDocument, m_backupSourceCode.filePath());
+
+    QSharedPointer<QQmlTypeLoader::ParseJob> job = typeLoader()->takeParseJob(this);
+    if (job && job->source.filePath() != m_backupSourceCode.filePath()) {
+        job->cancelled.store(1);
+        job.clear();
+    }
+    if (job) {
+        job->wait();
+        if (!job->sourceError.isEmpty()) {
+            setError(job->sourceError);
+            return false;
+        }
+        if (!job->parsed) {
+            setParseErrors(job->errors);
+            return false;
+        }
+        m_document.reset(job->document.take());
+        m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+        return true;
+    }
+
     m_document.reset(new QmlIR::Document(isDebugging()));
     m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
     QQmlEngine *qmlEngine = typeLoader()->engine();
@@ -2426,17 +2716,7 @@ bool QQmlTypeData::loadFromSource()
     }
 
     if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
-        QList<QQmlError> errors;
-        errors.reserve(compiler.errors.count());
-        for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
-            QQmlError e;
-            e.setUrl(finalUrl());
-            e.setLine(msg.loc.startLine);
-            e.setColumn(msg.loc.startColumn);
-            e.setDescription(msg.message);
-            errors << e;
-        }
-        setError(errors);
+        setParseErrors(compiler.errors);
         return false;
     }
     return true;
@@ -2628,6 +2908,9 @@ void QQmlTypeData::resolveTypes()
         return lhs.qualifiedName() < rhs.qualifiedName();
     });
 
+    QVector<int> compositeTypeKeys;
+    QVector<QUrl> compositeTypeUrls;
+
     for (QV4::CompiledData::TypeReferenceMap::ConstIterator unresolvedRef = m_typeReferences.constBegin(), end = m_typeReferences.constEnd();
          unresolvedRef != end; ++unresolvedRef) {
 
@@ -2644,8 +2927,8 @@ void QQmlTypeData::resolveTypes()
             return;
 
         if (ref.type.isComposite()) {
-            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
-            addDependency(ref.typeData);
+            compositeTypeKeys << unresolvedRef.key();
+            compositeTypeUrls << ref.type.sourceUrl();
         }
         ref.majorVersion = majorVersion;
         ref.minorVersion = minorVersion;
@@ -2657,6 +2940,16 @@ void QQmlTypeData::resolveTypes()
 
         m_resolvedTypes.insert(unresolvedRef.key(), ref);
     }
+
+    // All composite types referenced here are independent of each other, so they can
+    // be parsed in parallel. They are still loaded, and therefore completed, in order.
+    typeLoader()->parseInBackground(compositeTypeUrls, isDebugging());
+
+    for (int i = 0; i < compositeTypeKeys.count(); ++i) {
+        TypeReference &ref = m_resolvedTypes[compositeTypeKeys.at(i)];
+        ref.typeData = typeLoader()->getType(compositeTypeUrls.at(i));
+        addDependency(ref.typeData);
+    }
 }
 
 QQmlCompileError QQmlTypeData::buildTypeResolutionCaches(
@@ -2935,6 +3228,8 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
     }
 
 
+    QQmlStartupManifest::record(QQmlStartupManifest::Script, data.filePath());
+
     QmlIR::Document irUnit(isDebugging());
 
     irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
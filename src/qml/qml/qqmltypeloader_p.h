@@ -56,6 +56,7 @@
 #include <QtCore/qatomic.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qcache.h>
+#include <QtCore/qsharedpointer.h>
 #if QT_CONFIG(qml_network)
 #include <QtNetwork/qnetworkreply.h>
 #endif
@@ -85,6 +86,7 @@ class QQmlTypeData;
 class QQmlTypeLoader;
 class QQmlExtensionInterface;
 class QQmlProfiler;
+class QThreadPool;
 struct QQmlCompileError;
 
 namespace QmlIR {
@@ -138,6 +140,7 @@ public:
         QString readAll(QString *error) const;
         QDateTime sourceTimeStamp() const;
         bool exists() const;
+        QString filePath() const { return fileInfo.filePath(); }
     private:
         friend class QQmlDataBlob;
         friend class QQmlTypeLoader;
@@ -354,6 +357,21 @@ private:
     void setData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::CachedQmlUnit *unit);
 
+    // Parsing of sibling QML documents on a thread pool, ahead of the load thread
+    // asking for them. Dependency resolution and type compilation stay on the load thread.
+    class ParseJob;
+    class ParseRunnable;
+    void parseInBackground(const QVector<QUrl> &urls, bool debugMode, bool fromStartupManifest = false);
+    QSharedPointer<ParseJob> takeParseJob(const QQmlDataBlob *blob);
+    void cancelParseJob(const QQmlDataBlob *blob);
+    void cancelParseJobs();
+    QUrl parseJobUrl(const QUrl &url) const;
+
+    // Replaying of a startup manifest recorded by an earlier run (QML_STARTUP_MANIFEST)
+    void startupPrefetch();
+    void prefetchThread(const QVector<QUrl> &urls);
+    void startupDocumentDone(QQmlTypeData *typeData);
+
     template<typename T>
     struct TypedCallback
     {
@@ -393,6 +411,11 @@ private:
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
 
+    QHash<QUrl, QSharedPointer<ParseJob> > m_parseJobs;
+    QScopedPointer<QThreadPool> m_parsePool;
+    bool m_startupPrefetchDone;
+    QQmlTypeData *m_startupDocument;
+
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
     void updateTypeCacheTrimThreshold();
@@ -400,6 +423,7 @@ private:
     friend struct PlainLoader;
     friend struct CachedLoader;
     friend struct StaticLoader;
+    friend class QQmlTypeData;
 };
 
 class Q_AUTOTEST_EXPORT QQmlTypeData : public QQmlTypeLoader::Blob
@@ -463,6 +487,7 @@ protected:
 private:
     bool tryLoadFromDiskCache();
     bool loadFromSource();
+    void setParseErrors(const QList<QQmlJS::DiagnosticMessage> &diagnostics);
     void restoreIR(QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit);
     void continueLoadFromIR();
     void resolveTypes();
@@ -85,6 +85,97 @@ static void list_clear(QQmlListProperty<QObject> *prop)
     static_cast<QQmlVMEMetaObject *>(prop->dummy1)->activate(prop->object, reinterpret_cast<quintptr>(prop->dummy2), 0);
 }
 
+// Returns whether properties of type \a t are kept in QQmlVMEMetaObject::typedStorage,
+// and if so the size and alignment of their slot.
+static bool isTypedStorageType(QV4::CompiledData::Property::Type t, int *size, int *alignment)
+{
+    switch (t) {
+    case QV4::CompiledData::Property::Int:
+        *size = sizeof(int);
+        *alignment = Q_ALIGNOF(int);
+        return true;
+    case QV4::CompiledData::Property::Bool:
+        *size = sizeof(bool);
+        *alignment = Q_ALIGNOF(bool);
+        return true;
+    case QV4::CompiledData::Property::Real:
+        *size = sizeof(double);
+        *alignment = Q_ALIGNOF(double);
+        return true;
+    case QV4::CompiledData::Property::String:
+        *size = sizeof(QString);
+        *alignment = Q_ALIGNOF(QString);
+        return true;
+    case QV4::CompiledData::Property::Font:
+    case QV4::CompiledData::Property::Time:
+    case QV4::CompiledData::Property::Color:
+    case QV4::CompiledData::Property::Vector2D:
+    case QV4::CompiledData::Property::Vector3D:
+    case QV4::CompiledData::Property::Vector4D:
+    case QV4::CompiledData::Property::Matrix4x4:
+    case QV4::CompiledData::Property::Quaternion:
+        // QtQml cannot use the QtGui types directly, so these are held in a QVariant
+        // and handled through the value type provider.
+        *size = sizeof(QVariant);
+        *alignment = Q_ALIGNOF(QVariant);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static const QV4::CompiledData::CompilationUnit::PropertyStorageLayout *propertyStorageLayout(QV4::CompiledData::CompilationUnit *compilationUnit, int objectIndex)
+{
+    if (compilationUnit->propertyStorageLayoutPerObject.isEmpty())
+        compilationUnit->propertyStorageLayoutPerObject.resize(compilationUnit->objectCount());
+
+    QV4::CompiledData::CompilationUnit::PropertyStorageLayout &layout = compilationUnit->propertyStorageLayoutPerObject[objectIndex];
+    if (layout.initialized)
+        return &layout;
+
+    const QV4::CompiledData::Object *obj = compilationUnit->objectAt(objectIndex);
+    const QV4::CompiledData::Property *propertyTable = obj->propertyTable();
+    layout.storageIndex.resize(obj->nProperties);
+    for (quint32 i = 0; i < obj->nProperties; ++i) {
+        const QV4::CompiledData::Property::Type t = static_cast<QV4::CompiledData::Property::Type>(qint32(propertyTable[i].type));
+        int size = 0;
+        int alignment = 0;
+        if (isTypedStorageType(t, &size, &alignment)) {
+            layout.typedStorageSize = (layout.typedStorageSize + alignment - 1) & ~(alignment - 1);
+            layout.storageIndex[i] = layout.typedStorageSize;
+            layout.typedStorageSize += size;
+        } else {
+            layout.storageIndex[i] = layout.memberDataPropertyCount++;
+        }
+    }
+    layout.initialized = true;
+    return &layout;
+}
+
+static int valueTypeFallbackMetaType(QV4::CompiledData::Property::Type t)
+{
+    switch (t) {
+    case QV4::CompiledData::Property::Font:
+        return QMetaType::QFont;
+    case QV4::CompiledData::Property::Time:
+        return QMetaType::QTime;
+    case QV4::CompiledData::Property::Color:
+        return QMetaType::QColor;
+    case QV4::CompiledData::Property::Vector2D:
+        return QMetaType::QVector2D;
+    case QV4::CompiledData::Property::Vector3D:
+        return QMetaType::QVector3D;
+    case QV4::CompiledData::Property::Vector4D:
+        return QMetaType::QVector4D;
+    case QV4::CompiledData::Property::Matrix4x4:
+        return QMetaType::QMatrix4x4;
+    case QV4::CompiledData::Property::Quaternion:
+        return QMetaType::QQuaternion;
+    default:
+        return QMetaType::UnknownType;
+    }
+}
+
 QQmlVMEVariantQObjectPtr::QQmlVMEVariantQObjectPtr()
     : QQmlGuard<QObject>(0), m_target(0), m_index(-1)
 {
@@ -105,7 +196,7 @@ void QQmlVMEVariantQObjectPtr::objectDestroyed(QObject *)
             QV4::Scope scope(v4);
             QV4::Scoped<QV4::MemberData> sp(scope, m_target->propertyAndMethodStorage.value());
             if (sp)
-                *(sp->data() + m_index) = QV4::Primitive::nullValue();
+                *(sp->data() + m_target->memberDataIndex(m_index)) = QV4::Primitive::nullValue();
         }
 
         m_target->activate(m_target->object, m_target->methodOffset() + m_index, 0);
@@ -317,7 +408,7 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QV4::ExecutionEngine *engine,
     : QQmlInterceptorMetaObject(obj, cache),
       engine(engine),
       ctxt(QQmlData::get(obj, true)->outerContext),
-      aliasEndpoints(0), compilationUnit(qmlCompilationUnit), compiledObject(0)
+      aliasEndpoints(0), storageLayout(0), typedStorage(0), compilationUnit(qmlCompilationUnit), compiledObject(0)
 {
     Q_ASSERT(engine);
     QQmlData::get(obj)->hasVMEMetaObject = true;
@@ -325,8 +416,36 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QV4::ExecutionEngine *engine,
     if (compilationUnit && qmlObjectId >= 0) {
         compiledObject = compilationUnit->data->objectAt(qmlObjectId);
 
+        if (compiledObject->nProperties) {
+            storageLayout = propertyStorageLayout(compilationUnit, qmlObjectId);
+            if (storageLayout->typedStorageSize) {
+                typedStorage = static_cast<char *>(malloc(storageLayout->typedStorageSize));
+                const QV4::CompiledData::Property *propertyTable = compiledObject->propertyTable();
+                for (quint32 i = 0; i < compiledObject->nProperties; ++i) {
+                    switch (propertyTable[i].type) {
+                    case QV4::CompiledData::Property::Int:
+                        new (typedProperty<int>(i)) int(0);
+                        break;
+                    case QV4::CompiledData::Property::Bool:
+                        new (typedProperty<bool>(i)) bool(false);
+                        break;
+                    case QV4::CompiledData::Property::Real:
+                        new (typedProperty<double>(i)) double(0.0);
+                        break;
+                    case QV4::CompiledData::Property::String:
+                        new (typedProperty<QString>(i)) QString();
+                        break;
+                    default:
+                        if (valueTypeFallbackMetaType(static_cast<QV4::CompiledData::Property::Type>(qint32(propertyTable[i].type))) != QMetaType::UnknownType)
+                            new (typedProperty<QVariant>(i)) QVariant();
+                        break;
+                    }
+                }
+            }
+        }
+
         if (compiledObject->nProperties || compiledObject->nFunctions) {
-            uint size = compiledObject->nProperties + compiledObject->nFunctions;
+            uint size = (storageLayout ? storageLayout->memberDataPropertyCount : 0) + compiledObject->nFunctions;
             if (size) {
                 QV4::Heap::MemberData *data = QV4::MemberData::allocate(engine, size);
                 propertyAndMethodStorage.set(engine, data);
@@ -345,6 +464,17 @@ QQmlVMEMetaObject::~QQmlVMEMetaObject()
     delete [] aliasEndpoints;
 
     qDeleteAll(varObjectGuards);
+
+    if (typedStorage) {
+        const QV4::CompiledData::Property *propertyTable = compiledObject->propertyTable();
+        for (quint32 i = 0; i < compiledObject->nProperties; ++i) {
+            if (propertyTable[i].type == QV4::CompiledData::Property::String)
+                typedProperty<QString>(i)->~QString();
+            else if (valueTypeFallbackMetaType(static_cast<QV4::CompiledData::Property::Type>(qint32(propertyTable[i].type))) != QMetaType::UnknownType)
+                typedProperty<QVariant>(i)->~QVariant();
+        }
+        free(typedStorage);
+    }
 }
 
 QV4::MemberData *QQmlVMEMetaObject::propertyAndMethodStorageAsMemberData() const
@@ -363,79 +493,71 @@ QV4::MemberData *QQmlVMEMetaObject::propertyAndMethodStorageAsMemberData() const
 
 void QQmlVMEMetaObject::writeProperty(int id, int v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (md)
-        *(md->data() + id) = QV4::Primitive::fromInt32(v);
+    *typedProperty<int>(id) = v;
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, bool v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (md)
-        *(md->data() + id) = QV4::Primitive::fromBoolean(v);
+    *typedProperty<bool>(id) = v;
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, double v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (md)
-        *(md->data() + id) = QV4::Primitive::fromDouble(v);
+    *typedProperty<double>(id) = v;
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QString& v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (md)
-        *(md->data() + id) = engine->newString(v);
+    *typedProperty<QString>(id) = v;
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QUrl& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QDate& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QDateTime& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QPointF& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QSizeF& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QRectF& v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = engine->newVariantObject(QVariant::fromValue(v));
+        *(md->data() + memberDataIndex(id)) = engine->newVariantObject(QVariant::fromValue(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, QObject* v)
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        *(md->data() + id) = QV4::QObjectWrapper::wrap(engine, v);
+        *(md->data() + memberDataIndex(id)) = QV4::QObjectWrapper::wrap(engine, v);
 
     QQmlVMEVariantQObjectPtr *guard = getQObjectGuardForProperty(id);
     if (v && !guard) {
@@ -448,54 +570,22 @@ void QQmlVMEMetaObject::writeProperty(int id, QObject* v)
 
 int QQmlVMEMetaObject::readPropertyAsInt(int id) const
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (!md)
-        return 0;
-
-    QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
-    if (!sv->isInt32())
-        return 0;
-    return sv->integerValue();
+    return *typedProperty<int>(id);
 }
 
 bool QQmlVMEMetaObject::readPropertyAsBool(int id) const
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (!md)
-        return false;
-
-    QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
-    if (!sv->isBoolean())
-        return false;
-    return sv->booleanValue();
+    return *typedProperty<bool>(id);
 }
 
 double QQmlVMEMetaObject::readPropertyAsDouble(int id) const
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (!md)
-        return 0.0;
-
-    QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
-    if (!sv->isDouble())
-        return 0.0;
-    return sv->doubleValue();
+    return *typedProperty<double>(id);
 }
 
 QString QQmlVMEMetaObject::readPropertyAsString(int id) const
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
-    if (!md)
-        return QString();
-
-    QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
-    if (QV4::String *s = sv->stringValue())
-        return s->toQString();
-    return QString();
+    return *typedProperty<QString>(id);
 }
 
 QUrl QQmlVMEMetaObject::readPropertyAsUrl(int id) const
@@ -505,7 +595,7 @@ QUrl QQmlVMEMetaObject::readPropertyAsUrl(int id) const
         return QUrl();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::Url)
         return QUrl();
@@ -519,7 +609,7 @@ QDate QQmlVMEMetaObject::readPropertyAsDate(int id) const
         return QDate();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::Date)
         return QDate();
@@ -533,7 +623,7 @@ QDateTime QQmlVMEMetaObject::readPropertyAsDateTime(int id)
         return QDateTime();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::DateTime)
         return QDateTime();
@@ -547,7 +637,7 @@ QSizeF QQmlVMEMetaObject::readPropertyAsSizeF(int id) const
         return QSizeF();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::SizeF)
         return QSizeF();
@@ -561,7 +651,7 @@ QPointF QQmlVMEMetaObject::readPropertyAsPointF(int id) const
         return QPointF();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::PointF)
         return QPointF();
@@ -575,7 +665,7 @@ QObject* QQmlVMEMetaObject::readPropertyAsQObject(int id) const
         return 0;
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::QObjectWrapper *wrapper = sv->as<QV4::QObjectWrapper>();
     if (!wrapper)
         return 0;
@@ -589,11 +679,11 @@ QList<QObject *> *QQmlVMEMetaObject::readPropertyAsList(int id) const
         return 0;
 
     QV4::Scope scope(engine);
-    QV4::Scoped<QV4::VariantObject> v(scope, *(md->data() + id));
+    QV4::Scoped<QV4::VariantObject> v(scope, *(md->data() + memberDataIndex(id)));
     if (!v || (int)v->d()->data().userType() != qMetaTypeId<QList<QObject *> >()) {
         QVariant variant(qVariantFromValue(QList<QObject*>()));
         v = engine->newVariantObject(variant);
-        *(md->data() + id) = v;
+        *(md->data() + memberDataIndex(id)) = v;
     }
     return static_cast<QList<QObject *> *>(v->d()->data().data());
 }
@@ -605,7 +695,7 @@ QRectF QQmlVMEMetaObject::readPropertyAsRectF(int id) const
         return QRectF();
 
     QV4::Scope scope(engine);
-    QV4::ScopedValue sv(scope, *(md->data() + id));
+    QV4::ScopedValue sv(scope, *(md->data() + memberDataIndex(id)));
     const QV4::VariantObject *v = sv->as<QV4::VariantObject>();
     if (!v || v->d()->data().type() != QVariant::RectF)
         return QRectF();
@@ -653,34 +743,7 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                     }
 
                 } else {
-                    int fallbackMetaType = QMetaType::UnknownType;
-                    switch (t) {
-                    case QV4::CompiledData::Property::Font:
-                        fallbackMetaType = QMetaType::QFont;
-                        break;
-                    case QV4::CompiledData::Property::Time:
-                        fallbackMetaType = QMetaType::QTime;
-                        break;
-                    case QV4::CompiledData::Property::Color:
-                        fallbackMetaType = QMetaType::QColor;
-                        break;
-                    case QV4::CompiledData::Property::Vector2D:
-                        fallbackMetaType = QMetaType::QVector2D;
-                        break;
-                    case QV4::CompiledData::Property::Vector3D:
-                        fallbackMetaType = QMetaType::QVector3D;
-                        break;
-                    case QV4::CompiledData::Property::Vector4D:
-                        fallbackMetaType = QMetaType::QVector4D;
-                        break;
-                    case QV4::CompiledData::Property::Matrix4x4:
-                        fallbackMetaType = QMetaType::QMatrix4x4;
-                        break;
-                    case QV4::CompiledData::Property::Quaternion:
-                        fallbackMetaType = QMetaType::QQuaternion;
-                        break;
-                    default: break;
-                    }
+                    const int fallbackMetaType = valueTypeFallbackMetaType(t);
 
 
                     if (c == QMetaObject::ReadProperty) {
@@ -740,12 +803,7 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                         case QV4::CompiledData::Property::Matrix4x4:
                         case QV4::CompiledData::Property::Quaternion:
                             Q_ASSERT(fallbackMetaType != QMetaType::UnknownType);
-                            if (QV4::MemberData *md = propertyAndMethodStorageAsMemberData()) {
-                                QVariant propertyAsVariant;
-                                if (QV4::VariantObject *v = (md->data() + id)->as<QV4::VariantObject>())
-                                    propertyAsVariant = v->d()->data();
-                                QQml_valueTypeProvider()->readValueType(propertyAsVariant, a[0], fallbackMetaType);
-                            }
+                            QQml_valueTypeProvider()->readValueType(*typedProperty<QVariant>(id), a[0], fallbackMetaType);
                             break;
                         case QV4::CompiledData::Property::Var:
                             Q_UNREACHABLE();
@@ -813,18 +871,15 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                         case QV4::CompiledData::Property::Vector4D:
                         case QV4::CompiledData::Property::Matrix4x4:
                         case QV4::CompiledData::Property::Quaternion:
+                        {
                             Q_ASSERT(fallbackMetaType != QMetaType::UnknownType);
-                            if (QV4::MemberData *md = propertyAndMethodStorageAsMemberData()) {
-                                QV4::VariantObject *v = (md->data() + id)->as<QV4::VariantObject>();
-                                if (!v) {
-                                    *(md->data() + id) = engine->newVariantObject(QVariant());
-                                    v = (md->data() + id)->as<QV4::VariantObject>();
-                                    QQml_valueTypeProvider()->initValueType(fallbackMetaType, v->d()->data());
-                                }
-                                needActivate = !QQml_valueTypeProvider()->equalValueType(fallbackMetaType, a[0], v->d()->data());
-                                QQml_valueTypeProvider()->writeValueType(fallbackMetaType, a[0], v->d()->data());
-                            }
+                            QVariant *v = typedProperty<QVariant>(id);
+                            if (!v->isValid())
+                                QQml_valueTypeProvider()->initValueType(fallbackMetaType, *v);
+                            needActivate = !QQml_valueTypeProvider()->equalValueType(fallbackMetaType, a[0], *v);
+                            QQml_valueTypeProvider()->writeValueType(fallbackMetaType, a[0], *v);
                             break;
+                        }
                         case QV4::CompiledData::Property::Var:
                             Q_UNREACHABLE();
                         }
@@ -990,7 +1045,7 @@ QV4::ReturnedValue QQmlVMEMetaObject::method(int index) const
     if (!md)
         return QV4::Encode::undefined();
 
-    return (md->data() + index + compiledObject->nProperties)->asReturnedValue();
+    return (md->data() + memberDataMethodIndex(index))->asReturnedValue();
 }
 
 QV4::ReturnedValue QQmlVMEMetaObject::readVarProperty(int id) const
@@ -999,7 +1054,7 @@ QV4::ReturnedValue QQmlVMEMetaObject::readVarProperty(int id) const
 
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md)
-        return (md->data() + id)->asReturnedValue();
+        return (md->data() + memberDataIndex(id))->asReturnedValue();
     return QV4::Primitive::undefinedValue().asReturnedValue();
 }
 
@@ -1007,13 +1062,13 @@ QVariant QQmlVMEMetaObject::readPropertyAsVariant(int id) const
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (md) {
-        const QV4::QObjectWrapper *wrapper = (md->data() + id)->as<QV4::QObjectWrapper>();
+        const QV4::QObjectWrapper *wrapper = (md->data() + memberDataIndex(id))->as<QV4::QObjectWrapper>();
         if (wrapper)
             return QVariant::fromValue(wrapper->object());
-        const QV4::VariantObject *v = (md->data() + id)->as<QV4::VariantObject>();
+        const QV4::VariantObject *v = (md->data() + memberDataIndex(id))->as<QV4::VariantObject>();
         if (v)
             return v->d()->data();
-        return engine->toVariant(*(md->data() + id), -1);
+        return engine->toVariant(*(md->data() + memberDataIndex(id)), -1);
     }
     return QVariant();
 }
@@ -1028,7 +1083,7 @@ void QQmlVMEMetaObject::writeVarProperty(int id, const QV4::Value &value)
 
     // Importantly, if the current value is a scarce resource, we need to ensure that it
     // gets automatically released by the engine if no other references to it exist.
-    QV4::VariantObject *oldVariant = (md->data() + id)->as<QV4::VariantObject>();
+    QV4::VariantObject *oldVariant = (md->data() + memberDataIndex(id))->as<QV4::VariantObject>();
     if (oldVariant)
         oldVariant->removeVmePropertyReference();
 
@@ -1054,7 +1109,7 @@ void QQmlVMEMetaObject::writeVarProperty(int id, const QV4::Value &value)
         guard->setGuardedValue(valueObject, this, id);
 
     // Write the value and emit change signal as appropriate.
-    *(md->data() + id) = value;
+    *(md->data() + memberDataIndex(id)) = value;
     activate(object, methodOffset() + id, 0);
 }
 
@@ -1067,7 +1122,7 @@ void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
 
         // Importantly, if the current value is a scarce resource, we need to ensure that it
         // gets automatically released by the engine if no other references to it exist.
-        QV4::VariantObject *oldv = (md->data() + id)->as<QV4::VariantObject>();
+        QV4::VariantObject *oldv = (md->data() + memberDataIndex(id))->as<QV4::VariantObject>();
         if (oldv)
             oldv->removeVmePropertyReference();
 
@@ -1081,7 +1136,7 @@ void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
 
         // Write the value and emit change signal as appropriate.
         QVariant currentValue = readPropertyAsVariant(id);
-        *(md->data() + id) = newv;
+        *(md->data() + memberDataIndex(id)) = newv;
         if ((currentValue.userType() != value.userType() || currentValue != value))
             activate(object, methodOffset() + id, 0);
     } else {
@@ -1093,14 +1148,14 @@ void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
         } else {
             QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
             if (md) {
-                QV4::VariantObject *v = (md->data() + id)->as<QV4::VariantObject>();
+                QV4::VariantObject *v = (md->data() + memberDataIndex(id))->as<QV4::VariantObject>();
                 needActivate = (!v ||
                                  v->d()->data().userType() != value.userType() ||
                                  v->d()->data() != value);
                 if (v)
                     v->removeVmePropertyReference();
-                *(md->data() + id) = engine->newVariantObject(value);
-                v = static_cast<QV4::VariantObject *>(md->data() + id);
+                *(md->data() + memberDataIndex(id)) = engine->newVariantObject(value);
+                v = static_cast<QV4::VariantObject *>(md->data() + memberDataIndex(id));
                 v->addVmePropertyReference();
             }
         }
@@ -1139,7 +1194,7 @@ void QQmlVMEMetaObject::setVmeMethod(int index, const QV4::Value &function)
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (!md)
         return;
-    *(md->data() + methodIndex + compiledObject->nProperties) = function;
+    *(md->data() + memberDataMethodIndex(methodIndex)) = function;
 }
 
 QV4::ReturnedValue QQmlVMEMetaObject::vmeProperty(int index) const
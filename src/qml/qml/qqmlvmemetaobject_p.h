@@ -179,6 +179,14 @@ public:
     QV4::WeakValue propertyAndMethodStorage;
     QV4::MemberData *propertyAndMethodStorageAsMemberData() const;
 
+    // int, bool, real, string and value type properties are kept unboxed in typedStorage,
+    // all other properties and the methods in propertyAndMethodStorage.
+    const QV4::CompiledData::CompilationUnit::PropertyStorageLayout *storageLayout;
+    char *typedStorage;
+    inline int memberDataIndex(int id) const;
+    inline int memberDataMethodIndex(int methodIndex) const;
+    template <typename T> inline T *typedProperty(int id) const;
+
     int readPropertyAsInt(int id) const;
     bool readPropertyAsBool(int id) const;
     double readPropertyAsDouble(int id) const;
@@ -264,6 +272,23 @@ int QQmlVMEMetaObject::signalCount() const
     return cache->signalCount();
 }
 
+int QQmlVMEMetaObject::memberDataIndex(int id) const
+{
+    return storageLayout ? storageLayout->storageIndex.at(id) : id;
+}
+
+int QQmlVMEMetaObject::memberDataMethodIndex(int methodIndex) const
+{
+    return (storageLayout ? storageLayout->memberDataPropertyCount : 0) + methodIndex;
+}
+
+template <typename T>
+T *QQmlVMEMetaObject::typedProperty(int id) const
+{
+    Q_ASSERT(storageLayout && typedStorage);
+    return reinterpret_cast<T *>(typedStorage + storageLayout->storageIndex.at(id));
+}
+
 QQmlVMEMetaObject *QQmlVMEMetaObject::parentVMEMetaObject() const
 {
     if (parent.isT1() && parent.flag())
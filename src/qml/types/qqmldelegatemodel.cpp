@@ -53,8 +53,17 @@
 #include <private/qv4functionobject_p.h>
 #include <qv4objectiterator_p.h>
 
+#include <QtCore/qdatetime.h>
+#include <QtCore/qregularexpression.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+// Above this many moves, sorting a group is reported to views as a reset rather than as the
+// individual moves, which are expensive to merge into a change set.
+static const int qt_maximumSortMoves = 100;
+
 class QQmlDelegateModelItem;
 
 namespace QV4 {
@@ -264,6 +273,18 @@ QQmlDelegateModel::~QQmlDelegateModel()
 {
     Q_D(QQmlDelegateModel);
 
+    for (QQmlDelegateModelItem *cacheItem : qAsConst(d->m_reusableItemsPool)) {
+        delete cacheItem->object;
+
+        cacheItem->object = 0;
+        cacheItem->contextData->invalidate();
+        Q_ASSERT(cacheItem->contextData->refCount == 1);
+        cacheItem->contextData = 0;
+        cacheItem->scriptRef -= 1;
+        delete cacheItem;
+    }
+    d->m_reusableItemsPool.clear();
+
     for (QQmlDelegateModelItem *cacheItem : qAsConst(d->m_cache)) {
         if (cacheItem->object) {
             delete cacheItem->object;
@@ -344,6 +365,7 @@ void QQmlDelegateModel::componentComplete()
             defaultGroups | Compositor::AppendFlag | Compositor::PrependFlag,
             &inserts);
     d->itemsInserted(inserts);
+    d->sortAndFilterItems();
     d->emitChanges();
     d->requestMoreIfNecessary();
 }
@@ -372,6 +394,9 @@ void QQmlDelegateModel::setModel(const QVariant &model)
 {
     Q_D(QQmlDelegateModel);
 
+    // Pooled items are bound to the roles of the old model.
+    d->drainReusableItemsPool(0);
+
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
@@ -408,6 +433,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         qmlWarning(this) << tr("The delegate of a DelegateModel cannot be changed within onUpdated.");
         return;
     }
+    d->drainReusableItemsPool(0);
     bool wasValid = d->m_delegate != 0;
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
@@ -468,6 +494,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     QModelIndex modelIndex = qvariant_cast<QModelIndex>(root);
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
+        d->drainReusableItemsPool(0);
         const int oldCount = d->m_count;
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
@@ -534,22 +561,36 @@ int QQmlDelegateModel::count() const
     return d->m_compositor.count(d->m_compositorGroup);
 }
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(
+        QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
+    Q_Q(QQmlDelegateModel);
     QQmlDelegateModel::ReleaseFlags stat = 0;
     if (!object)
         return stat;
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
-            cacheItem->destroyObject();
-            emitDestroyingItem(object);
-            if (cacheItem->incubationTask) {
-                releaseIncubator(cacheItem->incubationTask);
-                cacheItem->incubationTask = 0;
+            if (reusableFlag == QQmlInstanceModel::Reusable && isReusable(cacheItem)) {
+                // Keep the object and its context alive, but detach the item from its row so
+                // that takeReusableItem() can bind it to another one.
+                const int index = cacheItem->groupIndex(m_compositorGroup);
+                removeCacheItem(cacheItem);
+                cacheItem->groups = 0;
+                cacheItem->poolTime = 0;
+                m_reusableItemsPool.append(cacheItem);
+                Q_EMIT q->itemPooled(index, object);
+                stat |= QQmlInstanceModel::Pooled;
+            } else {
+                cacheItem->destroyObject();
+                emitDestroyingItem(object);
+                if (cacheItem->incubationTask) {
+                    releaseIncubator(cacheItem->incubationTask);
+                    cacheItem->incubationTask = 0;
+                }
+                cacheItem->Dispose();
+                stat |= QQmlInstanceModel::Destroyed;
             }
-            cacheItem->Dispose();
-            stat |= QQmlInstanceModel::Destroyed;
         } else {
             stat |= QQmlDelegateModel::Referenced;
         }
@@ -557,17 +598,88 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
     return stat;
 }
 
+/*
+  An item can only be pooled if nothing but its delegate object refers to it: it must be
+  bound to a row of the source model, must not be referenced from script or through the
+  DelegateModel attached object, and the delegate must not depend on a proxied QObject.
+*/
+bool QQmlDelegateModelPrivate::isReusable(QQmlDelegateModelItem *cacheItem) const
+{
+    return cacheItem->scriptRef == 1
+            && !cacheItem->incubationTask
+            && !cacheItem->attached
+            && cacheItem->modelIndex() != -1
+            && !m_adaptorModel.hasProxyObject()
+            && !qmlobject_cast<QQuickPackage *>(cacheItem->object);
+}
+
+QQmlDelegateModelItem *QQmlDelegateModelPrivate::takeReusableItem(int modelIndex)
+{
+    while (!m_reusableItemsPool.isEmpty()) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItemsPool.takeLast();
+        if (cacheItem->object && cacheItem->rebind(m_adaptorModel, modelIndex))
+            return cacheItem;
+        destroyReusableItem(cacheItem);
+    }
+    return 0;
+}
+
+void QQmlDelegateModelPrivate::destroyReusableItem(QQmlDelegateModelItem *cacheItem)
+{
+    if (QObject *object = cacheItem->object) {
+        cacheItem->destroyObject();
+        emitDestroyingItem(object);
+    }
+    cacheItem->Dispose();
+}
+
+void QQmlDelegateModelPrivate::drainReusableItemsPool(int maxPoolTime)
+{
+    QList<QQmlDelegateModelItem *> expired;
+    for (int i = 0; i < m_reusableItemsPool.count();) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItemsPool.at(i);
+        if (++cacheItem->poolTime > maxPoolTime) {
+            expired.append(cacheItem);
+            m_reusableItemsPool.removeAt(i);
+        } else {
+            ++i;
+        }
+    }
+
+    for (QQmlDelegateModelItem *cacheItem : qAsConst(expired))
+        destroyReusableItem(cacheItem);
+}
+
 /*
   Returns ReleaseStatus flags.
+
+  If \a reusableFlag is Reusable the object may be kept in a pool instead of being
+  destroyed, and handed out again by a later call to object() for another index.
 */
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item, ReusableFlag reusableFlag)
 {
     Q_D(QQmlDelegateModel);
-    QQmlInstanceModel::ReleaseFlags stat = d->release(item);
+    QQmlInstanceModel::ReleaseFlags stat = d->release(item, reusableFlag);
     return stat;
 }
 
+/*
+  Destroys the pooled objects that have not been reused during the last \a maxPoolTime
+  calls to this function.
+*/
+void QQmlDelegateModel::drainReusableItemsPool(int maxPoolTime)
+{
+    Q_D(QQmlDelegateModel);
+    d->drainReusableItemsPool(maxPoolTime);
+}
+
+int QQmlDelegateModel::poolSize()
+{
+    Q_D(QQmlDelegateModel);
+    return d->m_reusableItemsPool.count();
+}
+
 // Cancel a requested async item
 void QQmlDelegateModel::cancel(int index)
 {
@@ -943,9 +1055,15 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     Compositor::iterator it = m_compositor.find(group, index);
 
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
+    bool reused = false;
 
     if (!cacheItem) {
-        cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
+        if (!m_reusableItemsPool.isEmpty() && it.list<QQmlAdaptorModel>()) {
+            cacheItem = takeReusableItem(it.modelIndex());
+            reused = cacheItem != 0;
+        }
+        if (!cacheItem)
+            cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
         if (!cacheItem)
             return 0;
 
@@ -961,6 +1079,9 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     cacheItem->scriptRef += 1;
     cacheItem->referenceObject();
 
+    if (reused)
+        Q_EMIT q_func()->itemReused(it.index[m_compositorGroup], cacheItem->object);
+
     if (cacheItem->incubationTask) {
         if (!asynchronous && cacheItem->incubationTask->incubationMode() == QQmlIncubator::Asynchronous) {
             // previously requested async - now needed immediately
@@ -1149,18 +1270,35 @@ void QQmlDelegateModelPrivate::itemsChanged(const QVector<Compositor::Change> &c
         QQmlDelegateModelGroupPrivate::get(m_groups[i])->changeSet.change(translatedChanges.at(i));
 }
 
+template <typename Change>
+static QVector<QQmlChangeSet::Change> defaultGroupItems(const QVector<Change> &changes)
+{
+    QVector<QQmlChangeSet::Change> items;
+    for (const Change &change : changes) {
+        if (change.inGroup(Compositor::Default))
+            items.append(QQmlChangeSet::Change(change.index[Compositor::Default], change.count));
+    }
+    return items;
+}
+
 void QQmlDelegateModel::_q_itemsChanged(int index, int count, const QVector<int> &roles)
 {
     Q_D(QQmlDelegateModel);
     if (count <= 0 || !d->m_complete)
         return;
 
-    if (d->m_adaptorModel.notify(d->m_cache, index, count, roles)) {
-        QVector<Compositor::Change> changes;
-        d->m_compositor.listItemsChanged(&d->m_adaptorModel, index, count, &changes);
+    const bool notified = d->m_adaptorModel.notify(d->m_cache, index, count, roles);
+    const bool resort = d->isSortedOrFiltered() && d->affectsSortOrFilter(roles);
+    if (!notified && !resort)
+        return;
+
+    QVector<Compositor::Change> changes;
+    d->m_compositor.listItemsChanged(&d->m_adaptorModel, index, count, &changes);
+    if (notified)
         d->itemsChanged(changes);
-        d->emitChanges();
-    }
+    if (resort)
+        d->sortAndFilterItems(defaultGroupItems(changes));
+    d->emitChanges();
 }
 
 static void incrementIndexes(QQmlDelegateModelItem *cacheItem, int count, const int *deltas)
@@ -1263,6 +1401,7 @@ void QQmlDelegateModel::_q_itemsInserted(int index, int count)
     QVector<Compositor::Insert> inserts;
     d->m_compositor.listItemsInserted(&d->m_adaptorModel, index, count, &inserts);
     d->itemsInserted(inserts);
+    d->sortAndFilterItems(defaultGroupItems(inserts));
     d->emitChanges();
 }
 
@@ -1433,6 +1572,325 @@ void QQmlDelegateModelPrivate::itemsMoved(
     }
 }
 
+QVariant QQmlDelegateModelPrivate::itemValue(const Compositor::iterator &it, const QString &role)
+{
+    if (QQmlAdaptorModel *model = it.list<QQmlAdaptorModel>())
+        return model->value(it.modelIndex(), role);
+    return QVariant();
+}
+
+/*
+    Adds the \a count items of the default group starting at \a from to \a group if they
+    are accepted by its filter, and removes them from it otherwise.  If the group isn't
+    filtered the items are added to it if it includes items by default.
+*/
+void QQmlDelegateModelPrivate::filterItems(Compositor::Group group, int from, int count)
+{
+    if (count <= 0)
+        return;
+
+    QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[group]);
+    const uint groupFlag = 1 << group;
+
+    QVector<bool> accepted(count, groupPrivate->defaultInclude);
+    if (groupPrivate->isFiltered()) {
+        Compositor::iterator it = m_compositor.find(Compositor::Default, from);
+        for (int i = 0; i < count; ++i, it += 1)
+            accepted[i] = groupPrivate->filterAcceptsValue(itemValue(it, groupPrivate->filterRole));
+    }
+
+    // Adding items to or removing them from the group doesn't change their indexes in the
+    // default group.
+    for (int i = 0; i < count;) {
+        int end = i + 1;
+        while (end < count && accepted.at(end) == accepted.at(i))
+            ++end;
+        if (accepted.at(i)) {
+            QVector<Compositor::Insert> inserts;
+            m_compositor.setFlags(Compositor::Default, from + i, end - i, groupFlag, &inserts);
+            itemsInserted(inserts);
+        } else {
+            QVector<Compositor::Remove> removes;
+            m_compositor.clearFlags(Compositor::Default, from + i, end - i, groupFlag, &removes);
+            itemsRemoved(removes);
+        }
+        i = end;
+    }
+}
+
+namespace {
+
+// Counts the marked positions before an index in O(log n).
+class QQmlSortCounter
+{
+public:
+    explicit QQmlSortCounter(int count) : m_tree(count + 1, 0) {}
+
+    void add(int index, int difference)
+    {
+        for (++index; index < m_tree.count(); index += index & -index)
+            m_tree[index] += difference;
+    }
+
+    int countBefore(int index) const
+    {
+        int count = 0;
+        for (; index > 0; index -= index & -index)
+            count += m_tree.at(index);
+        return count;
+    }
+
+private:
+    QVector<int> m_tree;
+};
+
+}
+
+/*
+    Moves the items of \a group into the order of its sort role.
+
+    The items in the longest sequence that is already in order stay where they are; the others
+    are moved one at a time in sort order to just after the item that precedes them.  The
+    current index of an item is the number of items already in their final place before it,
+    plus the number of items still to move that are before it, both of which are counted in
+    O(log n), so a group that is nearly in order is sorted with few moves.
+*/
+void QQmlDelegateModelPrivate::sortItems(Compositor::Group group)
+{
+    QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[group]);
+    const int count = m_compositor.count(group);
+    if (count < 2)
+        return;
+
+    QVector<QVariant> keys(count);
+    Compositor::iterator it = m_compositor.find(group, 0);
+    for (int i = 0; i < count; ++i, it += 1)
+        keys[i] = itemValue(it, groupPrivate->sortRole);
+
+    // order lists the current indexes of the items in sort order, rank is its inverse.
+    QVector<int> order(count);
+    for (int i = 0; i < count; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&keys, groupPrivate](int left, int right) {
+        return groupPrivate->lessThan(keys.at(left), keys.at(right));
+    });
+    QVector<int> rank(count);
+    for (int i = 0; i < count; ++i)
+        rank[order.at(i)] = i;
+
+    // Find the longest sequence of items whose ranks are increasing.
+    QVector<int> tails;
+    QVector<int> previous(count);
+    for (int i = 0; i < count; ++i) {
+        QVector<int>::iterator tail = std::lower_bound(
+                tails.begin(), tails.end(), rank.at(i),
+                [&rank](int item, int itemRank) { return rank.at(item) < itemRank; });
+        previous[i] = tail == tails.begin() ? -1 : *(tail - 1);
+        if (tail == tails.end())
+            tails.append(i);
+        else
+            *tail = i;
+    }
+    if (tails.count() == count)
+        return;
+
+    QVector<int> kept(tails.count());
+    QVector<int> anchor(count, -1);    // The kept item a moved item follows, or -1 for the start.
+    QQmlSortCounter settled(count);    // By rank, the items in their final place.
+    QQmlSortCounter unsettled(count);  // By index, the items still to move.
+    for (int i = tails.last(), k = kept.count() - 1; k >= 0; i = previous.at(i), --k)
+        kept[k] = i;
+    for (int i = 0, k = 0; i < count; ++i) {
+        if (k < kept.count() && kept.at(k) == i) {
+            anchor[i] = i;
+            settled.add(rank.at(i), 1);
+            ++k;
+        } else {
+            unsettled.add(i, 1);
+        }
+    }
+
+    const bool reset = count - kept.count() > qt_maximumSortMoves;
+    int movedGroups = 0;
+
+    for (int r = 0; r < count; ++r) {
+        const int item = order.at(r);
+        if (anchor.at(item) == item)
+            continue;
+
+        // The settled items before this one are those ranked before the first kept item after it.
+        QVector<int>::const_iterator next = std::upper_bound(kept.constBegin(), kept.constEnd(), item);
+        const int from = settled.countBefore(next == kept.constEnd() ? count : rank.at(*next))
+                + unsettled.countBefore(item);
+
+        int to = 0;
+        int itemAnchor = -1;
+        if (r > 0) {
+            itemAnchor = anchor.at(order.at(r - 1));
+            to = settled.countBefore(r - 1) + 1
+                    + (itemAnchor != -1 ? unsettled.countBefore(itemAnchor) : 0);
+            if (from < to)
+                --to;
+        }
+
+        if (from != to) {
+            QVector<Compositor::Remove> removes;
+            QVector<Compositor::Insert> inserts;
+            m_compositor.move(group, from, group, to, 1, group, &removes, &inserts);
+            if (reset) {
+                QVarLengthArray<QVector<QQmlChangeSet::Change>, Compositor::MaximumGroupCount> translatedRemoves(m_groupCount);
+                QVarLengthArray<QVector<QQmlChangeSet::Change>, Compositor::MaximumGroupCount> translatedInserts(m_groupCount);
+                QHash<int, QList<QQmlDelegateModelItem *> > movedItems;
+                itemsRemoved(removes, &translatedRemoves, &movedItems);
+                itemsInserted(inserts, &translatedInserts, &movedItems);
+                for (const Compositor::Remove &remove : qAsConst(removes))
+                    movedGroups |= remove.flags;
+            } else {
+                itemsMoved(removes, inserts);
+            }
+        }
+
+        unsettled.add(item, -1);
+        settled.add(r, 1);
+        anchor[item] = itemAnchor;
+    }
+
+    if (reset && m_delegate) {
+        for (int i = 1; i < m_groupCount; ++i) {
+            if (!(movedGroups & (1 << i)))
+                continue;
+            QQmlChangeSet &changeSet = QQmlDelegateModelGroupPrivate::get(m_groups[i])->changeSet;
+            const int groupCount = m_compositor.count(Compositor::Group(i));
+            changeSet.remove(0, groupCount);
+            changeSet.insert(0, groupCount);
+        }
+        m_reset = true;
+    }
+}
+
+/*
+    Moves the item at \a index of \a group, which is otherwise in order, to its place in the
+    sort order.
+*/
+void QQmlDelegateModelPrivate::sortItem(Compositor::Group group, int index)
+{
+    QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[group]);
+    const int count = m_compositor.count(group);
+    const QVariant key = itemValue(m_compositor.find(group, index), groupPrivate->sortRole);
+
+    if ((index == 0 || !groupPrivate->lessThan(
+                 key, itemValue(m_compositor.find(group, index - 1), groupPrivate->sortRole)))
+            && (index == count - 1 || !groupPrivate->lessThan(
+                 itemValue(m_compositor.find(group, index + 1), groupPrivate->sortRole), key))) {
+        return;
+    }
+
+    // Find the first of the other items that sorts after the item.
+    int low = 0;
+    int high = count - 1;
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        const int other = middle < index ? middle : middle + 1;
+        if (groupPrivate->lessThan(key, itemValue(m_compositor.find(group, other), groupPrivate->sortRole)))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+
+    QVector<Compositor::Remove> removes;
+    QVector<Compositor::Insert> inserts;
+    m_compositor.move(group, index, group, low, 1, group, &removes, &inserts);
+    itemsMoved(removes, inserts);
+}
+
+bool QQmlDelegateModelPrivate::isSortedOrFiltered() const
+{
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (groupPrivate->isSorted() || groupPrivate->isFiltered())
+            return true;
+    }
+    return false;
+}
+
+/*
+    Returns whether a change of the model \a roles can change the place of an item in a sorted
+    group or its membership in a filtered one. An empty list means that any role may have changed.
+*/
+bool QQmlDelegateModelPrivate::affectsSortOrFilter(const QVector<int> &roles) const
+{
+    const QAbstractItemModel *model = qobject_cast<const QAbstractItemModel *>(m_adaptorModel.object());
+    if (roles.isEmpty() || !model)
+        return true;
+
+    const QHash<int, QByteArray> roleNames = model->roleNames();
+    const auto changed = [&roles, &roleNames](const QString &role) {
+        // Names that are not model roles, like modelData, may depend on any role.
+        const int key = roleNames.key(role.toUtf8(), -1);
+        return key == -1 || roles.contains(key);
+    };
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (groupPrivate->isSorted() && changed(groupPrivate->sortRole))
+            return true;
+        if (groupPrivate->isFiltered() && changed(groupPrivate->filterRole))
+            return true;
+    }
+    return false;
+}
+
+/*
+    Updates the sorted and filtered groups for the \a items of the default group that have been
+    inserted, moved or changed.
+
+    Only the given items are filtered again.  If a single item needs sorting it is moved into
+    place with a binary search, otherwise the group is sorted again which moves only the items
+    that are out of order.
+*/
+void QQmlDelegateModelPrivate::sortAndFilterItems(const QVector<QQmlChangeSet::Change> &items)
+{
+    int itemCount = 0;
+    for (const QQmlChangeSet::Change &item : items)
+        itemCount += item.count;
+    if (itemCount == 0)
+        return;
+
+    for (int i = 1; i < m_groupCount; ++i) {
+        if (QQmlDelegateModelGroupPrivate::get(m_groups[i])->isFiltered()) {
+            for (const QQmlChangeSet::Change &item : items)
+                filterItems(Compositor::Group(i), item.index, item.count);
+        }
+    }
+
+    // Sorting a group moves items in the default group too, so once one has been sorted the
+    // indexes of the items are no longer known.
+    bool itemsKnown = true;
+    for (int i = 1; i < m_groupCount; ++i) {
+        if (!QQmlDelegateModelGroupPrivate::get(m_groups[i])->isSorted())
+            continue;
+        const Compositor::Group group = Compositor::Group(i);
+        if (itemCount == 1 && itemsKnown) {
+            Compositor::iterator it = m_compositor.find(Compositor::Default, items.first().index);
+            if (it->inGroup(group))
+                sortItem(group, it.index[group]);
+        } else {
+            sortItems(group);
+        }
+        itemsKnown = false;
+    }
+}
+
+void QQmlDelegateModelPrivate::sortAndFilterItems()
+{
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *groupPrivate = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (groupPrivate->isFiltered())
+            filterItems(Compositor::Group(i), 0, m_compositor.count(Compositor::Default));
+        if (groupPrivate->isSorted())
+            sortItems(Compositor::Group(i));
+    }
+}
+
 void QQmlDelegateModel::_q_itemsMoved(int from, int to, int count)
 {
     Q_D(QQmlDelegateModel);
@@ -1456,6 +1914,7 @@ void QQmlDelegateModel::_q_itemsMoved(int from, int to, int count)
     QVector<Compositor::Insert> inserts;
     d->m_compositor.listItemsMoved(&d->m_adaptorModel, from, to, count, &removes, &inserts);
     d->itemsMoved(removes, inserts);
+    d->sortAndFilterItems(defaultGroupItems(inserts));
     d->emitChanges();
 }
 
@@ -1496,6 +1955,8 @@ void QQmlDelegateModel::_q_modelReset()
     if (!d->m_delegate)
         return;
 
+    d->drainReusableItemsPool(0);
+
     int oldCount = d->m_count;
     d->m_adaptorModel.rootIndex = QModelIndex();
 
@@ -1516,6 +1977,7 @@ void QQmlDelegateModel::_q_modelReset()
         if (d->m_count)
             d->m_compositor.listItemsInserted(&d->m_adaptorModel, 0, d->m_count, &inserts);
         d->itemsMoved(removes, inserts);
+        d->sortAndFilterItems();
         d->m_reset = true;
 
         if (d->m_adaptorModel.canFetchMore())
@@ -1912,6 +2374,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , scriptRef(0)
     , groups(0)
     , index(modelIndex)
+    , poolTime(0)
 {
     metaType->addref();
 }
@@ -2282,6 +2745,111 @@ void QQmlDelegateModelGroupPrivate::emitModelUpdated(bool reset)
     changeSet.clear();
 }
 
+namespace {
+
+// Values of different kinds are ordered by kind first, so that a group whose role has values
+// of mixed types still has a strict weak ordering to sort by.
+enum SortRank {
+    NumberRank,
+    NaNRank,
+    DateRank,
+    TimeRank,
+    DateTimeRank,
+    StringRank
+};
+
+SortRank sortRank(const QVariant &value, double *number)
+{
+    switch (value.userType()) {
+    case QMetaType::QDate:
+        return DateRank;
+    case QMetaType::QTime:
+        return TimeRank;
+    case QMetaType::QDateTime:
+        return DateTimeRank;
+    case QMetaType::QString:
+        // Strings are compared as strings even if they hold a number.
+        return StringRank;
+    default:
+        break;
+    }
+
+    bool isNumber = false;
+    *number = value.toDouble(&isNumber);
+    if (!isNumber)
+        return StringRank;
+    return qIsNaN(*number) ? NaNRank : NumberRank;
+}
+
+}
+
+static bool isVariantLessThan(const QVariant &left, const QVariant &right)
+{
+    double leftNumber = 0;
+    double rightNumber = 0;
+    const SortRank leftRank = sortRank(left, &leftNumber);
+    const SortRank rightRank = sortRank(right, &rightNumber);
+    if (leftRank != rightRank)
+        return leftRank < rightRank;
+
+    switch (leftRank) {
+    case NumberRank:
+        return leftNumber < rightNumber;
+    case NaNRank:
+        return false;
+    case DateRank:
+        return left.toDate() < right.toDate();
+    case TimeRank:
+        return left.toTime() < right.toTime();
+    case DateTimeRank:
+        return left.toDateTime() < right.toDateTime();
+    case StringRank:
+        break;
+    }
+    return QString::compare(left.toString(), right.toString()) < 0;
+}
+
+bool QQmlDelegateModelGroupPrivate::lessThan(const QVariant &left, const QVariant &right) const
+{
+    // Items without a value are placed at the end in either order.
+    if (!right.isValid())
+        return left.isValid();
+    if (!left.isValid())
+        return false;
+    return sortOrder == Qt::AscendingOrder
+            ? isVariantLessThan(left, right)
+            : isVariantLessThan(right, left);
+}
+
+bool QQmlDelegateModelGroupPrivate::filterAcceptsValue(const QVariant &value) const
+{
+#ifndef QT_NO_REGEXP
+    if (filterValue.userType() == QMetaType::QRegExp)
+        return filterValue.toRegExp().indexIn(value.toString()) != -1;
+#endif
+#ifndef QT_NO_REGULAREXPRESSION
+    if (filterValue.userType() == QMetaType::QRegularExpression)
+        return filterValue.toRegularExpression().match(value.toString()).hasMatch();
+#endif
+    return value == filterValue;
+}
+
+void QQmlDelegateModelGroupPrivate::sortAndFilter(bool filterRemoved)
+{
+    if (!model || group == Compositor::Cache)
+        return;
+    QQmlDelegateModelPrivate *modelPrivate = QQmlDelegateModelPrivate::get(model);
+    if (!modelPrivate->m_complete)
+        return;
+
+    // A group that is no longer filtered goes back to its default membership.
+    if (isFiltered() || (filterRemoved && group != Compositor::Default))
+        modelPrivate->filterItems(group, 0, modelPrivate->m_compositor.count(Compositor::Default));
+    if (isSorted())
+        modelPrivate->sortItems(group);
+    modelPrivate->emitChanges();
+}
+
 typedef QQmlDelegateModelGroupEmitterList::iterator GroupEmitterListIt;
 
 void QQmlDelegateModelGroupPrivate::createdPackage(int index, QQuickPackage *package)
@@ -2441,6 +3009,130 @@ void QQmlDelegateModelGroup::setDefaultInclude(bool include)
     }
 }
 
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::sortRole
+    \since 5.10
+
+    This property holds the name of the model role the items in the group are sorted by.
+
+    Numbers are compared by value, dates and times chronologically and other values by their
+    string representation.  Items that have no value for the role are placed at the end of the
+    group.  When the value of an item changes it is moved to its new place in the group.
+
+    Sorting a group moves its items in every other group too, so at most one group of a model
+    should be sorted.  Items inserted into or moved within the group from JavaScript are not
+    moved back into order until the sort order changes.
+
+    By default this property is empty and the group is not sorted.
+
+    \sa sortOrder
+*/
+
+QString QQmlDelegateModelGroup::sortRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortRole;
+}
+
+void QQmlDelegateModelGroup::setSortRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortRole != role) {
+        d->sortRole = role;
+        emit sortRoleChanged();
+        d->sortAndFilter();
+    }
+}
+
+/*!
+    \qmlproperty enumeration QtQml.Models::DelegateModelGroup::sortOrder
+    \since 5.10
+
+    This property holds the order the items in the group are sorted in.
+
+    \list
+    \li Qt.AscendingOrder (default)
+    \li Qt.DescendingOrder
+    \endlist
+
+    \sa sortRole
+*/
+
+Qt::SortOrder QQmlDelegateModelGroup::sortOrder() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortOrder;
+}
+
+void QQmlDelegateModelGroup::setSortOrder(Qt::SortOrder order)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortOrder != order) {
+        d->sortOrder = order;
+        emit sortOrderChanged();
+        d->sortAndFilter();
+    }
+}
+
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::filterRole
+    \since 5.10
+
+    This property holds the name of the model role the items of the
+    \l {QtQml.Models::DelegateModel::items}{items} group are filtered by.
+
+    When it is set the group holds exactly the items whose value for the role matches
+    \l filterValue, and membership is updated whenever the value of an item changes.  A filter
+    has no effect on the \l {QtQml.Models::DelegateModel::items}{items} group itself.
+
+    By default this property is empty and the group is not filtered.  Clearing the property
+    removes the filter, and the group then holds all items if \l includeByDefault is true and
+    none otherwise.
+*/
+
+QString QQmlDelegateModelGroup::filterRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filterRole;
+}
+
+void QQmlDelegateModelGroup::setFilterRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filterRole != role) {
+        const bool wasFiltered = d->isFiltered();
+        d->filterRole = role;
+        emit filterRoleChanged();
+        d->sortAndFilter(wasFiltered && !d->isFiltered());
+    }
+}
+
+/*!
+    \qmlproperty var QtQml.Models::DelegateModelGroup::filterValue
+    \since 5.10
+
+    This property holds the value items must have for \l filterRole to belong to the group.
+
+    If the value is a regular expression an item matches if the string value of its role matches
+    the expression, otherwise the values must be equal.
+*/
+
+QVariant QQmlDelegateModelGroup::filterValue() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filterValue;
+}
+
+void QQmlDelegateModelGroup::setFilterValue(const QVariant &value)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filterValue != value) {
+        d->filterValue = value;
+        emit filterValueChanged();
+        d->sortAndFilter();
+    }
+}
+
 /*!
     \qmlmethod object QtQml.Models::DelegateModelGroup::get(int index)
 
@@ -3174,7 +3866,7 @@ QObject *QQmlPartsModel::object(int index, bool asynchronous)
     return 0;
 }
 
-QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item)
+QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableFlag)
 {
     QQmlInstanceModel::ReleaseFlags flags = 0;
 
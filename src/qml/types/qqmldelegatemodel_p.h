@@ -110,8 +110,10 @@ public:
     int count() const override;
     bool isValid() const override { return delegate() != 0; }
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *object) override;
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) override;
     void cancel(int index) override;
+    void drainReusableItemsPool(int maxPoolTime) override;
+    int poolSize() override;
     QString stringValue(int index, const QString &role) override;
     void setWatchedRoles(const QList<QByteArray> &roles) override;
 
@@ -161,6 +163,10 @@ class Q_QML_PRIVATE_EXPORT QQmlDelegateModelGroup : public QObject
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(bool includeByDefault READ defaultInclude WRITE setDefaultInclude NOTIFY defaultIncludeChanged)
+    Q_PROPERTY(QString sortRole READ sortRole WRITE setSortRole NOTIFY sortRoleChanged REVISION 10)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged REVISION 10)
+    Q_PROPERTY(QString filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged REVISION 10)
+    Q_PROPERTY(QVariant filterValue READ filterValue WRITE setFilterValue NOTIFY filterValueChanged REVISION 10)
 public:
     QQmlDelegateModelGroup(QObject *parent = 0);
     QQmlDelegateModelGroup(const QString &name, QQmlDelegateModel *model, int compositorType, QObject *parent = 0);
@@ -174,6 +180,18 @@ public:
     bool defaultInclude() const;
     void setDefaultInclude(bool include);
 
+    QString sortRole() const;
+    void setSortRole(const QString &role);
+
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+
+    QString filterRole() const;
+    void setFilterRole(const QString &role);
+
+    QVariant filterValue() const;
+    void setFilterValue(const QVariant &value);
+
     Q_INVOKABLE QQmlV4Handle get(int index);
 
 public Q_SLOTS:
@@ -191,6 +209,10 @@ Q_SIGNALS:
     void nameChanged();
     void defaultIncludeChanged();
     void changed(const QQmlV4Handle &removed, const QQmlV4Handle &inserted);
+    Q_REVISION(10) void sortRoleChanged();
+    Q_REVISION(10) void sortOrderChanged();
+    Q_REVISION(10) void filterRoleChanged();
+    Q_REVISION(10) void filterValueChanged();
 private:
     Q_DECLARE_PRIVATE(QQmlDelegateModelGroup)
 };
@@ -130,6 +130,7 @@ public:
 
     virtual void setValue(const QString &role, const QVariant &value) { Q_UNUSED(role); Q_UNUSED(value); }
     virtual bool resolveIndex(const QQmlAdaptorModel &, int) { return false; }
+    virtual bool rebind(const QQmlAdaptorModel &, int) { return false; }
 
     static void get_model(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData);
     static void get_groups(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData);
@@ -148,6 +149,7 @@ public:
     int scriptRef;
     int groups;
     int index;
+    int poolTime;
 
 Q_SIGNALS:
     void modelIndexChanged();
@@ -218,7 +220,8 @@ class QQmlDelegateModelGroupPrivate : public QObjectPrivate
 public:
     Q_DECLARE_PUBLIC(QQmlDelegateModelGroup)
 
-    QQmlDelegateModelGroupPrivate() : group(Compositor::Cache), defaultInclude(false) {}
+    QQmlDelegateModelGroupPrivate()
+        : group(Compositor::Cache), sortOrder(Qt::AscendingOrder), defaultInclude(false) {}
 
     static QQmlDelegateModelGroupPrivate *get(QQmlDelegateModelGroup *group) {
         return static_cast<QQmlDelegateModelGroupPrivate *>(QObjectPrivate::get(group)); }
@@ -236,11 +239,21 @@ public:
     bool parseGroupArgs(
             QQmlV4Function *args, Compositor::Group *group, int *index, int *count, int *groups) const;
 
+    bool isSorted() const { return !sortRole.isEmpty(); }
+    bool isFiltered() const { return !filterRole.isEmpty() && group != Compositor::Default; }
+    bool lessThan(const QVariant &left, const QVariant &right) const;
+    bool filterAcceptsValue(const QVariant &value) const;
+    void sortAndFilter(bool filterRemoved = false);
+
     Compositor::Group group;
     QPointer<QQmlDelegateModel> model;
     QQmlDelegateModelGroupEmitterList emitters;
     QQmlChangeSet changeSet;
     QString name;
+    QString sortRole;
+    QString filterRole;
+    QVariant filterValue;
+    Qt::SortOrder sortOrder;
     bool defaultInclude;
 };
 
@@ -262,7 +275,12 @@ public:
 
     void requestMoreIfNecessary();
     QObject *object(Compositor::Group group, int index, bool asynchronous);
-    QQmlDelegateModel::ReleaseFlags release(QObject *object);
+    QQmlDelegateModel::ReleaseFlags release(
+            QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    bool isReusable(QQmlDelegateModelItem *cacheItem) const;
+    QQmlDelegateModelItem *takeReusableItem(int modelIndex);
+    void destroyReusableItem(QQmlDelegateModelItem *cacheItem);
+    void drainReusableItemsPool(int maxPoolTime);
     QString stringValue(Compositor::Group group, int index, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
@@ -293,6 +311,16 @@ public:
     void itemsMoved(
             const QVector<Compositor::Remove> &removes, const QVector<Compositor::Insert> &inserts);
     void itemsChanged(const QVector<Compositor::Change> &changes);
+
+    QVariant itemValue(const Compositor::iterator &it, const QString &role);
+    void filterItems(Compositor::Group group, int from, int count);
+    void sortItems(Compositor::Group group);
+    void sortItem(Compositor::Group group, int index);
+    bool isSortedOrFiltered() const;
+    bool affectsSortOrFilter(const QVector<int> &roles) const;
+    void sortAndFilterItems(const QVector<QQmlChangeSet::Change> &items);
+    void sortAndFilterItems();
+
     void emitChanges();
     void emitModelUpdated(const QQmlChangeSet &changeSet, bool reset) override;
 
@@ -315,6 +343,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItemsPool;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -358,7 +387,7 @@ public:
     int count() const override;
     bool isValid() const override;
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *item) override;
+    ReleaseFlags release(QObject *item, ReusableFlag reusableFlag = NotReusable) override;
     QString stringValue(int index, const QString &role) override;
     QList<QByteArray> watchedRoles() const { return m_watchedRoles; }
     void setWatchedRoles(const QList<QByteArray> &roles) override;
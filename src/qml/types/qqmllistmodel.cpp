@@ -49,6 +49,7 @@
 
 #include <private/qv4object_p.h>
 #include <private/qv4dateobject_p.h>
+#include <private/qv4typedarray_p.h>
 #include <private/qv4objectiterator_p.h>
 #include <private/qv4alloca_p.h>
 
@@ -588,6 +589,160 @@ int ListModel::append(QV4::Object *object)
     return elementIndex;
 }
 
+static ListLayout::Role::DataType roleTypeForValue(const QV4::Value &value)
+{
+    if (value.isString())
+        return ListLayout::Role::String;
+    if (value.isNumber())
+        return ListLayout::Role::Number;
+    if (value.as<QV4::ArrayObject>())
+        return ListLayout::Role::List;
+    if (value.isBoolean())
+        return ListLayout::Role::Bool;
+    if (value.as<QV4::DateObject>())
+        return ListLayout::Role::DateTime;
+    if (const QV4::Object *o = value.as<QV4::Object>())
+        return o->as<QV4::QObjectWrapper>() ? ListLayout::Role::QObject : ListLayout::Role::VariantMap;
+    return ListLayout::Role::Invalid;
+}
+
+/*
+    Appends rowCount elements and fills them from columns, which maps role names to arrays
+    or typed arrays of values, one per element. Each role is resolved once per column
+    instead of once per value, and the values are written straight into the new elements.
+*/
+void ListModel::appendColumns(QV4::Object *columns, int rowCount)
+{
+    const int firstIndex = elements.count();
+    elements.reserve(firstIndex + rowCount);
+    for (int i = 0; i < rowCount; ++i)
+        newElement(firstIndex + i);
+
+    QV4::ExecutionEngine *v4 = columns->engine();
+    QV4::Scope scope(v4);
+
+    QV4::ObjectIterator it(scope, columns, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+    QV4::ScopedString propertyName(scope);
+    QV4::ScopedValue column(scope);
+    QV4::ScopedValue value(scope);
+    QV4::ScopedObject o(scope);
+    while (1) {
+        propertyName = it.nextPropertyNameAsString(column);
+        if (!propertyName)
+            break;
+
+        if (QV4::TypedArray *a = column->as<QV4::TypedArray>()) {
+            // Numeric column, read the values directly from the array buffer
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
+            if (r.type != ListLayout::Role::Number)
+                continue;
+
+            const QV4::TypedArrayOperations *operations = a->d()->type;
+            const char *data = a->d()->buffer->data->data();
+            const int count = qMin(int(a->length()), rowCount);
+            for (int i = 0; i < count; ++i) {
+                value = operations->read(data, a->d()->byteOffset + i * operations->bytesPerElement);
+                elements[firstIndex + i]->setDoublePropertyFast(r, value->toNumber());
+            }
+            continue;
+        }
+
+        QV4::ArrayObject *a = column->as<QV4::ArrayObject>();
+        if (!a)
+            continue;
+
+        const int count = qMin(int(a->getLength()), rowCount);
+
+        // The type of the role is decided by the first value that has one
+        ListLayout::Role::DataType type = ListLayout::Role::Invalid;
+        for (int i = 0; i < count && type == ListLayout::Role::Invalid; ++i) {
+            value = a->getIndexed(i);
+            type = roleTypeForValue(value);
+        }
+        if (type == ListLayout::Role::Invalid)
+            continue;
+
+        const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, type);
+
+        for (int i = 0; i < count; ++i) {
+            value = a->getIndexed(i);
+            if (roleTypeForValue(value) != r.type)
+                continue;
+
+            ListElement *e = elements[firstIndex + i];
+            switch (r.type) {
+            case ListLayout::Role::String:
+                e->setStringPropertyFast(r, value->stringValue()->toQString());
+                break;
+            case ListLayout::Role::Number:
+                e->setDoublePropertyFast(r, value->asDouble());
+                break;
+            case ListLayout::Role::Bool:
+                e->setBoolPropertyFast(r, value->booleanValue());
+                break;
+            case ListLayout::Role::DateTime:
+                e->setDateTimePropertyFast(r, value->as<QV4::DateObject>()->toQDateTime());
+                break;
+            case ListLayout::Role::QObject:
+                e->setQObjectPropertyFast(r, value->as<QV4::QObjectWrapper>()->object());
+                break;
+            case ListLayout::Role::VariantMap:
+                o = value;
+                e->setVariantMapFast(r, o);
+                break;
+            case ListLayout::Role::List: {
+                QV4::ScopedArrayObject subArray(scope, value);
+                ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+                int arrayLength = subArray->getLength();
+                for (int j = 0; j < arrayLength; ++j) {
+                    o = subArray->getIndexed(j);
+                    subModel->append(o);
+                }
+                e->setListPropertyFast(r, subModel);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
+
+QV4::ReturnedValue ListModel::getColumn(const ListLayout::Role &role, const QQmlListModel *owner, QV4::ExecutionEngine *eng)
+{
+    QV4::Scope scope(eng);
+    QV4::ScopedArrayObject array(scope, eng->newArrayObject());
+    const int count = elements.count();
+    array->arrayReserve(count);
+
+    QV4::ScopedValue v(scope);
+    for (int i = 0; i < count; ++i) {
+        ListElement *e = elements.at(i);
+        switch (role.type) {
+        case ListLayout::Role::Number:
+            v = QV4::Encode(*reinterpret_cast<double *>(e->getPropertyMemory(role)));
+            break;
+        case ListLayout::Role::Bool:
+            v = QV4::Encode(*reinterpret_cast<bool *>(e->getPropertyMemory(role)));
+            break;
+        case ListLayout::Role::String: {
+            if (QString *s = e->getStringProperty(role))
+                v = eng->newString(*s);
+            else
+                v = QV4::Encode::undefined();
+            break;
+        }
+        default:
+            v = eng->fromVariant(e->getProperty(role, owner, eng));
+            break;
+        }
+        array->arrayPut(i, v);
+    }
+    array->setArrayLengthUnchecked(count);
+
+    return array.asReturnedValue();
+}
+
 int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
 {
     int roleIndex = -1;
@@ -1062,6 +1217,19 @@ void ListElement::sync(ListElement *src, ListLayout *srcLayout, ListElement *tar
                 }
                 break;
             case ListLayout::Role::String:
+                {
+                    // Share the string data with the source instead of boxing it
+                    // into a QVariant and comparing it against the old value.
+                    const QString *s = src->getStringProperty(srcRole);
+                    const QString value = s ? *s : QString();
+                    char *mem = target->getPropertyMemory(targetRole);
+                    QString *t = reinterpret_cast<QString *>(mem);
+                    if (t->data_ptr() == 0)
+                        new (mem) QString(value);
+                    else
+                        *t = value;
+                }
+                break;
             case ListLayout::Role::Number:
             case ListLayout::Role::Bool:
             case ListLayout::Role::DateTime:
@@ -2247,6 +2415,96 @@ void QQmlListModel::append(QQmlV4Function *args)
     }
 }
 
+/*!
+    \qmlmethod ListModel::appendColumns(jsobject columns)
+    \since 5.10
+
+    Adds new items to the end of the list model, taking their values
+    from \a columns. Each property of \a columns names a role and holds
+    an array of values, the value at index \c i of each array going
+    into the \c i th new item. Numeric roles can also be given as typed
+    arrays, such as \c Float64Array or \c Int32Array.
+
+    \code
+        fruitModel.appendColumns({"name": ["Apple", "Banana", "Cumquat"],
+                                  "cost": new Float64Array([2.45, 1.95, 3.25])})
+    \endcode
+
+    The number of items added is the length of the longest array. Roles
+    are only looked up once per column, which makes this much faster than
+    calling append() for each item when populating large models.
+
+    \sa append(), getColumn()
+*/
+void QQmlListModel::appendColumns(const QQmlV4Handle &handle)
+{
+    QV4::Scope scope(engine());
+    QV4::ScopedObject columns(scope, handle);
+
+    if (!columns || columns->as<QV4::ArrayObject>()) {
+        qmlWarning(this) << tr("appendColumns: value is not an object");
+        return;
+    }
+
+    int rowCount = 0;
+    {
+        QV4::ObjectIterator it(scope, columns, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+        QV4::ScopedString propertyName(scope);
+        QV4::ScopedValue column(scope);
+        while (1) {
+            propertyName = it.nextPropertyNameAsString(column);
+            if (!propertyName)
+                break;
+
+            if (QV4::TypedArray *a = column->as<QV4::TypedArray>()) {
+                rowCount = qMax(rowCount, int(a->length()));
+            } else if (QV4::ArrayObject *a = column->as<QV4::ArrayObject>()) {
+                rowCount = qMax(rowCount, int(a->getLength()));
+            } else {
+                qmlWarning(this) << tr("appendColumns: column %1 is not an array").arg(propertyName->toQString());
+                return;
+            }
+        }
+    }
+
+    if (rowCount == 0)
+        return;
+
+    const int index = count();
+    emitItemsAboutToBeInserted(index, rowCount);
+
+    if (m_dynamicRoles) {
+        QVector<QVariantMap> rows(rowCount);
+
+        QV4::ObjectIterator it(scope, columns, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+        QV4::ScopedString propertyName(scope);
+        QV4::ScopedValue column(scope);
+        QV4::ScopedObject a(scope);
+        QV4::ScopedValue value(scope);
+        while (1) {
+            propertyName = it.nextPropertyNameAsString(column);
+            if (!propertyName)
+                break;
+
+            const QString name = propertyName->toQString();
+            a = column;
+            const int length = qMin(int(a->getLength()), rowCount);
+            for (int i = 0; i < length; ++i) {
+                value = a->getIndexed(i);
+                if (!value->isNullOrUndefined())
+                    rows[i].insert(name, scope.engine->toVariant(value, -1, /*createJSValueForObjects*/false));
+            }
+        }
+
+        for (const QVariantMap &row : qAsConst(rows))
+            m_modelObjects.append(DynamicRoleModelNode::create(row, this));
+    } else {
+        m_listModel->appendColumns(columns, rowCount);
+    }
+
+    emitItemsInserted(index, rowCount);
+}
+
 /*!
     \qmlmethod object ListModel::get(int index)
 
@@ -2300,6 +2558,47 @@ QQmlV4Handle QQmlListModel::get(int index) const
     return QQmlV4Handle(result);
 }
 
+/*!
+    \qmlmethod list ListModel::getColumn(string role)
+    \since 5.10
+
+    Returns an array holding the value of \a role for every item in the
+    list model, in order. This is much faster than calling get() for
+    each item when exporting the content of large models.
+
+    \code
+        var names = fruitModel.getColumn("name");
+    \endcode
+
+    If the model has no role called \a role, an empty array is returned.
+
+    \sa get(), appendColumns()
+*/
+QQmlV4Handle QQmlListModel::getColumn(const QString &role) const
+{
+    QV4::Scope scope(engine());
+    QV4::ScopedValue result(scope);
+
+    if (m_dynamicRoles) {
+        QV4::ScopedArrayObject array(scope, scope.engine->newArrayObject());
+        if (m_roles.contains(role)) {
+            const int count = m_modelObjects.count();
+            array->arrayReserve(count);
+            QV4::ScopedValue v(scope);
+            for (int i = 0; i < count; ++i)
+                array->arrayPut(i, (v = scope.engine->fromVariant(m_modelObjects.at(i)->getValue(role))));
+            array->setArrayLengthUnchecked(count);
+        }
+        result = array;
+    } else if (const ListLayout::Role *r = m_listModel->getExistingRole(role)) {
+        result = m_listModel->getColumn(*r, this, scope.engine);
+    } else {
+        result = scope.engine->newArrayObject();
+    }
+
+    return QQmlV4Handle(result);
+}
+
 /*!
     \qmlmethod ListModel::set(int index, jsobject dict)
 
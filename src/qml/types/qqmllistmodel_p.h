@@ -103,6 +103,8 @@ public:
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
+    Q_INVOKABLE void appendColumns(const QQmlV4Handle &columns);
+    Q_INVOKABLE QQmlV4Handle getColumn(const QString &role) const;
 
     QQmlListModelWorkerAgent *agent();
 
@@ -315,6 +315,7 @@ private:
     QObject *m_objectCache;
 
     friend class ListModel;
+    friend class QQmlListModelWorkerAgent;
 };
 
 /*!
@@ -350,6 +351,11 @@ public:
         return m_layout->getExistingRole(key);
     }
 
+    const ListLayout::Role *getExistingRole(const QString &key) const
+    {
+        return m_layout->getExistingRole(key);
+    }
+
     const ListLayout::Role &getOrCreateListRole(const QString &name)
     {
         return m_layout->getRoleOrCreate(name, ListLayout::Role::List);
@@ -366,6 +372,9 @@ public:
     int append(QV4::Object *object);
     void insert(int elementIndex, QV4::Object *object);
 
+    void appendColumns(QV4::Object *columns, int rowCount);
+    QV4::ReturnedValue getColumn(const ListLayout::Role &role, const QQmlListModel *owner, QV4::ExecutionEngine *eng);
+
     Q_REQUIRED_RESULT QVector<std::function<void()>> remove(int index, int count);
 
     int appendElement();
@@ -165,6 +165,16 @@ void QQmlListModelWorkerAgent::move(int from, int to, int count)
     m_copy->move(from, to, count);
 }
 
+void QQmlListModelWorkerAgent::appendColumns(const QQmlV4Handle &columns)
+{
+    m_copy->appendColumns(columns);
+}
+
+QQmlV4Handle QQmlListModelWorkerAgent::getColumn(const QString &role) const
+{
+    return m_copy->getColumn(role);
+}
+
 void QQmlListModelWorkerAgent::sync()
 {
     Sync *s = new Sync(data, m_copy);
@@ -176,6 +186,127 @@ void QQmlListModelWorkerAgent::sync()
     mutex.unlock();
 }
 
+/*
+    Applies the changes recorded on the worker thread to \a target, touching
+    only the rows that were inserted or changed, instead of syncing every
+    element of the model.
+
+    The structural changes are replayed in order on a list of row slots
+    mirroring \a target; the result must line up with \a src element by
+    element. Returns false without modifying \a target if the recorded
+    changes cannot be replayed (changes to nested models, or a change list
+    that was pruned by clear()), in which case the caller falls back to a
+    full ListModel::sync().
+*/
+bool QQmlListModelWorkerAgent::syncChanges(ListModel *src, ListModel *target, const QList<Change> &changes)
+{
+    const int uid = src->getUid();
+    if (target->getUid() != uid)
+        return false;
+
+    struct Row
+    {
+        ListElement *element; // 0 for rows inserted by the worker
+        bool dirty;
+    };
+
+    QVector<Row> rows;
+    rows.reserve(target->elements.count());
+    for (int i = 0; i < target->elements.count(); ++i) {
+        Row row = { target->elements.at(i), false };
+        rows.append(row);
+    }
+
+    QVector<ListElement *> removed;
+    bool structureChanged = false;
+
+    for (const Change &change : changes) {
+        if (change.modelUid != uid)
+            return false;
+
+        switch (change.type) {
+        case Change::Inserted: {
+            if (change.index < 0 || change.index > rows.count())
+                return false;
+            Row row = { 0, true };
+            rows.insert(change.index, change.count, row);
+            structureChanged = true;
+            break;
+        }
+        case Change::Removed:
+            if (change.index < 0 || change.index + change.count > rows.count())
+                return false;
+            for (int i = change.index; i < change.index + change.count; ++i) {
+                if (rows.at(i).element)
+                    removed.append(rows.at(i).element);
+            }
+            rows.remove(change.index, change.count);
+            structureChanged = true;
+            break;
+        case Change::Moved: {
+            if (change.index < 0 || change.index + change.count > rows.count()
+                    || change.to < 0 || change.to + change.count > rows.count())
+                return false;
+            const QVector<Row> moved = rows.mid(change.index, change.count);
+            rows.remove(change.index, change.count);
+            for (int i = 0; i < moved.count(); ++i)
+                rows.insert(change.to + i, moved.at(i));
+            structureChanged = true;
+            break;
+        }
+        case Change::Changed:
+            if (change.index < 0 || change.index + change.count > rows.count())
+                return false;
+            for (int i = change.index; i < change.index + change.count; ++i)
+                rows[i].dirty = true;
+            break;
+        }
+    }
+
+    if (rows.count() != src->elements.count())
+        return false;
+    for (int i = 0; i < rows.count(); ++i) {
+        const ListElement *e = rows.at(i).element;
+        if (e && e->getUid() != src->elements.at(i)->getUid())
+            return false;
+    }
+
+    for (ListElement *e : qAsConst(removed)) {
+        e->destroy(target->m_layout);
+        delete e;
+    }
+
+    ListLayout::sync(src->m_layout, target->m_layout);
+
+    if (structureChanged)
+        target->elements.clear();
+
+    for (int i = 0; i < rows.count(); ++i) {
+        const Row &row = rows.at(i);
+        ListElement *targetElement = row.element;
+        if (row.dirty) {
+            ListElement *srcElement = src->elements.at(i);
+            if (!targetElement)
+                targetElement = new ListElement(srcElement->getUid());
+            ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, 0);
+        }
+        if (structureChanged)
+            target->elements.append(targetElement);
+    }
+
+    if (structureChanged)
+        target->updateCacheIndices();
+
+    for (const Row &row : qAsConst(rows)) {
+        if (row.dirty && row.element) {
+            if (ModelNodeMetaObject *mo = row.element->objectCache())
+                mo->updateValues();
+        }
+    }
+
+    return true;
+}
+
 bool QQmlListModelWorkerAgent::event(QEvent *e)
 {
     if (e->type() == QEvent::User) {
@@ -193,6 +324,8 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
             Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
             if (m_orig->m_dynamicRoles)
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
+            else if (syncChanges(s->list->m_listModel, m_orig->m_listModel, changes))
+                targetModelStaticHash.insert(m_orig->m_listModel->getUid(), m_orig->m_listModel);
             else
                 ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
 
@@ -63,6 +63,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QQmlListModel;
+class ListModel;
 
 class QQmlListModelWorkerAgent : public QObject
 {
@@ -88,6 +89,8 @@ public:
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
+    Q_INVOKABLE void appendColumns(const QQmlV4Handle &columns);
+    Q_INVOKABLE QQmlV4Handle getColumn(const QString &role) const;
 
     struct VariantRef
     {
@@ -136,6 +139,8 @@ private:
     };
     Data data;
 
+    static bool syncChanges(ListModel *src, ListModel *target, const QList<Change> &changes);
+
     struct Sync : public QEvent {
         Sync(const Data &d, QQmlListModel *l)
             : QEvent(QEvent::User)
@@ -55,6 +55,7 @@ void QQmlModelsModule::defineModule()
     qmlRegisterType<QQmlDelegateModelGroup>(uri, 2, 1, "DelegateModelGroup");
     qmlRegisterType<QQmlObjectModel>(uri, 2, 1, "ObjectModel");
     qmlRegisterType<QQmlObjectModel,3>(uri, 2, 3, "ObjectModel");
+    qmlRegisterType<QQmlDelegateModelGroup,10>(uri, 2, 10, "DelegateModelGroup");
 
     qmlRegisterType<QItemSelectionModel>(uri, 2, 2, "ItemSelectionModel");
 }
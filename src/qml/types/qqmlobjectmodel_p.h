@@ -69,14 +69,17 @@ class Q_QML_PRIVATE_EXPORT QQmlInstanceModel : public QObject
 public:
     virtual ~QQmlInstanceModel() {}
 
-    enum ReleaseFlag { Referenced = 0x01, Destroyed = 0x02 };
+    enum ReleaseFlag { Referenced = 0x01, Destroyed = 0x02, Pooled = 0x04 };
     Q_DECLARE_FLAGS(ReleaseFlags, ReleaseFlag)
+    enum ReusableFlag { NotReusable, Reusable };
 
     virtual int count() const = 0;
     virtual bool isValid() const = 0;
     virtual QObject *object(int index, bool asynchronous=false) = 0;
-    virtual ReleaseFlags release(QObject *object) = 0;
+    virtual ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) = 0;
     virtual void cancel(int) {}
+    virtual void drainReusableItemsPool(int maxPoolTime) { Q_UNUSED(maxPoolTime); }
+    virtual int poolSize() { return 0; }
     virtual QString stringValue(int, const QString &) = 0;
     virtual void setWatchedRoles(const QList<QByteArray> &roles) = 0;
 
@@ -88,6 +91,8 @@ Q_SIGNALS:
     void createdItem(int index, QObject *object);
     void initItem(int index, QObject *object);
     void destroyingItem(QObject *object);
+    void itemPooled(int index, QObject *object);
+    void itemReused(int index, QObject *object);
 
 protected:
     QQmlInstanceModel(QObjectPrivate &dd, QObject *parent = 0)
@@ -114,7 +119,7 @@ public:
     int count() const override;
     bool isValid() const override;
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *object) override;
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) override;
     QString stringValue(int index, const QString &role) override;
     void setWatchedRoles(const QList<QByteArray> &) override {}
 
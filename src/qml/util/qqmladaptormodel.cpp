@@ -47,6 +47,8 @@
 #include <private/qv4value_p.h>
 #include <private/qv4functionobject_p.h>
 
+#include <QtCore/qbitarray.h>
+
 QT_BEGIN_NAMESPACE
 
 class QQmlAdaptorModelEngineData : public QV8Engine::Deletable
@@ -99,17 +101,24 @@ public:
 
     int metaCall(QMetaObject::Call call, int id, void **arguments);
 
-    virtual QVariant value(int role) const = 0;
+    QVariant fetchedValue(int propertyId);
+    void invalidateFetchedValues(const QBitArray &propertyIds);
+
+    virtual void fetchValues(const QBitArray &propertyIds) = 0;
     virtual void setValue(int role, const QVariant &value) = 0;
 
     void setValue(const QString &role, const QVariant &value);
     bool resolveIndex(const QQmlAdaptorModel &model, int idx);
+    bool rebind(const QQmlAdaptorModel &model, int idx);
 
     static QV4::ReturnedValue get_property(QV4::CallContext *ctx, uint propertyId);
     static QV4::ReturnedValue set_property(QV4::CallContext *ctx, uint propertyId);
 
     VDMModelDelegateDataType *type;
     QVector<QVariant> cachedData;
+    QVector<QVariant> fetchedData;
+    QBitArray fetchedProperties;
+    int fetchedIndex;
 };
 
 class VDMModelDelegateDataType
@@ -154,6 +163,7 @@ public:
         }
 
         QVector<int> signalIndexes;
+        QBitArray changedProperties(propertyRoles.count(), roles.isEmpty());
         for (int i = 0; i < roles.count(); ++i) {
             const int role = roles.at(i);
             if (!changed && watchedRoleIds.contains(role))
@@ -162,6 +172,8 @@ public:
             int propertyId = propertyRoles.indexOf(role);
             if (propertyId != -1)
                 signalIndexes.append(propertyId + signalOffset);
+            for (; propertyId != -1; propertyId = propertyRoles.indexOf(role, propertyId + 1))
+                changedProperties.setBit(propertyId);
         }
         if (roles.isEmpty()) {
             const int propertyRolesCount = propertyRoles.count();
@@ -174,6 +186,7 @@ public:
             QQmlDelegateModelItem *item = items.at(i);
             const int idx = item->modelIndex();
             if (idx >= index && idx < index + count) {
+                static_cast<QQmlDMCachedModelData *>(item)->invalidateFetchedValues(changedProperties);
                 for (int i = 0; i < signalIndexes.count(); ++i)
                     QMetaObject::activate(item, signalIndexes.at(i), 0);
             }
@@ -249,6 +262,7 @@ public:
 
     QV4::PersistentValue prototype;
     QList<int> propertyRoles;
+    QBitArray readProperties;
     QList<int> watchedRoleIds;
     QList<QByteArray> watchedRoles;
     QHash<QByteArray, int> roleNames;
@@ -264,6 +278,7 @@ QQmlDMCachedModelData::QQmlDMCachedModelData(
         QQmlDelegateModelItemMetaType *metaType, VDMModelDelegateDataType *dataType, int index)
     : QQmlDelegateModelItem(metaType, index)
     , type(dataType)
+    , fetchedIndex(-1)
 {
     if (index == -1)
         cachedData.resize(type->hasModelData ? 1 : type->propertyRoles.count());
@@ -287,7 +302,7 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
                     type->hasModelData ? 0 : propertyIndex);
             }
         } else  if (*type->model) {
-            *static_cast<QVariant *>(arguments[0]) = value(type->propertyRoles.at(propertyIndex));
+            *static_cast<QVariant *>(arguments[0]) = fetchedValue(propertyIndex);
         }
         return -1;
     } else if (call == QMetaObject::WriteProperty && id >= type->propertyOffset) {
@@ -304,6 +319,9 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
             }
         } else if (*type->model) {
             setValue(type->propertyRoles.at(propertyIndex), *static_cast<QVariant *>(arguments[0]));
+            QBitArray written(type->propertyRoles.count());
+            written.setBit(propertyIndex);
+            invalidateFetchedValues(written);
         }
         return -1;
     } else {
@@ -311,6 +329,45 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
     }
 }
 
+/*
+    Returns the value of the property \a propertyId for the current row.
+
+    Values are fetched from the model once per row and kept until the model reports a change to
+    them. The first read of a row fetches every property a delegate has read before together, so
+    bindings don't each locate the row in the model again.
+*/
+
+QVariant QQmlDMCachedModelData::fetchedValue(int propertyId)
+{
+    type->readProperties.setBit(propertyId);
+
+    if (fetchedIndex != index) {
+        fetchedIndex = index;
+        const int propertyCount = type->propertyRoles.count();
+        fetchedData.fill(QVariant(), propertyCount);
+        fetchedProperties.fill(false, propertyCount);
+        fetchValues(type->readProperties);
+    } else if (!fetchedProperties.testBit(propertyId)) {
+        QBitArray propertyIds(fetchedProperties.size());
+        propertyIds.setBit(propertyId);
+        fetchValues(propertyIds);
+    }
+    return fetchedData.at(propertyId);
+}
+
+/*
+    Discards the fetched values of \a propertyIds so they will be fetched from the model again
+    when next read.
+*/
+
+void QQmlDMCachedModelData::invalidateFetchedValues(const QBitArray &propertyIds)
+{
+    if (fetchedProperties.size() == propertyIds.size())
+        fetchedProperties &= ~propertyIds;
+    else
+        fetchedIndex = -1;
+}
+
 void QQmlDMCachedModelData::setValue(const QString &role, const QVariant &value)
 {
     QHash<QByteArray, int>::iterator it = type->roleNames.find(role.toUtf8());
@@ -330,6 +387,7 @@ bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
         Q_ASSERT(idx >= 0);
         index = idx;
         cachedData.clear();
+        fetchedIndex = -1;
         emit modelIndexChanged();
         const QMetaObject *meta = metaObject();
         const int propertyCount = type->propertyRoles.count();
@@ -341,6 +399,20 @@ bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
     }
 }
 
+bool QQmlDMCachedModelData::rebind(const QQmlAdaptorModel &, int idx)
+{
+    Q_ASSERT(idx >= 0);
+    index = idx;
+    cachedData.clear();
+    fetchedIndex = -1;
+    emit modelIndexChanged();
+    const QMetaObject *meta = metaObject();
+    const int propertyCount = type->propertyRoles.count();
+    for (int i = 0; i < propertyCount; ++i)
+        QMetaObject::activate(this, meta, i, 0);
+    return true;
+}
+
 QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, uint propertyId)
 {
     QV4::Scope scope(ctx);
@@ -355,8 +427,7 @@ QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, ui
                     modelData->cachedData.at(modelData->type->hasModelData ? 0 : propertyId));
         }
     } else if (*modelData->type->model) {
-        return scope.engine->fromVariant(
-                modelData->value(modelData->type->propertyRoles.at(propertyId)));
+        return scope.engine->fromVariant(modelData->fetchedValue(propertyId));
     }
     return QV4::Encode::undefined();
 }
@@ -413,9 +484,16 @@ public:
         }
     }
 
-    QVariant value(int role) const
+    void fetchValues(const QBitArray &propertyIds)
     {
-        return type->model->aim()->index(index, 0, type->model->rootIndex).data(role);
+        const QAbstractItemModel * const model = type->model->aim();
+        const QModelIndex modelIndex = model->index(index, 0, type->model->rootIndex);
+        for (int i = 0; i < propertyIds.size(); ++i) {
+            if (propertyIds.testBit(i)) {
+                fetchedData[i] = model->data(modelIndex, type->propertyRoles.at(i));
+                fetchedProperties.setBit(i);
+            }
+        }
     }
 
     void setValue(int role, const QVariant &value)
@@ -477,6 +555,11 @@ public:
 
     QVariant value(const QQmlAdaptorModel &model, int index, const QString &role) const override
     {
+        // Sorted and filtered groups read values before any delegates have been created.
+        if (!metaObject) {
+            const_cast<VDMAbstractItemModelDataType *>(this)->initializeMetaType(
+                    const_cast<QQmlAdaptorModel &>(model));
+        }
         QHash<QByteArray, int>::const_iterator it = roleNames.find(role.toUtf8());
         if (it != roleNames.end()) {
             return model.aim()->index(index, 0, model.rootIndex).data(*it);
@@ -546,6 +629,8 @@ public:
             addProperty(&builder, 1, propertyName, propertyType);
         }
 
+        readProperties.resize(propertyRoles.count());
+
         metaObject = builder.toMetaObject();
         *static_cast<QMetaObject *>(this) = *metaObject;
         propertyCache = new QQmlPropertyCache(metaObject);
@@ -631,6 +716,15 @@ public:
         }
     }
 
+    bool rebind(const QQmlAdaptorModel &model, int idx)
+    {
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+        return true;
+    }
+
 
 Q_SIGNALS:
     void modelDataChanged();
@@ -92,12 +92,13 @@ QT_BEGIN_NAMESPACE
     Internally the index mapping is stored as a list of Range objects, each has a list identifier,
     a start index, a count, and a set of flags which represent group membership and some other
     properties.  The group index of a range is the sum of all preceding ranges that are members of
-    that group.  To avoid the inefficiency of iterating over potentially all ranges when looking
-    for a specific index, each time a lookup is done the range and its indexes are cached and the
-    next lookup is done relative to this.   This works out to near constant time in most relevant
-    use cases because successive index lookups are most frequently adjacent.  The total number of
-    ranges is often quite small, which helps as well. If there is a need for faster random access
-    then a skip list like index may be an appropriate addition.
+    that group.  To avoid iterating over potentially all ranges when looking for a specific index,
+    the ranges are also the nodes of a treap, a randomly balanced binary tree, ordered the same as
+    the list, and each node holds the number of items in its subtree per group.  This allows the
+    range containing an index in any group to be found in logarithmic time.  Additionally the range
+    and indexes of the last lookup are cached and a lookup which falls within the same range is
+    resolved without consulting the tree, as successive index lookups are most frequently
+    adjacent.
 
     \sa VisualDataModel
 */
@@ -285,12 +286,14 @@ QQmlListCompositor::insert_iterator &QQmlListCompositor::insert_iterator::operat
 */
 
 QQmlListCompositor::QQmlListCompositor()
-    : m_end(m_ranges.next, 0, Default, 2)
+    : m_root(0)
+    , m_end(m_ranges.next, 0, Default, 2)
     , m_cacheIt(m_end)
     , m_groupCount(2)
     , m_defaultFlags(PrependFlag | DefaultFlag)
     , m_removeFlags(AppendFlag | PrependFlag | GroupMask)
     , m_moveId(0)
+    , m_seed(2463534242u)
 {
 }
 
@@ -314,7 +317,9 @@ QQmlListCompositor::~QQmlListCompositor()
 inline QQmlListCompositor::Range *QQmlListCompositor::insert(
         Range *before, void *list, int index, int count, uint flags)
 {
-    return new Range(before, list, index, count, flags);
+    Range *range = new Range(before, list, index, count, flags);
+    treeInsert(range);
+    return range;
 }
 
 /*!
@@ -326,6 +331,7 @@ inline QQmlListCompositor::Range *QQmlListCompositor::insert(
 inline QQmlListCompositor::Range *QQmlListCompositor::erase(
         Range *range)
 {
+    treeErase(range);
     Range *next = range->next;
     next->previous = range->previous;
     next->previous->next = range->next;
@@ -333,6 +339,179 @@ inline QQmlListCompositor::Range *QQmlListCompositor::erase(
     return next;
 }
 
+/*!
+    Recalculates the per group item totals of the subtree rooted at \a range from the totals of
+    its children.
+*/
+
+inline void QQmlListCompositor::computeTotals(Range *range)
+{
+    for (int i = 0; i < m_groupCount; ++i) {
+        int total = range->flags & (1 << i) ? range->count : 0;
+        if (range->left)
+            total += range->left->totals[i];
+        if (range->right)
+            total += range->right->totals[i];
+        range->totals[i] = total;
+    }
+}
+
+/*!
+    Recalculates the per group item totals of every range in the subtree rooted at \a range.
+*/
+
+void QQmlListCompositor::computeSubtreeTotals(Range *range)
+{
+    if (range->left)
+        computeSubtreeTotals(range->left);
+    if (range->right)
+        computeSubtreeTotals(range->right);
+    computeTotals(range);
+}
+
+/*!
+    Recalculates the per group item totals of \a range and all its ancestors.
+
+    This must be called whenever the count or group flags of a range in the tree change.
+*/
+
+inline void QQmlListCompositor::updateTotals(Range *range)
+{
+    for (; range; range = range->parent)
+        computeTotals(range);
+}
+
+/*!
+    Rotates \a range into the position of its parent, making the parent its child.
+*/
+
+inline void QQmlListCompositor::rotateUp(Range *range)
+{
+    Range *parent = range->parent;
+    Range *grandParent = parent->parent;
+
+    if (parent->left == range) {
+        parent->left = range->right;
+        if (parent->left)
+            parent->left->parent = parent;
+        range->right = parent;
+    } else {
+        parent->right = range->left;
+        if (parent->right)
+            parent->right->parent = parent;
+        range->left = parent;
+    }
+    parent->parent = range;
+    range->parent = grandParent;
+
+    if (!grandParent)
+        m_root = range;
+    else if (grandParent->left == parent)
+        grandParent->left = range;
+    else
+        grandParent->right = range;
+
+    computeTotals(parent);
+    computeTotals(range);
+}
+
+/*!
+    Adds a \a range which has just been linked into the list to the tree.
+
+    The range is added as a leaf adjacent to its neighbours in the list and then rotated up until
+    the heap order of the random priorities is restored.
+*/
+
+void QQmlListCompositor::treeInsert(Range *range)
+{
+    // xorshift32
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    range->priority = m_seed;
+
+    // Of two adjacent nodes in a binary tree either the first has no right child or the second
+    // has no left child.
+    if (range->previous != &m_ranges && !range->previous->right) {
+        range->previous->right = range;
+        range->parent = range->previous;
+    } else if (range->next != &m_ranges) {
+        Q_ASSERT(!range->next->left);
+        range->next->left = range;
+        range->parent = range->next;
+    } else {
+        Q_ASSERT(!m_root);
+        m_root = range;
+    }
+
+    computeTotals(range);
+    while (range->parent && range->priority > range->parent->priority)
+        rotateUp(range);
+    updateTotals(range->parent);
+}
+
+/*!
+    Removes a \a range from the tree, it remains linked into the list.
+*/
+
+void QQmlListCompositor::treeErase(Range *range)
+{
+    // Rotate the range down until it is a leaf.
+    while (range->left || range->right) {
+        if (!range->right || (range->left && range->left->priority > range->right->priority))
+            rotateUp(range->left);
+        else
+            rotateUp(range->right);
+    }
+
+    Range *parent = range->parent;
+    if (!parent)
+        m_root = 0;
+    else if (parent->left == range)
+        parent->left = 0;
+    else
+        parent->right = 0;
+    range->parent = 0;
+
+    updateTotals(parent);
+}
+
+/*!
+    Returns an iterator representing the item at \a index in a \a group, or the end of the
+    compositor if \a index is count(group).
+
+    The position is found by descending the tree, so unlike iterator::operator +=() it doesn't
+    depend on the cached iterator being valid.
+*/
+
+QQmlListCompositor::iterator QQmlListCompositor::findInTree(Group group, int index) const
+{
+    iterator it(const_cast<Range *>(&m_ranges), 0, group, m_groupCount);
+    for (Range *range = m_root; range;) {
+        if (Range *left = range->left) {
+            if (index < left->totals[group]) {
+                range = left;
+                continue;
+            }
+            index -= left->totals[group];
+            for (int i = 0; i < m_groupCount; ++i)
+                it.index[i] += left->totals[i];
+        }
+        if (range->inGroup(group)) {
+            if (index < range->count) {
+                it.range = range;
+                it.offset = index;
+                it.incrementIndexes(index);
+                return it;
+            }
+            index -= range->count;
+        }
+        it.incrementIndexes(range->count, range->flags);
+        range = range->right;
+    }
+    return it;
+}
+
 /*!
     Sets the number (\a count) of possible groups that items may belong to in a compositor.
 */
@@ -341,6 +520,12 @@ void QQmlListCompositor::setGroupCount(int count)
 {
     m_groupCount = count;
     m_end = iterator(&m_ranges, 0, Default, m_groupCount);
+    if (m_root) {
+        // The totals of groups that were not counted before are stale.
+        computeSubtreeTotals(m_root);
+        for (int i = 0; i < m_groupCount; ++i)
+            m_end.index[i] = m_root->totals[i];
+    }
     m_cacheIt = m_end;
 }
 
@@ -363,13 +548,14 @@ QQmlListCompositor::iterator QQmlListCompositor::find(Group group, int index)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index < count(group));
-    if (m_cacheIt == m_end) {
-        m_cacheIt = iterator(m_ranges.next, 0, group, m_groupCount);
-        m_cacheIt += index;
-    } else {
-        const int offset = index - m_cacheIt.index[group];
+    const int offset = m_cacheIt.offset + index - m_cacheIt.index[group];
+    if (m_cacheIt != m_end && m_cacheIt == group && offset >= 0 && offset < m_cacheIt->count) {
+        // The index is within the cached range.
         m_cacheIt.setGroup(group);
-        m_cacheIt += offset;
+        m_cacheIt.incrementIndexes(offset - m_cacheIt.offset);
+        m_cacheIt.offset = offset;
+    } else {
+        m_cacheIt = findInTree(group, index);
     }
     Q_ASSERT(m_cacheIt.index[group] == index);
     Q_ASSERT(m_cacheIt->inGroup(group));
@@ -404,15 +590,13 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index <= count(group));
-    insert_iterator it;
-    if (m_cacheIt == m_end) {
-        it = iterator(m_ranges.next, 0, group, m_groupCount);
-        it += index;
-    } else {
-        const int offset = index - m_cacheIt.index[group];
-        it = m_cacheIt;
-        it.setGroup(group);
-        it += offset;
+    insert_iterator it = findInTree(group, index);
+
+    // If the previous range contains the append flag move the iterator to the tail of the previous
+    // range so that appended appear after the insert position.
+    if (it.offset == 0 && it->previous->append()) {
+        *it = it->previous;
+        it.offset = it->inGroup() ? it->count : 0;
     }
     Q_ASSERT(it.index[group] == index);
     return it;
@@ -470,6 +654,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
                 *before, before->list, before->index, before.offset, before->flags & ~AppendFlag)->next;
         before->index += before.offset;
         before->count -= before.offset;
+        updateTotals(*before);
         before.offset = 0;
     }
 
@@ -481,6 +666,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
         // The insert arguments represent a continuation of the previous range so increment
         // its count instead of inserting a new range.
         before->previous->count += count;
+        updateTotals(before->previous);
         before.incrementIndexes(count, flags);
     } else {
         *before = insert(*before, list, index, count, flags);
@@ -494,6 +680,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
         // The current range and the next are continuous so add their counts and delete one.
         before->next->index = before->index;
         before->next->count += before->count;
+        updateTotals(before->next);
         *before = erase(*before);
     }
 
@@ -541,6 +728,7 @@ void QQmlListCompositor::setFlags(
         *from = insert(*from, from->list, from->index, from.offset, from->flags & ~AppendFlag)->next;
         from->index += from.offset;
         from->count -= from.offset;
+        updateTotals(*from);
         from.offset = 0;
     }
 
@@ -571,6 +759,8 @@ void QQmlListCompositor::setFlags(
             from->previous->count += difference;
             from->index += difference;
             from->count -= difference;
+            updateTotals(from->previous);
+            updateTotals(*from);
             if (from->count == 0) {
                 // Delete the current range if it is now empty, preserving the append flag
                 // in the previous range.
@@ -591,9 +781,11 @@ void QQmlListCompositor::setFlags(
             *from = insert(*from, from->list, from->index, difference, setFlags)->next;
             from->index += difference;
             from->count -= difference;
+            updateTotals(*from);
         } else {
             // The whole range is affected so simply update the flags.
             from->flags |= flags;
+            updateTotals(*from);
             continue;
         }
         from.incrementIndexes(from->count);
@@ -607,6 +799,7 @@ void QQmlListCompositor::setFlags(
         from.offset = from->previous->count;
         from->previous->count += from->count;
         from->previous->flags = from->flags;
+        updateTotals(from->previous);
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
@@ -653,6 +846,7 @@ void QQmlListCompositor::clearFlags(
         *from = insert(*from, from->list, from->index, from.offset, from->flags & ~AppendFlag)->next;
         from->index += from.offset;
         from->count -= from.offset;
+        updateTotals(*from);
         from.offset = 0;
     }
 
@@ -689,6 +883,8 @@ void QQmlListCompositor::clearFlags(
             from->previous->count += difference;
             from->index += difference;
             from->count -= difference;
+            updateTotals(from->previous);
+            updateTotals(*from);
             if (from->count == 0) {
                 // Delete the current range if it is now empty, preserving the append flag
                 if (from->append())
@@ -704,10 +900,12 @@ void QQmlListCompositor::clearFlags(
                 *from = insert(*from, from->list, from->index, difference, clearedFlags)->next;
             from->index += difference;
             from->count -= difference;
+            updateTotals(*from);
             from.incrementIndexes(from->count);
         } else if (clearedFlags) {
             // The whole range is affected so simply update the flags.
             from->flags &= ~flags;
+            updateTotals(*from);
         } else {
             // All flags have been removed from the range so remove it.
             *from = erase(*from)->previous;
@@ -722,6 +920,7 @@ void QQmlListCompositor::clearFlags(
         from.offset = from->previous->count;
         from->previous->count += from->count;
         from->previous->flags = from->flags;
+        updateTotals(from->previous);
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
@@ -795,6 +994,7 @@ void QQmlListCompositor::move(
                 *fromIt, fromIt->list, fromIt->index, fromIt.offset, fromIt->flags & ~AppendFlag)->next;
         fromIt->index += fromIt.offset;
         fromIt->count -= fromIt.offset;
+        updateTotals(*fromIt);
         fromIt.offset = 0;
     }
 
@@ -821,6 +1021,7 @@ void QQmlListCompositor::move(
             removes->append(Remove(fromIt, difference, fromIt->flags, ++moveId));
         count -= difference;
         fromIt->count -= difference;
+        updateTotals(*fromIt);
 
         // If the existing range contains the prepend flag replace the removed items with
         // a placeholder range for new items inserted into the source model.
@@ -832,6 +1033,7 @@ void QQmlListCompositor::move(
                 && fromIt->previous->end() == fromIt->index) {
             // Grow the previous range instead of creating a new one if possible.
             fromIt->previous->count += difference;
+            updateTotals(fromIt->previous);
         } else if (fromIt->prepend()) {
             *fromIt = insert(*fromIt, fromIt->list, removeIndex, difference, PrependFlag)->next;
         }
@@ -851,6 +1053,7 @@ void QQmlListCompositor::move(
                     && fromIt->previous->end() == fromIt->index) {
                 fromIt.incrementIndexes(fromIt->count);
                 fromIt->previous->count += fromIt->count;
+                updateTotals(fromIt->previous);
                 *fromIt = erase(*fromIt);
             }
         } else if (count > 0) {
@@ -869,15 +1072,16 @@ void QQmlListCompositor::move(
         fromIt.offset = fromIt->previous->count;
         fromIt->previous->count += fromIt->count;
         fromIt->previous->flags = fromIt->flags;
+        updateTotals(fromIt->previous);
         *fromIt = erase(*fromIt)->previous;
     }
 
     // Find the destination position of the move.
-    insert_iterator toIt = fromIt;
-    toIt.setGroup(toGroup);
-
-    const int difference = to - toIt.index[toGroup];
-    toIt += difference;
+    insert_iterator toIt = findInTree(toGroup, to);
+    if (toIt.offset == 0 && toIt->previous->append()) {
+        *toIt = toIt->previous;
+        toIt.offset = toIt->inGroup() ? toIt->count : 0;
+    }
 
     // If the insert position is part way through a range; split it and move the iterator to the
     // start of the second range.
@@ -885,6 +1089,7 @@ void QQmlListCompositor::move(
         *toIt = insert(*toIt, toIt->list, toIt->index, toIt.offset, toIt->flags & ~AppendFlag)->next;
         toIt->index += toIt.offset;
         toIt->count -= toIt.offset;
+        updateTotals(*toIt);
         toIt.offset = 0;
     }
 
@@ -897,6 +1102,7 @@ void QQmlListCompositor::move(
                 && range->flags == (toIt->flags & ~AppendFlag)) {
             toIt->index -= range->count;
             toIt->count += range->count;
+            updateTotals(*toIt);
         } else {
             *toIt = insert(*toIt, range->list, range->index, range->count, range->flags);
         }
@@ -909,6 +1115,7 @@ void QQmlListCompositor::move(
         toIt.offset = toIt->previous->count;
         toIt->previous->count += toIt->count;
         toIt->previous->flags = toIt->flags;
+        updateTotals(toIt->previous);
         *toIt = erase(*toIt)->previous;
     }
     // Create insert notification for the ranges moved.
@@ -998,6 +1205,7 @@ void QQmlListCompositor::listItemsInserted(
                         // Accumulate items on the current range it its flags are the same as
                         // the insert flags.
                         it->count += insertion.count;
+                        updateTotals(*it);
                     } else if (offset == 0
                             && it->previous != &m_ranges
                             && it->previous->list == list
@@ -1006,6 +1214,7 @@ void QQmlListCompositor::listItemsInserted(
                         // Attempt to append to the previous range if the insert position is at
                         // the start of the current range.
                         it->previous->count += insertion.count;
+                        updateTotals(it->previous);
                         it->index += insertion.count;
                         it.incrementIndexes(insertion.count);
                     } else {
@@ -1019,6 +1228,7 @@ void QQmlListCompositor::listItemsInserted(
                         it.incrementIndexes(insertion.count, flags);
                         it->index += offset + insertion.count;
                         it->count -= offset;
+                        updateTotals(*it);
                     }
                     m_end.incrementIndexes(insertion.count, flags);
                 } else {
@@ -1028,6 +1238,7 @@ void QQmlListCompositor::listItemsInserted(
                         *it = insert(*it, it->list, it->index, offset, it->flags)->next;
                         it->index += offset;
                         it->count -= offset;
+                        updateTotals(*it);
                     }
                     it->index += insertion.count;
                 }
@@ -1094,6 +1305,7 @@ void QQmlListCompositor::listItemsRemoved(
                 const int offset = qMax(0, relativeIndex);
                 int removeCount = qMin(it->count, relativeIndex + removal->count) - offset;
                 it->count -= removeCount;
+                updateTotals(*it);
                 int removeFlags = it->flags & m_removeFlags;
                 Remove translatedRemoval(it, removeCount, it->flags);
                 for (int i = 0; i < m_groupCount; ++i) {
@@ -1157,6 +1369,7 @@ void QQmlListCompositor::listItemsRemoved(
                             *it = insert(*it, it->list, it->index, offset, it->flags & ~AppendFlag)->next;
                             it->index += offset;
                             it->count -= offset;
+                            updateTotals(*it);
                             it.incrementIndexes(offset);
                         }
                         if (it->previous != &m_ranges
@@ -1164,6 +1377,7 @@ void QQmlListCompositor::listItemsRemoved(
                                 && it->end() == insertion->index
                                 && it->previous->flags == (it->flags | MovedFlag)) {
                             it->previous->count += removeCount;
+                            updateTotals(it->previous);
                         } else {
                             *it = insert(*it, it->list, insertion->index, removeCount, it->flags | MovedFlag)->next;
                         }
@@ -1179,12 +1393,14 @@ void QQmlListCompositor::listItemsRemoved(
                         *it = insert(*it, it->list, it->index, offset, it->flags & ~AppendFlag)->next;
                         it->index += offset;
                         it->count -= offset;
+                        updateTotals(*it);
                         it.incrementIndexes(offset);
                     }
                     if (it->previous != &m_ranges
                             && it->previous->list == it->list
                             && it->previous->flags == CacheFlag) {
                         it->previous->count += removeCount;
+                        updateTotals(it->previous);
                     } else {
                         *it = insert(*it, it->list, -1, removeCount, CacheFlag)->next;
                     }
@@ -1215,6 +1431,7 @@ void QQmlListCompositor::listItemsRemoved(
                     it.decrementIndexes(it->previous->count);
                     it->previous->count += it->count;
                     it->previous->flags = it->flags;
+                    updateTotals(it->previous);
                     *it = erase(*it)->previous;
                 }
             }
@@ -1223,6 +1440,7 @@ void QQmlListCompositor::listItemsRemoved(
             // Compress consecutive cache only ranges.
             it.index[Cache] += it->next->count;
             it->count += it->next->count;
+            updateTotals(*it);
             erase(it->next);
         } else if (!removed) {
             it.incrementIndexes(it->count);
@@ -87,9 +87,11 @@ public:
     class Range
     {
     public:
-        Range() : next(this), previous(this), list(0), index(0), count(0), flags(0) {}
+        Range() : next(this), previous(this), list(0), index(0), count(0), flags(0)
+            , parent(0), left(0), right(0), priority(0) {}
         Range(Range *next, void *list, int index, int count, uint flags)
-            : next(next), previous(next->previous), list(list), index(index), count(count), flags(flags) {
+            : next(next), previous(next->previous), list(list), index(index), count(count), flags(flags)
+            , parent(0), left(0), right(0), priority(0) {
             next->previous = this; previous->next = this; }
 
         Range *next;
@@ -99,6 +101,14 @@ public:
         int count;
         uint flags;
 
+        // Ranges are also the nodes of a treap ordered the same as the list, where each node
+        // holds the number of items in its subtree that are members of each group.
+        Range *parent;
+        Range *left;
+        Range *right;
+        uint priority;
+        int totals[MaximumGroupCount];
+
         inline int start() const { return index; }
         inline int end() const { return index + count; }
 
@@ -266,16 +276,26 @@ public:
 
 private:
     Range m_ranges;
+    Range *m_root;
     iterator m_end;
     iterator m_cacheIt;
     int m_groupCount;
     int m_defaultFlags;
     int m_removeFlags;
     int m_moveId;
+    uint m_seed;
 
     inline Range *insert(Range *before, void *list, int index, int count, uint flags);
     inline Range *erase(Range *range);
 
+    iterator findInTree(Group group, int index) const;
+    inline void computeTotals(Range *range);
+    void computeSubtreeTotals(Range *range);
+    inline void updateTotals(Range *range);
+    inline void rotateUp(Range *range);
+    void treeInsert(Range *range);
+    void treeErase(Range *range);
+
     struct MovedFlags
     {
         MovedFlags() {}
@@ -185,6 +185,7 @@ public:
     void removeItem(FxViewItem *item);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void initializeViewItem(FxViewItem *item) override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
@@ -457,6 +458,12 @@ void QQuickGridViewPrivate::resetColumns()
     columns = qMax(1, qFloor(length / colSize()));
 }
 
+QQuickItemViewAttached *QQuickGridViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickGridView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
 FxViewItem *QQuickGridViewPrivate::newViewItem(int modelIndex, QQuickItem *item)
 {
     Q_Q(QQuickGridView);
@@ -573,7 +580,7 @@ void QQuickGridViewPrivate::removeItem(FxViewItem *item)
         item->releaseAfterTransition = true;
         releasePendingTransition.append(item);
     } else {
-        releaseItem(item);
+        releaseItem(item, reusableFlag());
     }
 }
 
@@ -1308,6 +1315,51 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::GridView::pooled()
+    \since 5.10
+
+    This attached signal is emitted after an item has been moved out of the
+    view and put into the pool of reusable items, when \l reuseItems is
+    \c true. The item is hidden while it is pooled.
+
+    The corresponding handler is \c onPooled.
+
+    \sa reused(), reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::reused()
+    \since 5.10
+
+    This attached signal is emitted after a pooled item has been bound to the
+    data of another index and is about to be shown again. Use it to reset
+    state that is not derived from the model, such as a running animation.
+
+    The corresponding handler is \c onReused.
+
+    \sa pooled(), reuseItems
+*/
+
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since 5.10
+
+    This property determines whether delegate items that are moved out of the
+    view and its \l cacheBuffer are kept and reused for the items moved into
+    it, instead of being destroyed and created again.
+
+    A reused item keeps its bindings; only the model data it is bound to
+    (\c index, \c modelData and the model roles) changes. State that is not
+    derived from the model has to be reset in the \l reused() handler. Items
+    are not reused if the delegate uses the DelegateModel attached properties,
+    or if the model is a list of QObjects. Pooled items that have not been
+    reused after a few refills of the view are destroyed.
+
+    The default value is \c false.
+*/
+
+
 
 /*!
   \qmlproperty model QtQuick::GridView::model
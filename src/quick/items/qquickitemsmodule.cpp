@@ -385,6 +385,16 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
     qmlRegisterUncreatableType<QQuickBasePositioner, 9>(uri, 2, 9, "Positioner",
                                                   QStringLiteral("Positioner is an abstract type that is only available as an attached property."));
 #endif
+
+#if QT_CONFIG(quick_listview)
+    qmlRegisterType<QQuickListView, 10>(uri, 2, 10, "ListView");
+#endif
+#if QT_CONFIG(quick_gridview)
+    qmlRegisterType<QQuickGridView, 10>(uri, 2, 10, "GridView");
+#endif
+#if QT_CONFIG(quick_itemview)
+    qmlRegisterUncreatableType<QQuickItemView, 10>(uri, 2, 10, itemViewName, itemViewMessage);
+#endif
 }
 
 static void initResources()
@@ -40,6 +40,8 @@
 #include "qquickitemview_p_p.h"
 #include <QtQuick/private/qquicktransition_p.h>
 #include <QtQml/QQmlInfo>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlincubator.h>
 #include "qplatformdefs.h"
 
 QT_BEGIN_NAMESPACE
@@ -51,6 +53,11 @@ Q_LOGGING_CATEGORY(lcItemViewDelegateLifecycle, "qt.quick.itemview.lifecycle")
 #define QML_VIEW_DEFAULTCACHEBUFFER 320
 #endif
 
+// Time in ms, at the current velocity, that delegates are created ahead of a scrolling view.
+#ifndef QML_VIEW_PREDICTIVEBUFFERTIME
+#define QML_VIEW_PREDICTIVEBUFFERTIME 250
+#endif
+
 FxViewItem::FxViewItem(QQuickItem *i, QQuickItemView *v, bool own, QQuickItemViewAttached *attached)
     : item(i)
     , view(v)
@@ -299,6 +306,8 @@ void QQuickItemView::setModel(const QVariant &m)
         disconnect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         disconnect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         disconnect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        disconnect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        disconnect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
     }
 
     QQmlInstanceModel *oldModel = d->model;
@@ -334,6 +343,8 @@ void QQuickItemView::setModel(const QVariant &m)
         connect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         connect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         connect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        connect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        connect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
         if (isComponentComplete()) {
             d->updateSectionCriteria();
             d->refill();
@@ -796,6 +807,23 @@ void QQuickItemView::setHighlightMoveDuration(int duration)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems == reuse)
+        return;
+    d->reuseItems = reuse;
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+    emit reuseItemsChanged();
+}
+
 QQuickTransition *QQuickItemView::populateTransition() const
 {
     Q_D(const QQuickItemView);
@@ -1561,7 +1589,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
-    , runDelayedRemoveTransition(false), delegateValidated(false)
+    , runDelayedRemoveTransition(false), delegateValidated(false), reuseItems(false)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
     bufferPause.setLoopCount(1);
@@ -1755,6 +1783,9 @@ void QQuickItemViewPrivate::clear()
     createHighlight();
     trackedItem = 0;
 
+    if (model)
+        model->drainReusableItemsPool(0);
+
     if (requestedIndex >= 0) {
         if (model)
             model->cancel(requestedIndex);
@@ -1801,8 +1832,23 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
 
     int prevCount = itemCount;
     itemCount = model->count();
-    qreal bufferFrom = from - buffer;
-    qreal bufferTo = to + buffer;
+
+    // While scrolling, buffer further ahead in the direction of travel and release the items
+    // behind the view sooner.
+    qreal bufferBefore = buffer;
+    qreal bufferAfter = buffer;
+    if (const qreal lookAhead = predictiveBuffer()) {
+        if (bufferMode == BufferAfter) {
+            bufferAfter += lookAhead;
+            bufferBefore = qMax(qreal(0), bufferBefore - lookAhead);
+        } else {
+            bufferBefore += lookAhead;
+            bufferAfter = qMax(qreal(0), bufferAfter - lookAhead);
+        }
+    }
+
+    qreal bufferFrom = from - bufferBefore;
+    qreal bufferTo = to + bufferAfter;
     qreal fillFrom = from;
     qreal fillTo = to;
 
@@ -1832,10 +1878,44 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
         updateViewport();
     }
 
+    // Destroy the pooled delegates that have not been reused by the last couple of refills,
+    // so that a view which has stopped scrolling doesn't keep them around.
+    if (reuseItems)
+        model->drainReusableItemsPool(2);
+
     if (prevCount != itemCount)
         emit q->countChanged();
 }
 
+/*
+    Returns the distance beyond the cache buffer to create delegates ahead of a scrolling view;
+    that covered at the current velocity in QML_VIEW_PREDICTIVEBUFFERTIME.
+
+    Buffered delegates are incubated asynchronously.  If more of them are still incubating than
+    the view shows at once the distance is reduced in proportion, so a view flicked faster than
+    its delegates can be created doesn't keep queueing more of them.
+*/
+qreal QQuickItemViewPrivate::predictiveBuffer() const
+{
+    Q_Q(const QQuickItemView);
+    if (!buffer || (bufferMode != BufferBefore && bufferMode != BufferAfter))
+        return 0;
+
+    const qreal velocity = qAbs(layoutOrientation() == Qt::Vertical
+            ? vData.smoothVelocity.value()
+            : hData.smoothVelocity.value());
+    qreal distance = qMin(velocity * QML_VIEW_PREDICTIVEBUFFERTIME / 1000, size());
+
+    QQmlEngine *engine = qmlEngine(q);
+    if (QQmlIncubationController *controller = engine ? engine->incubationController() : 0) {
+        const int budget = qMax(visibleItems.count(), 1);
+        const int incubating = controller->incubatingObjectCount();
+        if (incubating > budget)
+            distance = distance * budget / incubating;
+    }
+    return distance;
+}
+
 void QQuickItemViewPrivate::regenerate(bool orientationChanged)
 {
     Q_Q(QQuickItemView);
@@ -2007,6 +2087,7 @@ bool QQuickItemViewPrivate::applyModelChanges(ChangeResult *totalInsertionResult
     int removedCount = 0;
     for (const QQmlChangeSet::Change &r : removals) {
         itemCount -= r.count;
+        modelRowsRemoved(r);
         if (applyRemovalChange(r, &removalResult, &removedCount))
             visibleAffected = true;
         if (!visibleAffected && needsRefillForAddedOrRemovedIndex(r.index))
@@ -2048,6 +2129,7 @@ bool QQuickItemViewPrivate::applyModelChanges(ChangeResult *totalInsertionResult
 
     for (int i=0; i<insertions.count(); i++) {
         bool wasEmpty = visibleItems.isEmpty();
+        modelRowsInserted(insertions[i]);
         if (applyInsertionChange(insertions[i], &insertionResult, &newItems, &movingIntoView))
             visibleAffected = true;
         if (!visibleAffected && needsRefillForAddedOrRemovedIndex(insertions[i].index))
@@ -2402,7 +2484,23 @@ void QQuickItemView::destroyingItem(QObject *object)
     }
 }
 
-bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
+void QQuickItemView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        attached->emitPooled();
+}
+
+void QQuickItemView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        attached->emitReused();
+}
+
+bool QQuickItemViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_Q(QQuickItemView);
     if (!item || !model)
@@ -2411,7 +2509,7 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         trackedItem = 0;
     item->trackGeometry(false);
 
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item, reusableFlag);
     if (item->item) {
         if (flags == 0) {
             // item was not destroyed, and we no longer reference it.
@@ -2419,6 +2517,9 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
             unrequestedItems.insert(item->item, model->indexOf(item->item, q));
         } else if (flags & QQmlInstanceModel::Destroyed) {
             item->item->setParentItem(0);
+        } else if (flags & QQmlInstanceModel::Pooled) {
+            // kept by the model for another index; hide it until it is reused.
+            QQuickItemPrivate::get(item->item)->setCulled(true);
         }
     }
     delete item;
@@ -204,10 +204,15 @@ public:
     virtual void animationFinished(QAbstractAnimationJob *) override;
     void refill();
     void refill(qreal from, qreal to);
+    qreal predictiveBuffer() const;
     void mirrorChange() override;
 
     FxViewItem *createItem(int modelIndex, bool asynchronous = false);
-    virtual bool releaseItem(FxViewItem *item);
+    virtual bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    QQmlInstanceModel::ReusableFlag reusableFlag() const {
+        return reuseItems ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable;
+    }
+    virtual QQuickItemViewAttached *getAttachedObject(const QObject *) const { return 0; }
 
     QQuickItem *createHighlightItem() const;
     QQuickItem *createComponentItem(QQmlComponent *component, qreal zValue, bool createDefault = false) const;
@@ -341,6 +346,7 @@ public:
     bool inRequest : 1;
     bool runDelayedRemoveTransition : 1;
     bool delegateValidated : 1;
+    bool reuseItems : 1;
 
 protected:
     virtual Qt::Orientation layoutOrientation() const = 0;
@@ -385,6 +391,8 @@ protected:
                 QList<FxViewItem *> *newItems, QList<MovedItem> *movingIntoView) = 0;
 
     virtual bool needsRefillForAddedOrRemovedIndex(int) const { return false; }
+    virtual void modelRowsRemoved(const QQmlChangeSet::Change &) {}
+    virtual void modelRowsInserted(const QQmlChangeSet::Change &) {}
     virtual void translateAndTransitionItemsAfter(int afterIndex, const ChangeResult &insertionResult, const ChangeResult &removalResult) = 0;
 
     virtual void initializeViewItem(FxViewItem *) {}
@@ -59,6 +59,183 @@ QT_BEGIN_NAMESPACE
 
 class FxListItemSG;
 
+/*
+    Records the measured size of the delegates of a list, so that positions outside the visible
+    items can be estimated from them rather than from the average size of the visible items only.
+
+    Rows that have not been measured are estimated with the size passed to extent() and
+    indexAt().  The sums are kept in two Fenwick trees, one of the measured sizes and one of the
+    number of measured rows, so both conversions between index and position are O(log n).  The
+    trees are rebuilt in O(n) after rows are inserted or removed, which happens far less often
+    than a lookup.
+*/
+class QQuickListViewItemSizes
+{
+public:
+    QQuickListViewItemSizes() : m_measuredSum(0), m_measuredCount(0), m_dirty(false) {}
+
+    void clear();
+    void insert(int index, int count);
+    void remove(int index, int count);
+    void setSize(int index, qreal size);
+
+    int measuredCount() const { return m_measuredCount; }
+    qreal averageSize() const { return m_measuredCount ? m_measuredSum / m_measuredCount : 0; }
+    qreal extent(int from, int to, qreal estimate) const;
+    int indexAt(qreal extent, qreal estimate, qreal spacing) const;
+
+private:
+    qreal prefixExtent(int index, qreal estimate) const;
+    void rebuild() const;
+
+    QVector<qreal> m_sizes;     // < 0 if not measured
+    mutable QVector<qreal> m_sumTree;
+    mutable QVector<int> m_countTree;
+    qreal m_measuredSum;
+    int m_measuredCount;
+    mutable bool m_dirty;
+};
+
+void QQuickListViewItemSizes::clear()
+{
+    m_sizes.clear();
+    m_sumTree.clear();
+    m_countTree.clear();
+    m_measuredSum = 0;
+    m_measuredCount = 0;
+    m_dirty = false;
+}
+
+void QQuickListViewItemSizes::insert(int index, int count)
+{
+    // Rows past the end are unmeasured anyway.
+    if (index >= m_sizes.count())
+        return;
+    m_sizes.insert(index, count, -1);
+    m_dirty = true;
+}
+
+void QQuickListViewItemSizes::remove(int index, int count)
+{
+    count = qMin(count, m_sizes.count() - index);
+    if (count <= 0)
+        return;
+    for (int i = index; i < index + count; ++i) {
+        if (m_sizes.at(i) >= 0) {
+            m_measuredSum -= m_sizes.at(i);
+            --m_measuredCount;
+        }
+    }
+    m_sizes.remove(index, count);
+    m_dirty = true;
+}
+
+void QQuickListViewItemSizes::setSize(int index, qreal size)
+{
+    if (index < 0 || size < 0)
+        return;
+    if (index >= m_sizes.count()) {
+        m_sizes.insert(m_sizes.count(), index + 1 - m_sizes.count(), -1);
+        m_dirty = true;
+    }
+
+    const qreal oldSize = m_sizes.at(index);
+    if (oldSize == size)
+        return;
+    m_sizes[index] = size;
+
+    const qreal sizeChange = oldSize < 0 ? size : size - oldSize;
+    const int countChange = oldSize < 0 ? 1 : 0;
+    m_measuredSum += sizeChange;
+    m_measuredCount += countChange;
+    if (m_dirty)
+        return;
+    for (int i = index + 1; i < m_sumTree.count(); i += i & -i) {
+        m_sumTree[i] += sizeChange;
+        m_countTree[i] += countChange;
+    }
+}
+
+void QQuickListViewItemSizes::rebuild() const
+{
+    const int n = m_sizes.count();
+    m_sumTree.fill(0, n + 1);
+    m_countTree.fill(0, n + 1);
+    for (int i = 1; i <= n; ++i) {
+        const qreal size = m_sizes.at(i - 1);
+        if (size >= 0) {
+            m_sumTree[i] += size;
+            m_countTree[i] += 1;
+        }
+        const int parent = i + (i & -i);
+        if (parent <= n) {
+            m_sumTree[parent] += m_sumTree.at(i);
+            m_countTree[parent] += m_countTree.at(i);
+        }
+    }
+    m_dirty = false;
+}
+
+// The extent of the rows before index, excluding spacing.
+qreal QQuickListViewItemSizes::prefixExtent(int index, qreal estimate) const
+{
+    if (m_dirty)
+        rebuild();
+    const int measured = qMin(index, m_sizes.count());
+    qreal sum = 0;
+    int count = 0;
+    for (int i = measured; i > 0; i -= i & -i) {
+        sum += m_sumTree.at(i);
+        count += m_countTree.at(i);
+    }
+    return sum + (index - count) * estimate;
+}
+
+/*
+    Returns the extent of the rows from \a from up to, but not including, \a to, excluding
+    spacing.  Unmeasured rows are \a estimate in size.
+*/
+qreal QQuickListViewItemSizes::extent(int from, int to, qreal estimate) const
+{
+    if (to <= from)
+        return 0;
+    return prefixExtent(to, estimate) - prefixExtent(from, estimate);
+}
+
+/*
+    Returns the largest index for which the extent of the rows before it, each followed by
+    \a spacing, does not exceed \a extent.
+*/
+int QQuickListViewItemSizes::indexAt(qreal extent, qreal estimate, qreal spacing) const
+{
+    if (extent <= 0)
+        return 0;
+    if (m_dirty)
+        rebuild();
+
+    const int n = m_sizes.count();
+    int index = 0;
+    qreal sum = 0;
+    int step = 1;
+    while (step * 2 <= n)
+        step *= 2;
+    for (; step > 0; step /= 2) {
+        const int next = index + step;
+        if (next > n)
+            continue;
+        const qreal stepExtent = m_sumTree.at(next) + (step - m_countTree.at(next)) * estimate
+                + step * spacing;
+        if (sum + stepExtent <= extent) {
+            index = next;
+            sum += stepExtent;
+        }
+    }
+
+    if (index == n && estimate + spacing > 0)
+        index += qFloor((extent - sum) / (estimate + spacing));
+    return index;
+}
+
 class QQuickListViewPrivate : public QQuickItemViewPrivate
 {
     Q_DECLARE_PUBLIC(QQuickListView)
@@ -91,7 +268,8 @@ public:
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
     void initializeViewItem(FxViewItem *item) override;
-    bool releaseItem(FxViewItem *item) override;
+    bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
     void resetFirstItemPosition(qreal pos = 0.0) override;
@@ -131,6 +309,11 @@ public:
     void initializeCurrentItem() override;
 
     void updateAverage();
+    void updateItemSize(FxViewItem *item);
+    qreal estimatedExtent(int from, int to) const;
+
+    void modelRowsRemoved(const QQmlChangeSet::Change &removal) override;
+    void modelRowsInserted(const QQmlChangeSet::Change &insertion) override;
 
     void itemGeometryChanged(QQuickItem *item, QQuickGeometryChange change, const QRectF &oldGeometry) override;
     void fixupPosition() override;
@@ -165,9 +348,12 @@ public:
     QString lastVisibleSection;
     QString nextSection;
 
+    QQuickListViewItemSizes itemSizes;
+
     qreal overshootDist;
     bool correctFlick : 1;
     bool inFlickCorrection : 1;
+    bool trackItemSizes : 1;
 
     QQuickListViewPrivate()
         : orient(QQuickListView::Vertical)
@@ -179,7 +365,7 @@ public:
         , highlightPosAnimator(0), highlightWidthAnimator(0), highlightHeightAnimator(0)
         , highlightMoveVelocity(400), highlightResizeVelocity(400), highlightResizeDuration(-1)
         , sectionCriteria(0), currentSectionItem(0), nextSectionItem(0)
-        , overshootDist(0.0), correctFlick(false), inFlickCorrection(false)
+        , overshootDist(0.0), correctFlick(false), inFlickCorrection(false), trackItemSizes(false)
     {
         highlightMoveDuration = -1; //override default value set in base class
     }
@@ -427,7 +613,7 @@ qreal QQuickListViewPrivate::originPosition() const
     if (!visibleItems.isEmpty()) {
         pos = (*visibleItems.constBegin())->position();
         if (visibleIndex > 0)
-            pos -= visibleIndex * (averageSize + spacing);
+            pos -= estimatedExtent(0, visibleIndex);
     }
     return pos;
 }
@@ -454,9 +640,9 @@ qreal QQuickListViewPrivate::lastPosition() const
         }
         pos = (*(--visibleItems.constEnd()))->endPosition();
         if (invisibleCount > 0)
-            pos += invisibleCount * (averageSize + spacing);
+            pos += estimatedExtent(model->count() - invisibleCount, model->count());
     } else if (model && model->count()) {
-        pos = (model->count() * averageSize + (model->count()-1) * spacing);
+        pos = estimatedExtent(0, model->count()) - spacing;
     }
     return pos;
 }
@@ -468,16 +654,16 @@ qreal QQuickListViewPrivate::positionAt(int modelIndex) const
     }
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
+            int from = modelIndex;
             qreal cs = 0;
             if (modelIndex == currentIndex && currentItem) {
                 cs = currentItem->size() + spacing;
-                --count;
+                ++from;
             }
-            return (*visibleItems.constBegin())->position() - count * (averageSize + spacing) - cs;
+            return (*visibleItems.constBegin())->position() - estimatedExtent(from, visibleIndex) - cs;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + spacing + count * (averageSize + spacing);
+            int from = findLastVisibleIndex(visibleIndex) + 1;
+            return (*(--visibleItems.constEnd()))->endPosition() + spacing + estimatedExtent(from, modelIndex);
         }
     }
     return 0;
@@ -489,11 +675,10 @@ qreal QQuickListViewPrivate::endPositionAt(int modelIndex) const
         return item->endPosition();
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
-            return (*visibleItems.constBegin())->position() - (count - 1) * (averageSize + spacing) - spacing;
+            return (*visibleItems.constBegin())->position() - estimatedExtent(modelIndex + 1, visibleIndex) - spacing;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + count * (averageSize + spacing);
+            int from = findLastVisibleIndex(visibleIndex) + 1;
+            return (*(--visibleItems.constEnd()))->endPosition() + estimatedExtent(from, modelIndex);
         }
     }
     return 0;
@@ -564,6 +749,7 @@ void QQuickListViewPrivate::clear()
         sectionCache[i] = 0;
     }
     visiblePos = 0;
+    itemSizes.clear();
     releaseSectionItem(currentSectionItem);
     currentSectionItem = 0;
     releaseSectionItem(nextSectionItem);
@@ -572,6 +758,12 @@ void QQuickListViewPrivate::clear()
     QQuickItemViewPrivate::clear();
 }
 
+QQuickItemViewAttached *QQuickListViewPrivate::getAttachedObject(const QObject *object) const
+{
+    QObject *attachedObject = qmlAttachedPropertiesObject<QQuickListView>(object, false);
+    return static_cast<QQuickItemViewAttached *>(attachedObject);
+}
+
 FxViewItem *QQuickListViewPrivate::newViewItem(int modelIndex, QQuickItem *item)
 {
     Q_Q(QQuickListView);
@@ -613,7 +805,7 @@ void QQuickListViewPrivate::initializeViewItem(FxViewItem *item)
     }
 }
 
-bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
+bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return true;
@@ -621,7 +813,7 @@ bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
     QPointer<QQuickItem> it = item->item;
     QQuickListViewAttached *att = static_cast<QQuickListViewAttached*>(item->attached);
 
-    bool released = QQuickItemViewPrivate::releaseItem(item);
+    bool released = QQuickItemViewPrivate::releaseItem(item, reusableFlag);
     if (released && it && att && att->m_sectionItem) {
         // We hold no more references to this item
         int i = 0;
@@ -657,14 +849,22 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
         || bufferTo < visiblePos - averageSize - spacing)) {
         // We've jumped more than a page.  Estimate which items are now
         // visible and fill from there.
-        int count = (fillFrom - itemEnd) / (averageSize + spacing);
-        int newModelIdx = qBound(0, modelIndex + count, model->count());
-        count = newModelIdx - modelIndex;
-        if (count) {
+        int newModelIdx;
+        if (trackItemSizes) {
+            const qreal extent = estimatedExtent(0, modelIndex) + fillFrom - itemEnd;
+            newModelIdx = itemSizes.indexAt(extent, averageSize, spacing);
+        } else {
+            newModelIdx = modelIndex + int((fillFrom - itemEnd) / (averageSize + spacing));
+        }
+        newModelIdx = qBound(0, newModelIdx, model->count());
+        if (newModelIdx != modelIndex) {
             releaseVisibleItems();
+            if (newModelIdx > modelIndex)
+                visiblePos = itemEnd + estimatedExtent(modelIndex, newModelIdx);
+            else
+                visiblePos = itemEnd - estimatedExtent(newModelIdx, modelIndex);
             modelIndex = newModelIdx;
             visibleIndex = modelIndex;
-            visiblePos = itemEnd + count * (averageSize + spacing);
             itemEnd = visiblePos;
         }
     }
@@ -714,7 +914,7 @@ void QQuickListViewPrivate::removeItem(FxViewItem *item)
         releasePendingTransition.append(item);
     } else {
         qCDebug(lcItemViewDelegateLifecycle) << "\treleasing stationary item" << item->index << (QObject *)(item->item);
-        releaseItem(item);
+        releaseItem(item, reusableFlag());
     }
 }
 
@@ -789,6 +989,8 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
         qreal pos = firstItem->position() + firstItem->size() + spacing;
         firstItem->setVisible(firstItem->endPosition() >= from && firstItem->position() <= to);
 
+        updateItemSize(firstItem);
+
         for (int i=1; i < visibleItems.count(); ++i) {
             FxListItemSG *item = static_cast<FxListItemSG*>(visibleItems.at(i));
             if (item->index >= fromModelIndex) {
@@ -797,9 +999,10 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
             }
             pos += item->size() + spacing;
             sum += item->size();
+            updateItemSize(item);
             fixedCurrent = fixedCurrent || (currentItem && item->item == currentItem->item);
         }
-        averageSize = qRound(sum / visibleItems.count());
+        averageSize = qRound(trackItemSizes && itemSizes.measuredCount() ? itemSizes.averageSize() : sum / visibleItems.count());
 
         // move current item if it is not a visible item.
         if (currentIndex >= 0 && currentItem && !fixedCurrent)
@@ -1293,6 +1496,7 @@ void QQuickListViewPrivate::initializeCurrentItem()
             }
         }
 
+        updateItemSize(listItem);
         if (visibleItems.isEmpty())
             averageSize = listItem->size();
     }
@@ -1303,9 +1507,43 @@ void QQuickListViewPrivate::updateAverage()
     if (!visibleItems.count())
         return;
     qreal sum = 0.0;
-    for (FxViewItem *item : qAsConst(visibleItems))
+    for (FxViewItem *item : qAsConst(visibleItems)) {
         sum += item->size();
-    averageSize = qRound(sum / visibleItems.count());
+        updateItemSize(item);
+    }
+    averageSize = qRound(trackItemSizes && itemSizes.measuredCount() ? itemSizes.averageSize() : sum / visibleItems.count());
+}
+
+void QQuickListViewPrivate::updateItemSize(FxViewItem *item)
+{
+    if (trackItemSizes && item->index != -1)
+        itemSizes.setSize(item->index, item->size());
+}
+
+/*
+    Returns the extent of the items from \a from up to, but not including, \a to, including
+    the spacing after each of them.  Items outside visibleItems are estimated with their recorded
+    size if trackItemSizes is set, otherwise with the average size.
+*/
+qreal QQuickListViewPrivate::estimatedExtent(int from, int to) const
+{
+    if (to <= from)
+        return 0;
+    if (trackItemSizes)
+        return itemSizes.extent(from, to, averageSize) + (to - from) * spacing;
+    return (to - from) * (averageSize + spacing);
+}
+
+void QQuickListViewPrivate::modelRowsRemoved(const QQmlChangeSet::Change &removal)
+{
+    if (trackItemSizes)
+        itemSizes.remove(removal.index, removal.count);
+}
+
+void QQuickListViewPrivate::modelRowsInserted(const QQmlChangeSet::Change &insertion)
+{
+    if (trackItemSizes)
+        itemSizes.insert(insertion.index, insertion.count);
 }
 
 qreal QQuickListViewPrivate::headerSize() const
@@ -1972,6 +2210,51 @@ QQuickListView::~QQuickListView()
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::ListView::pooled()
+    \since 5.10
+
+    This attached signal is emitted after an item has been moved out of the
+    view and put into the pool of reusable items, when \l reuseItems is
+    \c true. The item is hidden while it is pooled.
+
+    The corresponding handler is \c onPooled.
+
+    \sa reused(), reuseItems
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::reused()
+    \since 5.10
+
+    This attached signal is emitted after a pooled item has been bound to the
+    data of another index and is about to be shown again. Use it to reset
+    state that is not derived from the model, such as a running animation.
+
+    The corresponding handler is \c onReused.
+
+    \sa pooled(), reuseItems
+*/
+
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since 5.10
+
+    This property determines whether delegate items that are moved out of the
+    view and its \l cacheBuffer are kept and reused for the items moved into
+    it, instead of being destroyed and created again.
+
+    A reused item keeps its bindings; only the model data it is bound to
+    (\c index, \c modelData and the model roles) changes. State that is not
+    derived from the model has to be reset in the \l reused() handler. Items
+    are not reused if the delegate uses the DelegateModel attached properties,
+    or if the model is a list of QObjects. Pooled items that have not been
+    reused after a few refills of the view are destroyed.
+
+    The default value is \c false.
+*/
+
+
 /*!
     \qmlproperty model QtQuick::ListView::model
     This property holds the model providing data for the list.
@@ -2674,6 +2957,45 @@ void QQuickListView::setFooterPositioning(QQuickListView::FooterPositioning posi
     }
 }
 
+/*!
+    \qmlproperty bool QtQuick::ListView::trackItemSizes
+    \since 5.10
+
+    This property determines whether the list view remembers the size of
+    every delegate item it has created.
+
+    The position of the items outside the view, and with it the content size,
+    is otherwise estimated from the average size of the items currently
+    created. For a large model with delegates of differing sizes that estimate
+    changes as the view is scrolled, so \l {Flickable::}{contentHeight} (or
+    \l {Flickable::}{contentWidth}) and positionViewAtIndex() can jump around.
+    When this property is \c true, the remembered sizes are used for the items
+    that have been created before, and the average of all remembered sizes for
+    the others. Looking up a position by index or an index by position then
+    takes logarithmic time in the size of the model.
+
+    The sizes are forgotten when the model is reset or the delegate changes.
+
+    The default value is \c false.
+*/
+bool QQuickListView::trackItemSizes() const
+{
+    Q_D(const QQuickListView);
+    return d->trackItemSizes;
+}
+
+void QQuickListView::setTrackItemSizes(bool track)
+{
+    Q_D(QQuickListView);
+    if (d->trackItemSizes != track) {
+        d->applyPendingChanges();
+        d->trackItemSizes = track;
+        d->itemSizes.clear();
+        d->forceLayoutPolish();
+        emit trackItemSizesChanged();
+    }
+}
+
 /*!
     \qmlproperty Transition QtQuick::ListView::populate
 
@@ -129,6 +129,8 @@ class Q_QUICK_PRIVATE_EXPORT QQuickListView : public QQuickItemView
     Q_PROPERTY(HeaderPositioning headerPositioning READ headerPositioning WRITE setHeaderPositioning NOTIFY headerPositioningChanged REVISION 2)
     Q_PROPERTY(FooterPositioning footerPositioning READ footerPositioning WRITE setFooterPositioning NOTIFY footerPositioningChanged REVISION 2)
 
+    Q_PROPERTY(bool trackItemSizes READ trackItemSizes WRITE setTrackItemSizes NOTIFY trackItemSizesChanged REVISION 10)
+
     Q_CLASSINFO("DefaultProperty", "data")
 
 public:
@@ -174,6 +176,9 @@ public:
     FooterPositioning footerPositioning() const;
     void setFooterPositioning(FooterPositioning positioning);
 
+    bool trackItemSizes() const;
+    void setTrackItemSizes(bool track);
+
     static QQuickListViewAttached *qmlAttachedProperties(QObject *);
 
 public Q_SLOTS:
@@ -190,6 +195,7 @@ Q_SIGNALS:
     void snapModeChanged();
     Q_REVISION(2) void headerPositioningChanged();
     Q_REVISION(2) void footerPositioningChanged();
+    Q_REVISION(10) void trackItemSizesChanged();
 
 protected:
     void viewportMoved(Qt::Orientations orient) override;
@@ -66,6 +66,7 @@
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
+#include <QtCore/QElapsedTimer>
 #include <QtQml/qqmlincubator.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
@@ -111,19 +112,21 @@ class QQuickWindowIncubationController : public QObject, public QQmlIncubationCo
     Q_OBJECT
 
 public:
-    QQuickWindowIncubationController(QSGRenderLoop *loop)
-        : m_renderLoop(loop), m_timer(0)
+    QQuickWindowIncubationController(QQuickWindow *window, QSGRenderLoop *loop)
+        : m_window(window), m_renderLoop(loop), m_timer(0)
     {
-        // Allow incubation for 1/3 of a frame.
+        // Allow incubation for 1/3 of a frame when the render loop does not know
+        // how much of the current frame is left.
         m_incubation_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()) / 3);
 
         QAnimationDriver *animationDriver = m_renderLoop->animationDriver();
-        if (animationDriver) {
+        if (animationDriver)
             connect(animationDriver, SIGNAL(stopped()), this, SLOT(animationStopped()));
-            connect(m_renderLoop, SIGNAL(timeToIncubate()), this, SLOT(incubate()));
-        }
+        connect(m_renderLoop, SIGNAL(timeToIncubate()), this, SLOT(incubate()));
     }
 
+    QQuickWindowPrivate::IncubationStatistics statistics() const { return m_statistics; }
+
 protected:
     void timerEvent(QTimerEvent *) Q_DECL_OVERRIDE
     {
@@ -143,7 +146,14 @@ protected:
 public slots:
     void incubate() {
         if (incubatingObjectCount()) {
-            if (m_renderLoop->interleaveIncubation()) {
+            const int frameTime = QQuickWindowPrivate::get(m_window)->remainingFrameTime();
+            if (frameTime >= 0) {
+                // Fill what is left of the frame after sync (and render)
+                if (frameTime > 0)
+                    incubateInFrame(frameTime);
+                if (incubatingObjectCount() && !m_renderLoop->interleaveIncubation())
+                    incubateAgain();
+            } else if (m_renderLoop->interleaveIncubation()) {
                 incubateFor(m_incubation_time);
             } else {
                 incubateFor(m_incubation_time * 2);
@@ -163,9 +173,29 @@ protected:
     }
 
 private:
+    void incubateInFrame(int msecs)
+    {
+        const int incubating = incubatingObjectCount();
+        QElapsedTimer timer;
+        timer.start();
+        incubateFor(msecs);
+        const int overshoot = int(timer.elapsed()) - msecs;
+
+        const int incubated = qMax(0, incubating - incubatingObjectCount());
+        ++m_statistics.frames;
+        m_statistics.objects += incubated;
+        m_statistics.maxObjectsPerFrame = qMax(m_statistics.maxObjectsPerFrame, incubated);
+        if (overshoot > 0) {
+            ++m_statistics.overrunFrames;
+            m_statistics.maxOvershoot = qMax(m_statistics.maxOvershoot, overshoot);
+        }
+    }
+
+    QQuickWindow *m_window;
     QSGRenderLoop *m_renderLoop;
     int m_incubation_time;
     int m_timer;
+    QQuickWindowPrivate::IncubationStatistics m_statistics;
 };
 
 #include "qquickwindow.moc"
@@ -504,6 +534,8 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , renderTargetId(0)
     , vaoHelper(0)
     , incubationController(0)
+    , frameIntervalNsecs(0)
+    , reservedFrameNsecs(0)
 {
 #if QT_CONFIG(draganddrop)
     dragGrabber = new QQuickDragGrabber;
@@ -3572,6 +3604,47 @@ QImage QQuickWindow::grabWindow()
     return QImage();
 }
 
+/*!
+    \internal
+
+    Starts the budget of the current frame of this window, which lasts one refresh
+    interval of the window's screen. \a reservedNsecs is the time the GUI thread is
+    expected to spend on the next frame before the interval ends. Render loops
+    rendering on the GUI thread call this once the frame is swapped, threaded loops
+    when they start polishing.
+*/
+void QQuickWindowPrivate::startFrameBudget(qint64 reservedNsecs)
+{
+    Q_Q(QQuickWindow);
+    const QScreen *screen = q->screen();
+    const qreal refreshRate = screen ? screen->refreshRate() : 60;
+    frameIntervalNsecs = qint64(1000000000 / (refreshRate > 0 ? refreshRate : 60));
+    reservedFrameNsecs = reservedNsecs;
+    frameBudgetTimer.start();
+}
+
+/*!
+    \internal
+
+    Returns the milliseconds the GUI thread has left in the current frame of this
+    window once it has been synchronized, or -1 if no frame is in progress. The
+    incubation controller of the window uses this to fill the idle part of each frame.
+*/
+int QQuickWindowPrivate::remainingFrameTime() const
+{
+    if (!frameBudgetTimer.isValid())
+        return -1;
+    const qint64 elapsed = frameBudgetTimer.nsecsElapsed();
+    if (elapsed >= frameIntervalNsecs)
+        return -1;
+    return int(qMax(qint64(0), frameIntervalNsecs - elapsed - reservedFrameNsecs) / 1000000);
+}
+
+QQuickWindowPrivate::IncubationStatistics QQuickWindowPrivate::incubationStatistics() const
+{
+    return incubationController ? incubationController->statistics() : IncubationStatistics();
+}
+
 /*!
     Returns an incubation controller that splices incubation between frames
     for this window. QQuickView automatically installs this controller for you,
@@ -3588,7 +3661,7 @@ QQmlIncubationController *QQuickWindow::incubationController() const
         return 0; // TODO: make sure that this is safe
 
     if (!d->incubationController)
-        d->incubationController = new QQuickWindowIncubationController(d->windowManager);
+        d->incubationController = new QQuickWindowIncubationController(const_cast<QQuickWindow *>(this), d->windowManager);
     return d->incubationController;
 }
 
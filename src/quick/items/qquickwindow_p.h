@@ -61,6 +61,7 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qrunnable.h>
+#include <QtCore/qelapsedtimer.h>
 #include <private/qwindow_p.h>
 #include <private/qopengl_p.h>
 #include <qopenglcontext.h>
@@ -273,6 +274,24 @@ public:
 
     mutable QQuickWindowIncubationController *incubationController;
 
+    // Started by the render loop for each frame of this window
+    void startFrameBudget(qint64 reservedNsecs = 0);
+    int remainingFrameTime() const;
+    QElapsedTimer frameBudgetTimer;
+    qint64 frameIntervalNsecs;
+    qint64 reservedFrameNsecs;
+
+    // Incubation done in the idle part of frames, see remainingFrameTime()
+    struct IncubationStatistics {
+        IncubationStatistics() : frames(0), objects(0), maxObjectsPerFrame(0), overrunFrames(0), maxOvershoot(0) {}
+        int frames;             // frames in which objects were incubated
+        int objects;            // incubations completed in those frames
+        int maxObjectsPerFrame;
+        int overrunFrames;      // frames in which incubation ran longer than the time left
+        int maxOvershoot;       // longest time in ms incubation ran longer than the time left
+    };
+    IncubationStatistics incubationStatistics() const;
+
     static bool defaultAlphaBuffer;
 
     static bool dragOverThreshold(qreal d, Qt::Axis axis, QMouseEvent *event, int startDragThreshold = -1);
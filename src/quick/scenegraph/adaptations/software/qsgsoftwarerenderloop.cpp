@@ -134,8 +134,7 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
     bool profileFrames = QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
-        renderTimer.start();
+    renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
 
     cd->polishItems();
@@ -163,8 +162,9 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
 
     cd->renderSceneGraph(window->size());
 
+    const qint64 frameWorkTime = renderTimer.nsecsElapsed();
     if (profileFrames)
-        renderTime = renderTimer.nsecsElapsed();
+        renderTime = frameWorkTime;
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopRender);
 
@@ -173,13 +173,15 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
         data.grabOnly = false;
     }
 
-    if (alsoSwap && window->isVisible()) {
+    const bool swapped = alsoSwap && window->isVisible();
+    if (swapped) {
         //Flush backingstore to window
         if (!isNewExpose)
             m_backingStores[window]->flush(softwareRenderer->flushRegion());
         else
             m_backingStores[window]->flush(QRegion(QRect(QPoint(0,0), window->size())));
         cd->fireFrameSwapped();
+        cd->startFrameBudget(frameWorkTime);
     }
 
     qint64 swapTime = 0;
@@ -204,6 +206,9 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
     // Might have been set during syncSceneGraph()
     if (data.updatePending)
         maybeUpdate(window);
+
+    if (swapped)
+        emit timeToIncubate();
 }
 
 void QSGSoftwareRenderLoop::exposureChanged(QQuickWindow *window)
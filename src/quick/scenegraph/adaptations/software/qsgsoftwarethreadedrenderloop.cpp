@@ -957,6 +957,7 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
         return;
     }
 
+    QQuickWindowPrivate::get(window)->startFrameBudget();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
 
     QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
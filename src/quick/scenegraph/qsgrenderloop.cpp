@@ -403,8 +403,7 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
     bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
-        renderTimer.start();
+    renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
 
     cd->polishItems();
@@ -428,8 +427,9 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
 
     cd->renderSceneGraph(window->size());
 
+    const qint64 frameWorkTime = renderTimer.nsecsElapsed();
     if (profileFrames)
-        renderTime = renderTimer.nsecsElapsed();
+        renderTime = frameWorkTime;
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopRender);
 
@@ -440,10 +440,13 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         data.grabOnly = false;
     }
 
-    if (alsoSwap && window->isVisible()) {
+    const bool swapped = alsoSwap && window->isVisible();
+    if (swapped) {
         if (!cd->customRenderStage || !cd->customRenderStage->swap())
             gl->swapBuffers(window);
         cd->fireFrameSwapped();
+        // The swap waits for the vertical blank, so the next frame starts here
+        cd->startFrameBudget(frameWorkTime);
     }
 
     qint64 swapTime = 0;
@@ -468,6 +471,9 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     // Might have been set during syncSceneGraph()
     if (data.updatePending)
         maybeUpdate(window);
+
+    if (swapped)
+        emit timeToIncubate();
 }
 
 void QSGGuiThreadRenderLoop::exposureChanged(QQuickWindow *window)
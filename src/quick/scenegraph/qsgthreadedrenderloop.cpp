@@ -1175,6 +1175,9 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     }
 
 
+    // Rendering happens on the render thread, the GUI thread is free once synchronized
+    QQuickWindowPrivate::get(window)->startFrameBudget();
+
     QElapsedTimer timer;
     qint64 polishTime = 0;
     qint64 waitTime = 0;
@@ -461,6 +461,8 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
 
     QSG_LOG_TIME_SAMPLE(time_start);
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
+    QElapsedTimer frameTimer;
+    frameTimer.start();
 
     RLDEBUG(" - polishing");
     d->polishItems();
@@ -482,6 +484,7 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
     d->renderSceneGraph(window->size());
     QSG_RENDER_TIMING_SAMPLE(QQuickProfiler::SceneGraphRenderLoopFrame, time_rendered,
                              QQuickProfiler::SceneGraphRenderLoopRender);
+    const qint64 frameWorkTime = frameTimer.nsecsElapsed();
 
     RLDEBUG(" - swapping");
     if (!d->customRenderStage || !d->customRenderStage->swap())
@@ -491,6 +494,8 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
 
     RLDEBUG(" - frameDone");
     d->fireFrameSwapped();
+    // The swap waits for the vertical blank, so the next frame starts here
+    d->startFrameBudget(frameWorkTime);
 
     qCDebug(QSG_LOG_TIME_RENDERLOOP()).nospace()
             << "Frame rendered with 'windows' renderloop in: " << (time_swapped - time_start) / 1000000 << "ms"
@@ -32,7 +32,10 @@
 #include <QQmlEngine>
 #include <QProcess>
 #include <QLibraryInfo>
+#include <QTemporaryDir>
 #include <QSysInfo>
+#include <private/qv4compilationunitmapper_p.h>
+#include <private/qv4compileddata_p.h>
 
 class tst_qmlcachegen: public QObject
 {
@@ -44,6 +47,11 @@ private slots:
     void loadGeneratedFile();
     void translationExpressionSupport();
     void errorOnArgumentsInSignalHandler();
+    void bundle();
+    void loadFromBundle();
+
+private:
+    QTemporaryDir bundleDir;
 };
 
 // A wrapper around QQmlComponent to ensure the temporary reference counts
@@ -68,13 +76,13 @@ public:
     }
 };
 
-static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+static bool generateCache(const QStringList &arguments, QByteArray *capturedStderr = nullptr)
 {
     QProcess proc;
     if (capturedStderr == nullptr)
         proc.setProcessChannelMode(QProcess::ForwardedChannels);
     proc.setProgram(QLibraryInfo::location(QLibraryInfo::BinariesPath) + QDir::separator() + QLatin1String("qmlcachegen"));
-    proc.setArguments(QStringList() << (QLatin1String("--target-architecture=") + QSysInfo::buildCpuArchitecture()) << (QLatin1String("--target-abi=") + QSysInfo::buildAbi()) << qmlFileName);
+    proc.setArguments(QStringList() << (QLatin1String("--target-architecture=") + QSysInfo::buildCpuArchitecture()) << (QLatin1String("--target-abi=") + QSysInfo::buildAbi()) << arguments);
     proc.start();
     if (!proc.waitForFinished())
         return false;
@@ -87,9 +95,44 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
     return proc.exitCode() == 0;
 }
 
+static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+{
+    return generateCache(QStringList() << qmlFileName, capturedStderr);
+}
+
 void tst_qmlcachegen::initTestCase()
 {
     qputenv("QML_FORCE_DISK_CACHE", "1");
+
+    // Bundles are registered once per process, so they have to be in place before the
+    // first document is loaded.
+    QVERIFY(bundleDir.isValid());
+    const auto writeBundleFile = [this](const QString &fileName, const char *contents) {
+        QFile f(bundleDir.path() + '/' + fileName);
+        const bool ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        Q_ASSERT(ok);
+        f.write(contents);
+        return f.fileName();
+    };
+    const QString bundledFilePath = writeBundleFile("bundled.qml", "import QtQml 2.0\n"
+                                                                   "QtObject {\n"
+                                                                   "    property int value: 42\n"
+                                                                   "}");
+    const QString fallbackFilePath = writeBundleFile("fallback.qml", "import QtQml 2.0\n"
+                                                                     "QtObject {\n"
+                                                                     "    property int value: 43\n"
+                                                                     "}");
+    const QStringList bundleArguments = QStringList() << QLatin1String("--bundle")
+                                                      << QLatin1String("--bundle-root") << bundleDir.path()
+                                                      << QLatin1String("--bundle-key-prefix") << bundleDir.path() + '/';
+    const QString bundleFilePath = bundleDir.path() + QLatin1String("/app.qmlcbundle");
+    QVERIFY(generateCache(QStringList(bundleArguments) << QLatin1String("-o") << bundleFilePath << bundledFilePath));
+    // A bundle for a different architecture, so that loading falls back to the .qmlc file.
+    const QString otherBundleFilePath = bundleDir.path() + QLatin1String("/other.qmlcbundle");
+    QVERIFY(generateCache(QStringList(bundleArguments) << QLatin1String("--target-abi=other-abi")
+                                                       << QLatin1String("-o") << otherBundleFilePath << fallbackFilePath));
+    QVERIFY(generateCache(fallbackFilePath));
+    qputenv("QML_CACHE_BUNDLE", QFile::encodeName(bundleFilePath + QDir::listSeparator() + otherBundleFilePath));
 }
 
 void tst_qmlcachegen::loadGeneratedFile()
@@ -189,6 +232,79 @@ void tst_qmlcachegen::errorOnArgumentsInSignalHandler()
     QVERIFY2(errorOutput.contains("error: The use of the arguments object in signal handlers is"), errorOutput);
 }
 
+void tst_qmlcachegen::bundle()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const auto writeTempFile = [&tempDir](const QString &fileName, const char *contents) {
+        QFile f(tempDir.path() + '/' + fileName);
+        const bool ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        Q_ASSERT(ok);
+        f.write(contents);
+        return f.fileName();
+    };
+
+    const QString qmlFilePath = writeTempFile("test.qml", "import QtQml 2.0\n"
+                                                          "QtObject {\n"
+                                                          "    property int value: 42\n"
+                                                          "}");
+    const QString jsFilePath = writeTempFile("script.js", "function add(a, b) { return a + b; }\n");
+    const QString bundleFilePath = tempDir.path() + QLatin1String("/app.qmlcbundle");
+
+    QVERIFY(generateCache(QStringList() << QLatin1String("--bundle")
+                                        << QLatin1String("--bundle-root") << tempDir.path()
+                                        << QLatin1String("--bundle-key-prefix") << QLatin1String(":/app/")
+                                        << QLatin1String("-o") << bundleFilePath
+                                        << qmlFilePath << jsFilePath));
+    QVERIFY(QFile::exists(bundleFilePath));
+    QVERIFY(!QFile::exists(qmlFilePath + QLatin1Char('c')));
+
+    QString error;
+    QSharedPointer<QV4::CompilationUnitBundle> bundle = QV4::CompilationUnitBundle::open(bundleFilePath, &error);
+    QVERIFY2(bundle, qPrintable(error));
+
+    const QV4::CompiledData::Unit *qmlUnit = bundle->findUnit(QLatin1String(":/app/test.qml"));
+    QVERIFY(qmlUnit);
+    QVERIFY(qmlUnit->flags & QV4::CompiledData::Unit::IsQml);
+    QCOMPARE(quintptr(qmlUnit) % QV4::CompiledData::bundleUnitAlignment, quintptr(0));
+
+    const QV4::CompiledData::Unit *jsUnit = bundle->findUnit(QLatin1String(":/app/script.js"));
+    QVERIFY(jsUnit);
+    QVERIFY(jsUnit->flags & QV4::CompiledData::Unit::IsJavascript);
+
+    QVERIFY(!bundle->findUnit(QLatin1String(":/app/other.qml")));
+    QVERIFY(!bundle->findUnit(qmlFilePath));
+}
+
+void tst_qmlcachegen::loadFromBundle()
+{
+    // Without the sources, the documents can only come from the bundles registered in
+    // initTestCase() or from .qmlc files.
+    const QString bundledFilePath = bundleDir.path() + QLatin1String("/bundled.qml");
+    const QString fallbackFilePath = bundleDir.path() + QLatin1String("/fallback.qml");
+    QVERIFY(!QFile::exists(bundledFilePath + QLatin1Char('c')));
+    QVERIFY(QFile::exists(fallbackFilePath + QLatin1Char('c')));
+    QVERIFY(QFile::remove(bundledFilePath));
+    QVERIFY(QFile::remove(fallbackFilePath));
+
+    QQmlEngine engine;
+    {
+        CleanlyLoadingComponent component(&engine, QUrl::fromLocalFile(bundledFilePath));
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY2(!obj.isNull(), qPrintable(component.errorString()));
+        QCOMPARE(obj->property("value").toInt(), 42);
+    }
+
+    // The bundled unit was generated for another architecture; the .qmlc file is used instead.
+    {
+        CleanlyLoadingComponent component(&engine, QUrl::fromLocalFile(fallbackFilePath));
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY2(!obj.isNull(), qPrintable(component.errorString()));
+        QCOMPARE(obj->property("value").toInt(), 43);
+    }
+}
+
 QTEST_GUILESS_MAIN(tst_qmlcachegen)
 
 #include "tst_qmlcachegen.moc"
@@ -63,6 +63,7 @@ private slots:
     void qobjectDerived();
     void qtbug_49232();
     void contextViaClosureAfterDestruction();
+    void parentLookupShadowing();
 
 private:
     QQmlEngine engine;
@@ -751,6 +752,51 @@ void tst_qqmlcontext::contextViaClosureAfterDestruction()
     QCOMPARE(subObject.toString(), QLatin1String("Error: Qt.createQmlObject(): Cannot create a component in an invalid context"));
 }
 
+void tst_qqmlcontext::parentLookupShadowing()
+{
+    QQmlEngine engine;
+    QQmlContext outer(engine.rootContext());
+    outer.setContextProperty("a", 1);
+    QQmlContext inner(&outer);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0; QtObject { function read() { return a } }", QUrl());
+    QScopedPointer<QObject> obj(component.create(&inner));
+    QVERIFY(!obj.isNull());
+
+    // The second read uses the remembered lookup of the outer context property
+    QVariant result;
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(QMetaObject::invokeMethod(obj.data(), "read", Q_RETURN_ARG(QVariant, result)));
+        QCOMPARE(result.toInt(), 1);
+    }
+
+    // A context object of a closer context now shadows it
+    TestObject object;
+    object.setA(2);
+    inner.setContextObject(&object);
+    QVERIFY(QMetaObject::invokeMethod(obj.data(), "read", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toInt(), 2);
+
+    // As does a context property of a closer context
+    inner.setContextObject(0);
+    QVERIFY(QMetaObject::invokeMethod(obj.data(), "read", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toInt(), 1);
+    inner.setContextProperty("a", 3);
+    QVERIFY(QMetaObject::invokeMethod(obj.data(), "read", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toInt(), 3);
+
+    // Changing the value of an existing property does not invalidate the lookups
+    const int generation = QQmlContextData::currentParentLookupGeneration();
+    inner.setContextProperty("a", 4);
+    outer.setContextProperty("a", &object);
+    QCOMPARE(QQmlContextData::currentParentLookupGeneration(), generation);
+    QVERIFY(QMetaObject::invokeMethod(obj.data(), "read", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toInt(), 4);
+    inner.setContextProperty("b", 5);
+    QVERIFY(QQmlContextData::currentParentLookupGeneration() != generation);
+}
+
 QTEST_MAIN(tst_qqmlcontext)
 
 #include "tst_qqmlcontext.moc"
@@ -0,0 +1,14 @@
+import QtQml 2.0
+
+QtObject {
+    property int a: 1
+    property int b: 1
+    property int left: a + b
+    property int right: a * 2
+    property var counter: ({ evaluations: 0, uneven: 0 })
+    property int sum: { counter.evaluations++; return left + right; }
+    // Depends on 'a' directly and through a chain of two other bindings.
+    property int step1: a + 1
+    property int step2: step1 + 1
+    property int uneven: { counter.uneven++; return a + step2; }
+}
@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+    property int a: 1
+    property QtObject child: QtObject {
+        property int b: root.a * 2
+    }
+    property int c: a + 1
+}
@@ -0,0 +1,11 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject source: QtObject {
+        property bool useA: true
+        property int a: 1
+        property int b: 2
+        property int c: 3
+    }
+    property int result: (source.useA ? source.a : source.b) + source.c + source.c
+}
@@ -0,0 +1,22 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    width: 200
+    property real margin: 10
+    property int count: 3
+    property string label: "w"
+
+    property Item holder: Item { width: 50 }
+
+    Item {
+        id: child
+        objectName: "child"
+        width: parent.width - 10
+        height: (root.width + margin) * 2 / count
+        x: -child.width
+        property real plain: root.width
+    }
+
+    property string text: label + width
+}
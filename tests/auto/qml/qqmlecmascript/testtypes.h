@@ -815,6 +815,9 @@ public:
 
     Q_INVOKABLE void method_unknown(NonRegisteredType) { invoke(28); }
 
+    Q_INVOKABLE QVariantList method_QVariantList(QVariantList a) { invoke(31); m_actuals << QVariant(a); a.append(QStringLiteral("end")); return a; }
+    Q_INVOKABLE QVariantMap method_QVariantMap(QVariantMap a) { invoke(32); m_actuals << a; a.insert(QStringLiteral("added"), 42); return a; }
+
 private:
     friend class MyInvokableBaseObject;
     void invoke(int idx) { if (m_invoked != -1) m_invokedError = true; m_invoked = idx;}
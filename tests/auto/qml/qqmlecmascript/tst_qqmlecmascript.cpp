@@ -35,6 +35,9 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qnumeric.h>
 #include <private/qqmlengine_p.h>
+#include <private/qqmlprofiler_p.h>
+#include <private/qqmldata_p.h>
+#include <private/qmetaobject_p.h>
 #include <private/qqmlvmemetaobject_p.h>
 #include <private/qv4qmlcontext_p.h>
 #include "testtypes.h"
@@ -338,6 +341,10 @@ private slots:
     void freeze_empty_object();
     void singleBlockLoops();
     void qtbug_60547();
+    void bindingBatch();
+    void bindingBatchDestroyedTarget();
+    void guardReuse();
+    void typedBindings();
 
 private:
 //    static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -2989,6 +2996,46 @@ void tst_qqmlecmascript::callQtInvokables()
     QJSValue callback = qvariant_cast<QJSValue>(o->actuals().at(1));
     QVERIFY(!callback.isNull());
     QVERIFY(callback.isCallable());
+
+    // Arrays and plain objects are converted directly into the argument, and the
+    // returned list or map directly back. Call twice to also use the cached return type.
+    for (int i = 0; i < 2; ++i) {
+        o->reset();
+        ret = EVALUATE("object.method_QVariantList([1, \"two\", [3], {four: 4}])");
+        QCOMPARE(o->error(), false);
+        QCOMPARE(o->invoked(), 31);
+        QCOMPARE(o->actuals().count(), 1);
+        const QVariantList list = o->actuals().at(0).toList();
+        QCOMPARE(list.count(), 4);
+        QCOMPARE(list.at(0).toInt(), 1);
+        QCOMPARE(list.at(1).toString(), QString("two"));
+        QCOMPARE(list.at(2).toList(), QVariantList() << 3);
+        QCOMPARE(list.at(3).toMap().value("four").toInt(), 4);
+
+        QV4::ScopedArrayObject returnedList(scope, ret);
+        QVERIFY(returnedList);
+        QCOMPARE(returnedList->getLength(), 5u);
+        QV4::ScopedValue element(scope, returnedList->getIndexed(1));
+        QCOMPARE(element->toQStringNoThrow(), QString("two"));
+        element = returnedList->getIndexed(4);
+        QCOMPARE(element->toQStringNoThrow(), QString("end"));
+
+        o->reset();
+        ret = EVALUATE("object.method_QVariantMap({one: 1, two: \"two\", three: [3]})");
+        QCOMPARE(o->error(), false);
+        QCOMPARE(o->invoked(), 32);
+        QCOMPARE(o->actuals().count(), 1);
+        const QVariantMap map = o->actuals().at(0).toMap();
+        QCOMPARE(map.count(), 3);
+        QCOMPARE(map.value("one").toInt(), 1);
+        QCOMPARE(map.value("two").toString(), QString("two"));
+        QCOMPARE(map.value("three").toList(), QVariantList() << 3);
+
+        const QVariantMap returnedMap = scope.engine->toVariant(ret, -1, false).toMap();
+        QCOMPARE(returnedMap.count(), 4);
+        QCOMPARE(returnedMap.value("one").toInt(), 1);
+        QCOMPARE(returnedMap.value("added").toInt(), 42);
+    }
 }
 
 void tst_qqmlecmascript::resolveClashingProperties()
@@ -8257,6 +8304,174 @@ void tst_qqmlecmascript::qtbug_60547()
     QCOMPARE(object->property("counter"), QVariant(int(1)));
 }
 
+void tst_qqmlecmascript::bindingBatch()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("bindingBatch.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+    const QVariant counter = object->property("counter");
+    auto evaluations = [&](const char *name = "evaluations") {
+        return counter.value<QJSValue>().property(QLatin1String(name)).toInt();
+    };
+    QCOMPARE(object->property("sum").toInt(), 4);
+    int expectedEvaluations = evaluations();
+
+    // Without a batch, 'sum' runs once for each of its changed dependencies.
+    object->setProperty("a", 2);
+    QCOMPARE(object->property("sum").toInt(), 8);
+    expectedEvaluations += 2;
+    QCOMPARE(evaluations(), expectedEvaluations);
+
+    QVERIFY(!engine.isBindingBatchActive());
+    const int unevenEvaluations = evaluations("uneven");
+    engine.beginBindingBatch();
+    QVERIFY(engine.isBindingBatchActive());
+    object->setProperty("a", 3);
+    object->setProperty("b", 4);
+    // Nothing is propagated until the batch ends.
+    QCOMPARE(object->property("left").toInt(), 3);
+    QCOMPARE(object->property("sum").toInt(), 8);
+    engine.endBindingBatch();
+    QVERIFY(!engine.isBindingBatchActive());
+
+    QCOMPARE(object->property("left").toInt(), 7);
+    QCOMPARE(object->property("right").toInt(), 6);
+    QCOMPARE(object->property("sum").toInt(), 13);
+    QCOMPARE(evaluations(), ++expectedEvaluations);
+    // The first batch already waits for the longer path before evaluating 'uneven'.
+    QCOMPARE(object->property("uneven").toInt(), 8);
+    QCOMPARE(evaluations("uneven"), unevenEvaluations + 1);
+
+    // Nested batches only propagate when the outermost one ends.
+    engine.beginBindingBatch();
+    engine.beginBindingBatch();
+    object->setProperty("b", 5);
+    engine.endBindingBatch();
+    QCOMPARE(object->property("sum").toInt(), 13);
+    engine.endBindingBatch();
+    QCOMPARE(object->property("sum").toInt(), 14);
+    QCOMPARE(evaluations(), ++expectedEvaluations);
+
+    QTest::ignoreMessage(QtWarningMsg, "QQmlEngine::endBindingBatch: no batch is active");
+    engine.endBindingBatch();
+}
+
+void tst_qqmlecmascript::bindingBatchDestroyedTarget()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("bindingBatchDestroyedTarget.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+    QPointer<QObject> child = object->property("child").value<QObject *>();
+    QVERIFY(child);
+    QCOMPARE(child->property("b").toInt(), 2);
+
+    // The binding of 'b' is queued, then its object goes away before the batch ends.
+    engine.beginBindingBatch();
+    object->setProperty("a", 2);
+    delete child.data();
+    QVERIFY(child.isNull());
+    engine.endBindingBatch();
+
+    // The other bindings queued in the same batch are still evaluated.
+    QCOMPARE(object->property("c").toInt(), 3);
+}
+
+static int notifyEndpointCount(QObject *object, const char *property)
+{
+    const QMetaObject *metaObject = object->metaObject();
+    const QMetaMethod notifySignal = metaObject->property(metaObject->indexOfProperty(property)).notifySignal();
+    return QQmlData::get(object)->endpointCount(QMetaObjectPrivate::signalIndex(notifySignal));
+}
+
+void tst_qqmlecmascript::guardReuse()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("guardReuse.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+    QCOMPARE(object->property("result").toInt(), 7);
+    QObject *source = object->property("source").value<QObject *>();
+    QVERIFY(source);
+
+    // 'c' is read twice, but only guarded once.
+    QCOMPARE(notifyEndpointCount(source, "a"), 1);
+    QCOMPARE(notifyEndpointCount(source, "b"), 0);
+    QCOMPARE(notifyEndpointCount(source, "c"), 1);
+
+    // Same dependencies on every evaluation: no guard is added.
+    for (int i = 2; i <= 4; ++i)
+        source->setProperty("a", i);
+    QCOMPARE(object->property("result").toInt(), 10);
+    QCOMPARE(notifyEndpointCount(source, "a"), 1);
+    QCOMPARE(notifyEndpointCount(source, "c"), 1);
+
+    // Switching branches replaces the guard on 'a' by one on 'b' and keeps the others.
+    source->setProperty("useA", false);
+    QCOMPARE(object->property("result").toInt(), 8);
+    QCOMPARE(notifyEndpointCount(source, "useA"), 1);
+    QCOMPARE(notifyEndpointCount(source, "a"), 0);
+    QCOMPARE(notifyEndpointCount(source, "b"), 1);
+    QCOMPARE(notifyEndpointCount(source, "c"), 1);
+
+    // The new set of guards is complete.
+    source->setProperty("b", 5);
+    QCOMPARE(object->property("result").toInt(), 11);
+    source->setProperty("c", 4);
+    QCOMPARE(object->property("result").toInt(), 13);
+}
+
+void tst_qqmlecmascript::typedBindings()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("typedBindings.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+    QObject *child = object->findChild<QObject *>("child");
+    QVERIFY(child);
+
+    // Every numeric binding has a typed form, the string concatenation does not.
+    QQmlData *ddata = QQmlData::get(object.data());
+    QVERIFY(ddata && ddata->compilationUnit);
+    const QV4::CompiledData::Unit *unit = ddata->compilationUnit->data;
+    int typedFunctions = 0;
+    for (uint i = 0; i < unit->functionTableSize; ++i) {
+        if (unit->functionAt(i)->hasTypedBinding())
+            ++typedFunctions;
+    }
+    QCOMPARE(typedFunctions, 4);
+
+    QCOMPARE(child->property("width").toReal(), qreal(190));
+    QCOMPARE(child->property("height").toReal(), qreal(140));
+    QCOMPARE(child->property("x").toReal(), qreal(-190));
+    QCOMPARE(child->property("plain").toReal(), qreal(200));
+    // Strings are left to JavaScript.
+    QCOMPARE(object->property("text").toString(), QStringLiteral("w200"));
+
+    object->setProperty("width", 300);
+    QCOMPARE(child->property("width").toReal(), qreal(290));
+    QCOMPARE(child->property("height").toReal(), qreal(620) / 3);
+    QCOMPARE(child->property("x").toReal(), qreal(-290));
+    QCOMPARE(child->property("plain").toReal(), qreal(300));
+    QCOMPARE(object->property("text").toString(), QStringLiteral("w300"));
+
+    object->setProperty("margin", 30);
+    object->setProperty("count", 5);
+    QCOMPARE(child->property("height").toReal(), qreal(132));
+
+    // Without a parent the JavaScript fallback reports the error.
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(".*TypeError: Cannot read property 'width' of null"));
+    QVERIFY(QQmlProperty::write(child, "parent", QVariant::fromValue<QObject *>(nullptr)));
+    QCOMPARE(child->property("width").toReal(), qreal(290));
+    QObject *holder = object->property("holder").value<QObject *>();
+    QVERIFY(QQmlProperty::write(child, "parent", QVariant::fromValue(holder)));
+    QCOMPARE(child->property("width").toReal(), qreal(40));
+    QCOMPARE(child->property("x").toReal(), qreal(-40));
+    holder->setProperty("width", 70);
+    QCOMPARE(child->property("width").toReal(), qreal(60));
+}
+
 QTEST_MAIN(tst_qqmlecmascript)
 
 #include "tst_qqmlecmascript.moc"
@@ -31,6 +31,8 @@
 #include <QtQuick/qquickview.h>
 #include <QtQuick/qquickitem.h>
 #include <private/qqmlimport_p.h>
+#include <private/qqmlimportresolutioncache_p.h>
+#include <private/qqmlimportresolutioncacheformat_p.h>
 #include "../../shared/util.h"
 
 class tst_QQmlImport : public QQmlDataTest
@@ -43,6 +45,8 @@ private slots:
     void uiFormatLoading();
     void completeQmldirPaths_data();
     void completeQmldirPaths();
+    void importResolutionCache();
+    void importResolutionCacheImportPaths();
     void cleanup();
 };
 
@@ -185,6 +189,147 @@ void tst_QQmlImport::completeQmldirPaths()
     QCOMPARE(QQmlImports::completeQmldirPaths(uri, basePaths, majorVersion, minorVersion), expectedPaths);
 }
 
+void tst_QQmlImport::importResolutionCache()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString root = tempDir.path();
+    const QString cacheFile = root + QLatin1String("/imports.cache");
+    QVERIFY(QDir(root).mkpath(QLatin1String("imports/Foo")));
+    QVERIFY(QDir(root).mkpath(QLatin1String("other")));
+
+    const QString qmldir = root + QLatin1String("/imports/Foo/qmldir");
+    const QString versionedQmldir = root + QLatin1String("/imports/Foo.1/qmldir");
+    const QString otherQmldir = root + QLatin1String("/other/Bar/Baz/qmldir");
+    {
+        QFile file(qmldir);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("module Foo\n");
+    }
+
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Unknown);
+        cache.recordFile(versionedQmldir, false);
+        cache.recordFile(otherQmldir, false);
+        cache.recordQmldirContent(qmldir, QLatin1String("module Foo\n"));
+        QVERIFY(cache.isDirty());
+        QVERIFY(cache.save());
+        QVERIFY(!cache.isDirty());
+    }
+
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Missing);
+        QCOMPARE(cache.lookupFile(otherQmldir), QQmlImportResolutionCache::Missing);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Present);
+        QString content;
+        QVERIFY(cache.qmldirContent(qmldir, &content));
+        QCOMPARE(content, QLatin1String("module Foo\n"));
+        QVERIFY(!cache.isDirty());
+    }
+
+    // Removing the directory a missing entry was validated against, or the file a
+    // present entry refers to, invalidates the entry.
+    QVERIFY(QDir(root + QLatin1String("/other")).removeRecursively());
+    QVERIFY(QFile::remove(qmldir));
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Missing);
+        QCOMPARE(cache.lookupFile(otherQmldir), QQmlImportResolutionCache::Unknown);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Unknown);
+        QString content;
+        QVERIFY(!cache.qmldirContent(qmldir, &content));
+        QVERIFY(cache.isDirty());
+    }
+}
+
+void tst_QQmlImport::importResolutionCacheImportPaths()
+{
+    namespace Format = QQmlImportResolutionCacheFormat;
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString root = tempDir.path();
+    const QString cacheFile = root + QLatin1String("/imports.cache");
+    QVERIFY(QDir(root).mkpath(QLatin1String("imports/Foo")));
+
+    const QString qmldir = root + QLatin1String("/imports/Foo/qmldir");
+    const QString versionedQmldir = root + QLatin1String("/imports/Foo.1/qmldir");
+    {
+        QFile file(qmldir);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("module Foo\n");
+    }
+
+    // As written by qmlimportscanner -importCache on the build host: no absolute
+    // paths and no modification times, only the listings of the directories down to
+    // the files.
+    auto writeCache = [&](const QStringList &importPathEntries, const QStringList &fooEntries) {
+        QJsonObject directories;
+        directories.insert(QString(), QJsonArray::fromStringList(importPathEntries));
+        directories.insert(QLatin1String("Foo"), QJsonArray::fromStringList(fooEntries));
+        QJsonObject importPath;
+        importPath.insert(Format::directoriesKey(), directories);
+        importPath.insert(Format::missingKey(), QJsonArray() << QLatin1String("Foo.1/qmldir")
+                                                             << QLatin1String("Foo/Bar/qmldir"));
+        importPath.insert(Format::filesKey(), QJsonArray() << QLatin1String("Foo/qmldir"));
+        QJsonObject cache;
+        cache.insert(Format::versionKey(), int(Format::Version));
+        cache.insert(Format::importPathsKey(), QJsonArray() << importPath);
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QJsonDocument(cache).toJson());
+    };
+    const QStringList importPathEntries = QQmlImportResolutionCache::directoryEntries(root + QLatin1String("/imports"));
+    const QStringList fooEntries = QQmlImportResolutionCache::directoryEntries(root + QLatin1String("/imports/Foo"));
+
+    // The listing of the import path does not match, for example because the cache
+    // was generated for a different set of modules.
+    writeCache(QStringList() << QLatin1String("Bar") << QLatin1String("Foo"), fooEntries);
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Unknown);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Unknown);
+        QVERIFY(!cache.isDirty());
+    }
+
+    // The import path matches, but the module directory changed since the cache was
+    // generated: neither the qmldir file nor the missing Foo/Bar/qmldir may be taken
+    // from the cache.
+    writeCache(importPathEntries, fooEntries + QStringList(QLatin1String("Bar")));
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Unknown);
+        QCOMPARE(cache.lookupFile(root + QLatin1String("/imports/Foo/Bar/qmldir")), QQmlImportResolutionCache::Unknown);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Missing);
+    }
+
+    writeCache(importPathEntries, fooEntries);
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Present);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Missing);
+        QCOMPARE(cache.lookupFile(root + QLatin1String("/imports/Foo/Bar/qmldir")), QQmlImportResolutionCache::Missing);
+
+        // The contents of qmldir files are only cached once they have been read here.
+        QString content;
+        QVERIFY(!cache.qmldirContent(qmldir, &content));
+
+        // The results are recorded with the modification times found here.
+        QVERIFY(cache.isDirty());
+        QVERIFY(cache.save());
+    }
+
+    // From now on the recorded modification times decide.
+    QVERIFY(QFile::remove(qmldir));
+    {
+        QQmlImportResolutionCache cache(cacheFile);
+        QCOMPARE(cache.lookupFile(qmldir), QQmlImportResolutionCache::Unknown);
+        QCOMPARE(cache.lookupFile(versionedQmldir), QQmlImportResolutionCache::Missing);
+    }
+}
+
 QTEST_MAIN(tst_QQmlImport)
 
 #include "tst_qqmlimport.moc"
@@ -0,0 +1,32 @@
+import QtQuick 2.0
+QtObject {
+    property int intProperty: 10
+    property var varProperty: null
+    property string stringProperty: "Hello"
+    property url urlProperty: "main.qml"
+    property bool boolProperty: true
+    property color colorProperty: "red"
+    property real realProperty: 1.5
+    property variant variantProperty: 42
+
+    property int changeCount: 0
+    onIntPropertyChanged: ++changeCount
+    onStringPropertyChanged: ++changeCount
+    onColorPropertyChanged: ++changeCount
+    onVarPropertyChanged: ++changeCount
+
+    function update() {
+        intProperty += 1
+        stringProperty += " World"
+        realProperty *= 2
+        boolProperty = !boolProperty
+        colorProperty = "blue"
+        return describe()
+    }
+    function describe() {
+        return intProperty + " " + stringProperty + " " + realProperty + " " + boolProperty + " " + variantProperty
+    }
+    function assignObject() {
+        varProperty = Qt.createQmlObject("import QtQuick 2.0; QtObject {}", this)
+    }
+}
@@ -118,6 +118,7 @@ private slots:
     void overrideSignal();
     void dynamicProperties();
     void dynamicPropertiesNested();
+    void dynamicPropertiesMixedStorage();
     void listProperties();
     void badListItemType();
     void dynamicObjectProperties();
@@ -1374,6 +1375,49 @@ void tst_qqmllanguage::dynamicPropertiesNested()
     delete object;
 }
 
+// Tests that properties kept unboxed and in the JS heap don't interfere with each other
+// or with the methods of the object
+void tst_qqmllanguage::dynamicPropertiesMixedStorage()
+{
+    QQmlComponent component(&engine, testFileUrl("dynamicPropertiesMixedStorage.qml"));
+    VERIFY_ERRORS(0);
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object != 0);
+
+    QCOMPARE(object->property("intProperty"), QVariant(10));
+    QCOMPARE(object->property("stringProperty"), QVariant("Hello"));
+    QCOMPARE(object->property("urlProperty"), QVariant(testFileUrl("main.qml")));
+    QCOMPARE(object->property("boolProperty"), QVariant(true));
+    QCOMPARE(object->property("colorProperty"), QVariant(QColor("red")));
+    QCOMPARE(object->property("realProperty"), QVariant(qreal(1.5)));
+    QCOMPARE(object->property("variantProperty"), QVariant(42));
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(object.data(), "update", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toString(), QStringLiteral("11 Hello World 3 false 42"));
+    QCOMPARE(object->property("colorProperty"), QVariant(QColor("blue")));
+    QCOMPARE(object->property("changeCount").toInt(), 3);
+
+    // Writing an unchanged value doesn't notify
+    QVERIFY(object->setProperty("intProperty", 11));
+    QVERIFY(object->setProperty("colorProperty", QColor("blue")));
+    QCOMPARE(object->property("changeCount").toInt(), 3);
+
+    QVERIFY(object->setProperty("stringProperty", QStringLiteral("Bye")));
+    QCOMPARE(object->property("changeCount").toInt(), 4);
+    QVERIFY(QMetaObject::invokeMethod(object.data(), "describe", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toString(), QStringLiteral("11 Bye 3 false 42"));
+
+    QVERIFY(QMetaObject::invokeMethod(object.data(), "assignObject"));
+    QCOMPARE(object->property("changeCount").toInt(), 5);
+    QObject *child = object->property("varProperty").value<QObject *>();
+    QVERIFY(child);
+    delete child;
+    QCOMPARE(object->property("changeCount").toInt(), 6);
+    QVERIFY(!object->property("varProperty").value<QObject *>());
+    QCOMPARE(object->property("intProperty"), QVariant(11));
+}
+
 // Tests the creation and assignment to dynamic list properties
 void tst_qqmllanguage::listProperties()
 {
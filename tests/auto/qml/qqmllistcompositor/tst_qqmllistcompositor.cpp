@@ -89,6 +89,30 @@ QT_END_NAMESPACE
 static const C::Group Visible = C::Group(2);
 static const C::Group Selection = C::Group(3);
 
+// Compares the result of find() for every index in every group with the position found by
+// walking the ranges from the start of the compositor.
+static bool findMatchesWalk(QQmlListCompositor &compositor, int groupCount)
+{
+    for (int group = 0; group < groupCount; ++group) {
+        for (int index = 0; index < compositor.count(C::Group(group)); ++index) {
+            C::iterator expected(compositor.end()->next, 0, C::Group(group), groupCount);
+            expected += index;
+            C::iterator actual = compositor.find(C::Group(group), index);
+            if (*actual != *expected || actual.offset != expected.offset) {
+                qWarning() << "Expected:" << expected << "Actual:" << actual;
+                return false;
+            }
+            for (int i = 0; i < groupCount; ++i) {
+                if (actual.index[i] != expected.index[i]) {
+                    qWarning() << "Expected:" << expected << "Actual:" << actual;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 class tst_qqmllistcompositor : public QObject
 {
     Q_OBJECT
@@ -147,6 +171,8 @@ private slots:
     void move_data();
     void move();
     void moveFromEnd();
+    void findFragmented();
+    void setGroupCountAfterAppend();
     void clear();
     void listItemsInserted_data();
     void listItemsInserted();
@@ -1061,6 +1087,71 @@ void tst_qqmllistcompositor::moveFromEnd()
     QCOMPARE(it.modelIndex(), 0);
 }
 
+void tst_qqmllistcompositor::findFragmented()
+{
+    int listA; void *a = &listA;
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+    compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+
+    // Alternate the groups of consecutive ranges so none of them can be merged.
+    for (int i = 0; i < 100; ++i) {
+        compositor.append(a, 3 * i, 3, C::DefaultFlag
+                | (i % 2 ? VisibleFlag : SelectionFlag)
+                | (i % 3 ? 0 : C::CacheFlag));
+    }
+    QCOMPARE(compositor.count(C::Default), 300);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    QVector<C::Remove> removes;
+    QVector<C::Insert> inserts;
+
+    compositor.setFlags(C::Default, 10, 40, C::Default, SelectionFlag, &inserts);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.clearFlags(C::Default, 100, 60, C::Default, VisibleFlag, &removes);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.move(C::Default, 200, C::Default, 20, 30, C::Default, &removes, &inserts);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.move(C::Default, 5, C::Default, 250, 40, C::Default, &removes, &inserts);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.listItemsInserted(a, 150, 10, &inserts);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.listItemsRemoved(a, 30, 60, &removes);
+    QCOMPARE(compositor.count(C::Default), 240);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    compositor.clear();
+    QCOMPARE(compositor.count(C::Default), 0);
+    QCOMPARE(compositor.findInsertPosition(C::Default, 0)->flags, 0u);
+}
+
+void tst_qqmllistcompositor::setGroupCountAfterAppend()
+{
+    int listA; void *a = &listA;
+
+    // Only the first two groups are counted until the group count is raised.
+    QQmlListCompositor compositor;
+    for (int i = 0; i < 20; ++i)
+        compositor.append(a, 2 * i, 2, C::DefaultFlag | (i % 2 ? VisibleFlag : SelectionFlag));
+    QCOMPARE(compositor.count(C::Default), 40);
+
+    compositor.setGroupCount(4);
+    QCOMPARE(compositor.count(C::Default), 40);
+    QCOMPARE(compositor.count(Visible), 20);
+    QCOMPARE(compositor.count(Selection), 20);
+    QVERIFY(findMatchesWalk(compositor, 4));
+
+    QQmlListCompositor::iterator it = compositor.find(Selection, 5);
+    QCOMPARE(it.index[C::Default], 9);
+    QCOMPARE(it.index[Visible], 4);
+}
+
 void tst_qqmllistcompositor::clear()
 {
     QQmlListCompositor compositor;
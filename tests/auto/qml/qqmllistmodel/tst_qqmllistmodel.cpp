@@ -569,6 +569,18 @@ void tst_qqmllistmodel::dynamic_data()
 
         QTest::newRow("nested-count") << "{append({'foo':123,'bars':[{'a':1},{'a':2},{'a':3}]}); get(0).bars.count}" << 3 << "" << dr;
         QTest::newRow("nested-clear") << "{append({'foo':123,'bars':[{'a':1},{'a':2},{'a':3}]}); get(0).bars.clear(); get(0).bars.count}" << 0 << "" << dr;
+
+        QTest::newRow("appendColumns1") << "{appendColumns({'foo':[1,2,3],'bar':['a','b','c']});count}" << 3 << "" << dr;
+        QTest::newRow("appendColumns2") << "{appendColumns({'foo':[1,2,3],'bar':['a','b','c']});get(1).foo}" << 2 << "" << dr;
+        QTest::newRow("appendColumns3") << "{appendColumns({'foo':[1,2,3],'bar':['a']});count}" << 3 << "" << dr;
+        QTest::newRow("appendColumns4") << "{append({'foo':10});appendColumns({'foo':new Int32Array([1,2,3])});get(3).foo}" << 3 << "" << dr;
+        QTest::newRow("appendColumns5") << "{appendColumns({'foo':[1,2],'bars':[[{'a':1},{'a':2}],[{'a':3}]]});get(0).bars.count}" << 2 << "" << dr;
+        QTest::newRow("appendColumns6") << "{appendColumns(123)}" << 0 << "<Unknown File>: QML ListModel: appendColumns: value is not an object" << dr;
+        QTest::newRow("getColumn1") << "{append([{'foo':1},{'foo':2},{'foo':3}]);var c = getColumn('foo');c.length * 10 + c[2]}" << 33 << "" << dr;
+        QTest::newRow("getColumn2") << "{append({'foo':1});getColumn('bar').length}" << 0 << "" << dr;
+        QTest::newRow("getColumn3") << "{appendColumns({'name':['a','bb','ccc']});getColumn('name')[2].length}" << 3 << "" << dr;
+        QTest::newRow("getColumn4") << "{append({'foo':1});append({'foo':2,'name':'x'});var c = getColumn('name');c.length * 10 + (c[0] === undefined ? 1 : 0)}" << 21 << "" << dr;
+        QTest::newRow("getColumn5") << "{appendColumns({'foo':[1,2,3],'name':['a']});var c = getColumn('name');(c[1] === undefined) + (c[2] === undefined) + c.length}" << 5 << "" << dr;
     }
 
     QTest::newRow("jsarray") << "{append({'foo':['1', '2', '3']});get(0).foo.get(0)}" << 0 << "" << false;
@@ -104,6 +104,8 @@ private slots:
     void worker_remove_list();
     void dynamic_role_data();
     void dynamic_role();
+    void worker_sync_changes_data();
+    void worker_sync_changes();
 };
 
 bool tst_qqmllistmodelworkerscript::compareVariantList(const QVariantList &testList, QVariant object)
@@ -841,6 +843,77 @@ void tst_qqmllistmodelworkerscript::dynamic_role()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_changes_data()
+{
+    QTest::addColumn<QString>("script");
+    QTest::addColumn<QString>("result");
+
+    QTest::newRow("none") << "{count}" << "a,b,c,d,e";
+    QTest::newRow("set") << "{setProperty(1, 'name', 'x')}" << "a,x,c,d,e";
+    QTest::newRow("append") << "{append({'name':'f'})}" << "a,b,c,d,e,f";
+    QTest::newRow("insert") << "{insert(2, {'name':'f'})}" << "a,b,f,c,d,e";
+    QTest::newRow("remove") << "{remove(1, 2)}" << "a,d,e";
+    QTest::newRow("move forwards") << "{move(0, 2, 2)}" << "c,d,a,b,e";
+    QTest::newRow("move backwards") << "{move(3, 0, 2)}" << "d,e,a,b,c";
+    QTest::newRow("insert then set") << "{insert(0, {'name':'f'});setProperty(0, 'name', 'g')}" << "g,a,b,c,d,e";
+    QTest::newRow("set then move") << "{setProperty(4, 'name', 'x');move(4, 0, 1)}" << "x,a,b,c,d";
+    QTest::newRow("insert then remove") << "{append({'name':'f'});remove(5)}" << "a,b,c,d,e";
+    QTest::newRow("mixed") << "{remove(0);append({'name':'f'});move(0, 3, 1);set(1, {'name':'y'})}" << "c,y,e,b,f";
+    QTest::newRow("clear") << "{append({'name':'f'});clear();append({'name':'g'})}" << "g";
+    QTest::newRow("nested") << "{setProperty(0, 'name', 'x');get(1).sub.append({'name':'s'})}" << "x,b,c,d,e";
+}
+
+void tst_qqmllistmodelworkerscript::worker_sync_changes()
+{
+    QFETCH(QString, script);
+    QFETCH(QString, result);
+
+    // Only the rows touched by the worker are copied back on sync() for
+    // static roles; check the result matches a full sync for mixed
+    // sequences of changes, including ones that have to fall back to it.
+
+    QQmlListModel model;
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&engine, &component, &model);
+    QVERIFY(item != 0);
+
+    const QStringList names = QStringList() << "a" << "b" << "c" << "d" << "e";
+    for (const QString &name : names) {
+        QQmlExpression preExp(engine.rootContext(), &model,
+                              QString("append({'name': '%1', 'sub': []})").arg(name));
+        preExp.evaluate();
+    }
+    QCOMPARE(model.count(), 5);
+
+    if (script[0] == QLatin1Char('{') && script[script.length()-1] == QLatin1Char('}'))
+        script = script.mid(1, script.length() - 2);
+    QVariantList operations;
+    foreach (const QString &s, script.split(';')) {
+        if (!s.isEmpty())
+            operations << s;
+    }
+
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    QStringList synced;
+    for (int i = 0; i < model.count(); ++i) {
+        QQmlExpression e(engine.rootContext(), &model, QString("get(%1).name").arg(i));
+        synced << e.evaluate().toString();
+    }
+    QCOMPARE(synced.join(','), result);
+
+    if (QByteArray(QTest::currentDataTag()) == "nested") {
+        QQmlExpression sub(engine.rootContext(), &model, "get(1).sub.count");
+        QCOMPARE(sub.evaluate().toInt(), 1);
+    }
+
+    delete item;
+    qApp->processEvents();
+}
+
 QTEST_MAIN(tst_qqmllistmodelworkerscript)
 
 #include "tst_qqmllistmodelworkerscript.moc"
@@ -30,6 +30,8 @@
 #include <private/qqmlpropertycache_p.h>
 #include <QtQml/qqmlengine.h>
 #include <private/qv8engine_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlmetatype_p.h>
 #include <private/qmetaobjectbuilder_p.h>
 #include <QCryptographicHash>
 #include "../../shared/util.h"
@@ -50,6 +52,7 @@ private slots:
     void metaObjectSize_data();
     void metaObjectSize();
     void metaObjectChecksum();
+    void sharedAcrossEngines();
 
 private:
     QQmlEngine engine;
@@ -393,4 +396,21 @@ void tst_qqmlpropertycache::metaObjectChecksum()
     }
 }
 
+void tst_qqmlpropertycache::sharedAcrossEngines()
+{
+    qmlRegisterType<BaseObject>("Test.SharedCache", 1, 0, "BaseObject");
+
+    QQmlPropertyCache *cache = QQmlMetaType::propertyCache(&BaseObject::staticMetaObject);
+    QVERIFY(cache);
+
+    {
+        QQmlEngine otherEngine;
+        QCOMPARE(QQmlEnginePrivate::get(&otherEngine)->cache(&BaseObject::staticMetaObject), cache);
+    }
+
+    // Destroying an engine frees the unused caches, but not the ones of registered types
+    QCOMPARE(QQmlMetaType::propertyCache(&BaseObject::staticMetaObject), cache);
+    QVERIFY(cacheProperty(cache, "propertyA"));
+}
+
 QTEST_MAIN(tst_qqmlpropertycache)
@@ -0,0 +1,65 @@
+.import QtQuick.LocalStorage 2.0 as Sql
+
+function test(result) {
+    var db = Sql.LocalStorage.openDatabaseSync("QmlTestDB-asynctransaction", "1.0", "Test database from Qt autotests", 1000000);
+    result.text = "transaction_not_finished";
+
+    db.transaction(function(tx) {
+        tx.executeSql('CREATE TABLE IF NOT EXISTS Greeting(salutation TEXT, salutee TEXT)');
+    });
+
+    var v;
+    try {
+        db.transactionAsync(function(tx) { v = tx });
+        v.executeSql("SELECT 'bad'")
+        result.text = "executeSql outside of the transaction did not throw";
+        return;
+    } catch (err) {
+        if (err.message != "executeSql called outside transactionAsync()") {
+            result.text = "WRONG ERROR=" + err.message;
+            return;
+        }
+    }
+
+    var inserted = -1;
+    var selected = false;
+    db.transactionAsync(function(tx) {
+        tx.executeBatch('INSERT INTO Greeting VALUES(?, ?)',
+                        [ [ 'hello', 'world' ], [ 'goodbye', 'cruel world' ], [ 'hi', 'there' ] ],
+                        function(rs) { inserted = rs.rowsAffected });
+        tx.executeSql('SELECT * FROM Greeting WHERE salutation = ?', [ 'hi' ], function(rs) {
+            selected = rs.rows.length == 1 && rs.rows.item(0).salutee == 'there' && rs.rows[0].salutation == 'hi';
+        });
+    }, function(err) {
+        result.text = "FAILED=" + err.message;
+    }, function() {
+        if (inserted != 3)
+            result.text = "rowsAffected should be 3, but is " + inserted;
+        else if (!selected)
+            result.text = "SELECT did not return the inserted row";
+        else
+            testRollback(db, result);
+    });
+}
+
+function testRollback(db, result) {
+    var statementError = "";
+    db.transactionAsync(function(tx) {
+        tx.executeSql('INSERT INTO Greeting VALUES(?, ?)', [ 'hello', 'again' ]);
+        tx.executeSql('INSERT INTO NoSuchTable VALUES(?)', [ 'bad' ], undefined, function(err) {
+            statementError = err.message;
+        });
+    }, function(err) {
+        if (statementError == "" || err.message != statementError || err.code != 2 /* DATABASE_ERR */) {
+            result.text = "WRONG ERROR=" + err.message;
+            return;
+        }
+        var count = 0;
+        db.readTransaction(function(tx) {
+            count = tx.executeSql('SELECT COUNT(*) AS count FROM Greeting').rows.item(0).count;
+        });
+        result.text = count == 3 ? "passed" : "transaction was not rolled back, rows=" + count;
+    }, function() {
+        result.text = "transaction with an invalid statement succeeded";
+    });
+}
@@ -62,6 +62,7 @@ private slots:
     void testQml();
     void testQml_cleanopen_data();
     void testQml_cleanopen();
+    void asyncTransaction();
     void totalDatabases();
 
     void cleanupTestCase();
@@ -116,7 +117,7 @@ void tst_qqmlsqldatabase::checkDatabasePath()
     QVERIFY(engine->offlineStoragePath().contains("OfflineStorage"));
 }
 
-static const int total_databases_created_by_tests = 13;
+static const int total_databases_created_by_tests = 14;
 void tst_qqmlsqldatabase::testQml_data()
 {
     QTest::addColumn<QString>("jsfile"); // The input file
@@ -192,6 +193,27 @@ void tst_qqmlsqldatabase::testQml_cleanopen()
     }
 }
 
+void tst_qqmlsqldatabase::asyncTransaction()
+{
+    if (engine->offlineStoragePath().isEmpty())
+        QSKIP("offlineStoragePath is empty, skip this test.");
+
+    // The statements run on the database thread, the test sets the text
+    // from the callbacks once its transactions have finished.
+    QString qml=
+        "import QtQuick 2.0\n"
+        "import \"asynctransaction.js\" as JS\n"
+        "Text { Component.onCompleted: JS.test(this) }";
+
+    engine->setOfflineStoragePath(dbDir());
+    QQmlComponent component(engine);
+    component.setData(qml.toUtf8(), testFileUrl("empty.qml")); // just a file for relative local imports
+    QVERIFY(!component.isError());
+    QScopedPointer<QQuickText> text(qobject_cast<QQuickText*>(component.create()));
+    QVERIFY(text);
+    QTRY_COMPARE(text->text(), QString("passed"));
+}
+
 void tst_qqmlsqldatabase::totalDatabases()
 {
     if (engine->offlineStoragePath().isEmpty())
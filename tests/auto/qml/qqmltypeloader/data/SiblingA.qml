@@ -0,0 +1,5 @@
+import QtQml 2.2
+
+QtObject {
+    property string name: "A"
+}
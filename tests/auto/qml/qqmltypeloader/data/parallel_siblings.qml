@@ -0,0 +1,9 @@
+import QtQml 2.2
+
+QtObject {
+    property QtObject a: SiblingA {}
+    property QtObject b: SiblingB {}
+    property QtObject c: SiblingC {}
+    property QtObject d: SiblingD {}
+    property string names: a.name + b.name + c.name + d.name
+}
@@ -0,0 +1,7 @@
+import QtQml 2.2
+
+QtObject {
+    property QtObject a: SiblingA {}
+    property QtObject broken: BrokenSibling {}
+    property QtObject b: SiblingB {}
+}
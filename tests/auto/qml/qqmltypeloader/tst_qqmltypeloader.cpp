@@ -28,10 +28,12 @@
 
 #include <QtTest/QtTest>
 #include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlabstracturlinterceptor.h>
 #include <QtQuick/qquickview.h>
 #include <QtQuick/qquickitem.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmltypeloader_p.h>
+#include <QtQml/private/qqmlstartupmanifest_p.h>
 #include "../../shared/util.h"
 
 class tst_QQMLTypeLoader : public QQmlDataTest
@@ -43,6 +45,11 @@ private slots:
     void loadComponentSynchronously();
     void trimCache();
     void trimCache2();
+    void parallelSiblingParsing();
+    void parallelSiblingParsingError();
+    void parallelSiblingParsingIntercepted();
+    void startupManifest();
+    void startupManifestRecordAndReplay();
 };
 
 void tst_QQMLTypeLoader::testLoadComplete()
@@ -120,6 +127,151 @@ void tst_QQMLTypeLoader::trimCache2()
     QCOMPARE(loader.isTypeLoaded(testFileUrl("MyComponent2.qml")), false);
 }
 
+void tst_QQMLTypeLoader::parallelSiblingParsing()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("parallel_siblings.qml"));
+    // Parsing siblings in the background must not make synchronous loading asynchronous.
+    QCOMPARE(component.status(), QQmlComponent::Ready);
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY(o);
+    QCOMPARE(o->property("names").toString(), QString("ABCD"));
+}
+
+void tst_QQMLTypeLoader::parallelSiblingParsingError()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("parallel_siblings_error.qml"));
+    QCOMPARE(component.status(), QQmlComponent::Error);
+    const QList<QQmlError> errors = component.errors();
+    QCOMPARE(errors.count(), 2);
+    QCOMPARE(errors.at(0).url(), testFileUrl("parallel_siblings_error.qml"));
+    QCOMPARE(errors.at(0).line(), 5);
+    QCOMPARE(errors.at(1).url(), testFileUrl("BrokenSibling.qml"));
+    QCOMPARE(errors.at(1).line(), 5);
+}
+
+class SiblingInterceptor : public QQmlAbstractUrlInterceptor
+{
+public:
+    SiblingInterceptor(const QUrl &directory) : directory(directory) {}
+
+    QUrl intercept(const QUrl &url, DataType type) override
+    {
+        if (type == QmlFile && (url.fileName() == QLatin1String("SiblingB.qml")
+                                || url.fileName() == QLatin1String("SiblingD.qml"))) {
+            return directory.resolved(url.fileName());
+        }
+        return url;
+    }
+
+    QUrl directory;
+};
+
+void tst_QQMLTypeLoader::parallelSiblingParsingIntercepted()
+{
+    // Documents parsed in the background are the ones the intercepted URLs point to.
+    SiblingInterceptor interceptor(testFileUrl("intercepted/"));
+    QQmlEngine engine;
+    engine.setUrlInterceptor(&interceptor);
+    QQmlComponent component(&engine, testFileUrl("parallel_siblings.qml"));
+    QCOMPARE(component.status(), QQmlComponent::Ready);
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY(o);
+    QCOMPARE(o->property("names").toString(), QString("AbCd"));
+}
+
+void tst_QQMLTypeLoader::startupManifest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString manifestPath = tempDir.path() + QLatin1String("/startup.manifest");
+
+    const QString siblingA = testFile("SiblingA.qml");
+    const QString siblingB = testFile("SiblingB.qml");
+    const QString missing = testFile("DoesNotExist.qml");
+
+    QFile file(manifestPath);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write("# qml-startup-manifest 1 " QT_VERSION_STR "\n");
+    file.write("qml\t" + QByteArray::number(QQmlStartupManifest::lastModified(siblingA)) + '\t' + siblingA.toUtf8() + '\n');
+    file.write("qml\t" + QByteArray::number(QQmlStartupManifest::lastModified(siblingB) - 1000) + '\t' + siblingB.toUtf8() + '\n');
+    file.write("qml\t0\t" + missing.toUtf8() + '\n');
+    file.write("qmldir\t" + QByteArray::number(QQmlStartupManifest::lastModified(siblingB)) + '\t' + siblingB.toUtf8() + '\n');
+    file.close();
+
+    qputenv("QML_STARTUP_MANIFEST", QFile::encodeName(manifestPath));
+    QQmlStartupManifest manifest;
+    qunsetenv("QML_STARTUP_MANIFEST");
+
+    // Entries whose file changed or disappeared are dropped.
+    const QVector<QQmlStartupManifest::Entry> entries = manifest.validEntries();
+    QCOMPARE(entries.count(), 2);
+    QCOMPARE(entries.at(0).type, QQmlStartupManifest::QmlDocument);
+    QCOMPARE(entries.at(0).filePath, siblingA);
+    QCOMPARE(entries.at(1).type, QQmlStartupManifest::Qmldir);
+
+    const QVector<QUrl> documents = manifest.documentsToPrefetch();
+    QCOMPARE(documents.count(), 1);
+    QCOMPARE(documents.first(), QUrl::fromLocalFile(siblingA));
+}
+
+void tst_QQMLTypeLoader::startupManifestRecordAndReplay()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString manifestPath = tempDir.path() + QLatin1String("/startup.manifest");
+
+    const QString siblingA = testFile("SiblingA.qml");
+    const QString siblingB = testFile("SiblingB.qml");
+    const QString qmldir = testFile("SiblingC.qml");
+
+    qputenv("QML_STARTUP_MANIFEST", QFile::encodeName(manifestPath));
+
+    // First start: nothing to replay, the touched files are recorded and saved.
+    {
+        QQmlStartupManifest manifest;
+        QVERIFY(manifest.validEntries().isEmpty());
+        QVERIFY(manifest.documentsToPrefetch().isEmpty());
+
+        manifest.addEntry(QQmlStartupManifest::QmlDocument, siblingA);
+        manifest.addEntry(QQmlStartupManifest::Qmldir, qmldir);
+        manifest.addEntry(QQmlStartupManifest::QmlDocument, siblingB);
+        manifest.addEntry(QQmlStartupManifest::QmlDocument, siblingA);
+        QVERIFY(manifest.save());
+        QVERIFY(QFile::exists(manifestPath));
+    }
+
+    // Second start: the recorded entries are replayed in order.
+    {
+        QQmlStartupManifest manifest;
+        const QVector<QQmlStartupManifest::Entry> entries = manifest.validEntries();
+        QCOMPARE(entries.count(), 3);
+        QCOMPARE(entries.at(0).type, QQmlStartupManifest::QmlDocument);
+        QCOMPARE(entries.at(0).filePath, siblingA);
+        QCOMPARE(entries.at(1).type, QQmlStartupManifest::Qmldir);
+        QCOMPARE(entries.at(1).filePath, qmldir);
+        QCOMPARE(entries.at(2).filePath, siblingB);
+
+        const QVector<QUrl> documents = manifest.documentsToPrefetch();
+        QCOMPARE(documents.count(), 2);
+        QCOMPARE(documents.at(0), QUrl::fromLocalFile(siblingA));
+        QCOMPARE(documents.at(1), QUrl::fromLocalFile(siblingB));
+
+        // A start that touches different files rewrites the manifest.
+        manifest.addEntry(QQmlStartupManifest::QmlDocument, siblingB);
+        QVERIFY(manifest.save());
+    }
+
+    {
+        QQmlStartupManifest manifest;
+        QCOMPARE(manifest.validEntries().count(), 1);
+        QCOMPARE(manifest.documentsToPrefetch(), QVector<QUrl>() << QUrl::fromLocalFile(siblingB));
+    }
+
+    qunsetenv("QML_STARTUP_MANIFEST");
+}
+
 QTEST_MAIN(tst_QQMLTypeLoader)
 
 #include "tst_qqmltypeloader.moc"
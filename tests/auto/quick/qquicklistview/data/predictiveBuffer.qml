@@ -0,0 +1,13 @@
+import QtQuick 2.0
+
+ListView {
+    width: 240
+    height: 320
+    cacheBuffer: 100
+    model: 100
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: ListView.view.width
+        height: 20
+    }
+}
@@ -0,0 +1,33 @@
+import QtQuick 2.10
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+
+    property int created: 0
+    property int pooled: 0
+    property int reused: 0
+
+    ListModel {
+        id: listModel
+        Component.onCompleted: {
+            for (var i = 0; i < 100; ++i)
+                append({ "name": "Item " + i })
+        }
+    }
+
+    model: testIntModel ? 100 : listModel
+    delegate: Text {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+        text: testIntModel ? "Item " + modelData : model.name
+        property int modelIndex: index
+        Component.onCompleted: list.created++
+        ListView.onPooled: list.pooled++
+        ListView.onReused: list.reused++
+    }
+}
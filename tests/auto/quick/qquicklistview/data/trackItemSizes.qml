@@ -0,0 +1,13 @@
+import QtQuick 2.10
+
+ListView {
+    width: 240
+    height: 200
+    model: 1000
+    trackItemSizes: true
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: ListView.view.width
+        height: index < 500 ? 20 : 60
+    }
+}
@@ -132,6 +132,8 @@ private slots:
     void sectionDelegateChange();
     void sectionsItemInsertion();
     void cacheBuffer();
+    void predictiveBuffer();
+    void trackItemSizes();
     void positionViewAtBeginningEnd();
     void positionViewAtIndex();
     void positionViewAtIndex_data();
@@ -257,6 +259,8 @@ private slots:
     void QTBUG_50097_stickyHeader_positionViewAtIndex();
     void itemFiltered();
     void releaseItems();
+    void reuseItems_data();
+    void reuseItems();
 
 private:
     template <class T> void items(const QUrl &source);
@@ -3120,6 +3124,87 @@ void tst_QQuickListView::cacheBuffer()
     delete testObject;
 }
 
+void tst_QQuickListView::predictiveBuffer()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("predictiveBuffer.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView*>(window->rootObject());
+    QVERIFY(listview != 0);
+    QQuickItemViewPrivate *d = QQuickItemViewPrivate::get(listview);
+
+    QQmlIncubationController controller;
+    window->engine()->setIncubationController(&controller);
+
+    // not scrolling: only the cache buffer is filled
+    d->bufferMode = QQuickItemViewPrivate::NoBuffer;
+    QCOMPARE(d->predictiveBuffer(), qreal(0));
+
+    // scrolling forward at 1000px/s buffers 250px further ahead
+    d->bufferMode = QQuickItemViewPrivate::BufferAfter;
+    d->vData.smoothVelocity.setValue(-1000);
+    QCOMPARE(d->predictiveBuffer(), qreal(250));
+
+    // items up to 320 + 100 + 250 are created asynchronously
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 30) == 0);
+    for (int i = 0; i < 100 && !findItem<QQuickItem>(listview, "wrapper", 30); ++i) {
+        d->refill();
+        bool b = false;
+        controller.incubateWhile(&b);
+    }
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 30) != 0);
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 34) == 0);
+
+    // never more than one view length ahead
+    d->vData.smoothVelocity.setValue(-10000);
+    QCOMPARE(d->predictiveBuffer(), listview->height());
+
+    // no cache buffer, no predictive buffer
+    listview->setCacheBuffer(0);
+    d->bufferMode = QQuickItemViewPrivate::BufferAfter;
+    QCOMPARE(d->predictiveBuffer(), qreal(0));
+
+    d->vData.smoothVelocity.setValue(0);
+    d->bufferMode = QQuickItemViewPrivate::NoBuffer;
+}
+
+void tst_QQuickListView::trackItemSizes()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("trackItemSizes.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView*>(window->rootObject());
+    QVERIFY(listview != 0);
+    QVERIFY(listview->trackItemSizes());
+
+    // scroll through the whole list so that every item is measured
+    for (int i = 0; i < 1000 && !listview->isAtYEnd(); ++i)
+        listview->setContentY(qMin(listview->contentY() + 150,
+                                   listview->originY() + listview->contentHeight() - listview->height()));
+    QVERIFY(listview->isAtYEnd());
+
+    // the content height is exact, although only the larger items are created
+    QCOMPARE(listview->contentHeight(), qreal(500 * 20 + 500 * 60));
+    QCOMPARE(listview->originY(), qreal(0));
+
+    listview->positionViewAtIndex(250, QQuickListView::Beginning);
+    QCOMPARE(listview->contentY(), qreal(250 * 20));
+    QQuickItem *item = findItem<QQuickItem>(listview->contentItem(), "wrapper", 250);
+    QVERIFY(item);
+    QCOMPARE(item->y(), qreal(250 * 20));
+    QCOMPARE(listview->contentHeight(), qreal(500 * 20 + 500 * 60));
+
+    listview->positionViewAtIndex(750, QQuickListView::Beginning);
+    QCOMPARE(listview->contentY(), qreal(500 * 20 + 250 * 60));
+
+    listview->setTrackItemSizes(false);
+    QVERIFY(!listview->trackItemSizes());
+}
+
 void tst_QQuickListView::positionViewAtBeginningEnd()
 {
     QScopedPointer<QQuickView> window(createView());
@@ -8575,6 +8660,63 @@ void tst_QQuickListView::releaseItems()
     listview->setModel(123);
 }
 
+void tst_QQuickListView::reuseItems_data()
+{
+    QTest::addColumn<bool>("intModel");
+
+    QTest::newRow("ListModel") << false;
+    QTest::newRow("int") << true;
+}
+
+void tst_QQuickListView::reuseItems()
+{
+    QFETCH(bool, intModel);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->rootContext()->setContextProperty("testIntModel", intModel);
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QVERIFY(listview->reuseItems());
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    const int initiallyCreated = listview->property("created").toInt();
+    QVERIFY(initiallyCreated > 0);
+
+    // Scroll one row at a time, so that each refill moves one delegate out of
+    // the view and another one into it.
+    for (int i = 1; i <= 40; ++i) {
+        listview->setContentY(i * 20);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+
+    QVERIFY(listview->property("pooled").toInt() > 0);
+    QVERIFY(listview->property("reused").toInt() > 0);
+    QVERIFY(listview->property("created").toInt() < initiallyCreated + 5);
+
+    // reused delegates are bound to the data of their new index
+    const QList<FxViewItem *> visibleItems = QQuickItemViewPrivate::get(listview)->visibleItems;
+    QVERIFY(!visibleItems.isEmpty());
+    for (FxViewItem *item : visibleItems) {
+        QQuickText *text = qobject_cast<QQuickText *>(item->item);
+        QVERIFY(text);
+        QCOMPARE(text->property("modelIndex").toInt(), item->index);
+        QCOMPARE(text->text(), QString("Item %1").arg(item->index));
+    }
+
+    QQmlInstanceModel *model = QQuickItemViewPrivate::get(listview)->model;
+    listview->setReuseItems(false);
+    QCOMPARE(model->poolSize(), 0);
+
+    const int createdBefore = listview->property("created").toInt();
+    listview->setContentY(60 * 20);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QVERIFY(listview->property("created").toInt() > createdBefore);
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+VisualDataModel {
+    model: myModel
+    delegate: Item {
+        property string text: display
+        property string upperText: display.toUpperCase()
+        property var tip: toolTip
+    }
+}
@@ -0,0 +1,33 @@
+import QtQuick 2.0
+import QtQml.Models 2.10
+
+DelegateModel {
+    id: root
+
+    property alias listModel: listModel
+    property alias sortedItems: sortedItems
+    property alias redItems: redItems
+
+    function names(group) {
+        var result = []
+        for (var i = 0; i < group.count; ++i)
+            result.push(group.get(i).model.name)
+        return result.join(",")
+    }
+
+    model: ListModel {
+        id: listModel
+        ListElement { name: "c"; size: 3; colour: "red" }
+        ListElement { name: "a"; size: 1; colour: "blue" }
+        ListElement { name: "e"; size: 5; colour: "red" }
+        ListElement { name: "b"; size: 2; colour: "blue" }
+        ListElement { name: "d"; size: 4; colour: "red" }
+    }
+
+    groups: [
+        DelegateModelGroup { id: sortedItems; name: "sorted"; includeByDefault: true; sortRole: "size" },
+        DelegateModelGroup { id: redItems; name: "red"; filterRole: "colour"; filterValue: "red" }
+    ]
+
+    delegate: Item {}
+}
@@ -0,0 +1,47 @@
+import QtQuick 2.0
+import QtQml.Models 2.10
+
+DelegateModel {
+    id: root
+
+    property alias listModel: listModel
+    property alias sortedItems: sortedItems
+    property int removed: 0
+    property int inserted: 0
+
+    function fillReversed(count) {
+        for (var i = 0; i < count; ++i)
+            listModel.append({ size: count - i })
+    }
+
+    function resetCounts() {
+        removed = 0
+        inserted = 0
+    }
+
+    function isSorted(group) {
+        for (var i = 1; i < group.count; ++i) {
+            if (group.get(i - 1).model.size > group.get(i).model.size)
+                return false
+        }
+        return true
+    }
+
+    model: ListModel {
+        id: listModel
+    }
+
+    groups: DelegateModelGroup {
+        id: sortedItems
+        name: "sorted"
+        includeByDefault: true
+        onChanged: {
+            for (var i = 0; i < removed.length; ++i)
+                root.removed += removed[i].count
+            for (var i = 0; i < inserted.length; ++i)
+                root.inserted += inserted[i].count
+        }
+    }
+
+    delegate: Item {}
+}
@@ -69,6 +69,20 @@ static void initStandardTreeModel(QStandardItemModel *model)
     model->insertRow(2, item);
 }
 
+class DataCountingModel : public QStandardItemModel
+{
+public:
+    DataCountingModel() : dataCalls(0) {}
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        ++dataCalls;
+        return QStandardItemModel::data(index, role);
+    }
+
+    mutable int dataCalls;
+};
+
 class SingleRoleModel : public QAbstractItemModel
 {
     Q_OBJECT
@@ -404,6 +418,9 @@ private slots:
     void watchedRoles();
     void hasModelChildren();
     void setValue();
+    void fetchedRoles();
+    void sortAndFilter();
+    void sortReset();
     void remove_data();
     void remove();
     void move_data();
@@ -1369,6 +1386,137 @@ void tst_qquickvisualdatamodel::setValue()
     QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);  // Ensure released items are deleted before test exits.
 }
 
+void tst_qquickvisualdatamodel::fetchedRoles()
+{
+    DataCountingModel model;
+    initStandardTreeModel(&model);
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("fetchedRoles.qml"));
+
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *vdm = qobject_cast<QQmlDelegateModel*>(object.data());
+    QVERIFY(vdm);
+
+    // Each role is fetched from the model once however many bindings read it.
+    QQuickItem *item = qobject_cast<QQuickItem*>(vdm->object(0));
+    QVERIFY(item);
+    QCOMPARE(item->property("text").toString(), QString("Row 1 Item"));
+    QCOMPARE(item->property("upperText").toString(), QString("ROW 1 ITEM"));
+    QCOMPARE(model.dataCalls, 2);
+
+    QCOMPARE(evaluate<QString>(item, "display"), QString("Row 1 Item"));
+    QCOMPARE(model.dataCalls, 2);
+
+    QQuickItem *item2 = qobject_cast<QQuickItem*>(vdm->object(2));
+    QVERIFY(item2);
+    QCOMPARE(item2->property("text").toString(), QString("Row 3 Item"));
+    QCOMPARE(model.dataCalls, 4);
+
+    // A change reported by the model is fetched again.
+    model.item(0)->setText(QLatin1String("Changed Item 1"));
+    QCOMPARE(item->property("text").toString(), QString("Changed Item 1"));
+    QCOMPARE(item->property("upperText").toString(), QString("CHANGED ITEM 1"));
+    QCOMPARE(item2->property("text").toString(), QString("Row 3 Item"));
+
+    const int dataCalls = model.dataCalls;
+    QCOMPARE(evaluate<QString>(item, "display"), QString("Changed Item 1"));
+    QCOMPARE(model.dataCalls, dataCalls);
+
+    // So is a value written through the delegate.
+    evaluate<void>(item, "display = 'Written Item 1'");
+    QCOMPARE(evaluate<QString>(item, "display"), QString("Written Item 1"));
+    QCOMPARE(item->property("text").toString(), QString("Written Item 1"));
+
+    vdm->release(item);
+    vdm->release(item2);
+
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);  // Ensure released items are deleted before test exits.
+}
+
+void tst_qquickvisualdatamodel::sortAndFilter()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("sortAndFilter.qml"));
+
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *vdm = qobject_cast<QQmlDelegateModel*>(object.data());
+    QVERIFY(vdm);
+
+    QCOMPARE(evaluate<QString>(vdm, "names(sortedItems)"), QString("a,b,c,d,e"));
+    QCOMPARE(evaluate<QString>(vdm, "names(items)"), QString("a,b,c,d,e"));
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("c,d,e"));
+
+    // Changed items are moved into place.
+    evaluate<void>(vdm, "listModel.setProperty(1, 'size', 6)");
+    QCOMPARE(evaluate<QString>(vdm, "names(sortedItems)"), QString("b,c,d,e,a"));
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("c,d,e"));
+
+    // And added to or removed from filtered groups.
+    evaluate<void>(vdm, "listModel.setProperty(3, 'colour', 'red')");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("b,c,d,e"));
+    evaluate<void>(vdm, "listModel.setProperty(0, 'colour', 'green')");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("b,d,e"));
+
+    // Inserted items are placed in order.
+    evaluate<void>(vdm, "listModel.append({ name: 'f', size: 0, colour: 'red' })");
+    QCOMPARE(evaluate<QString>(vdm, "names(sortedItems)"), QString("f,b,c,d,e,a"));
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("f,b,d,e"));
+
+    evaluate<void>(vdm, "sortedItems.sortOrder = Qt.DescendingOrder");
+    QCOMPARE(evaluate<QString>(vdm, "names(sortedItems)"), QString("a,e,d,c,b,f"));
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("e,d,b,f"));
+
+    evaluate<void>(vdm, "redItems.filterValue = /^(blue|green)$/");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("a,c"));
+
+    // Removing the filter restores the default membership of the group.
+    evaluate<void>(vdm, "redItems.filterRole = ''");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString(""));
+
+    evaluate<void>(vdm, "redItems.includeByDefault = true");
+    evaluate<void>(vdm, "redItems.filterRole = 'colour'");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("a,c"));
+    evaluate<void>(vdm, "redItems.filterRole = ''");
+    QCOMPARE(evaluate<QString>(vdm, "names(redItems)"), QString("a,e,d,c,b,f"));
+
+    evaluate<void>(vdm, "sortedItems.sortRole = 'name'");
+    QCOMPARE(evaluate<QString>(vdm, "names(sortedItems)"), QString("f,e,d,c,b,a"));
+}
+
+void tst_qquickvisualdatamodel::sortReset()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("sortReset.qml"));
+
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *vdm = qobject_cast<QQmlDelegateModel*>(object.data());
+    QVERIFY(vdm);
+
+    evaluate<void>(vdm, "fillReversed(300)");
+    QCOMPARE(evaluate<int>(vdm, "sortedItems.count"), 300);
+    QVERIFY(!evaluate<bool>(vdm, "isSorted(sortedItems)"));
+    evaluate<void>(vdm, "resetCounts()");
+
+    // Reversing the items takes more moves than are reported one by one, so views are
+    // told that the whole group was replaced.
+    evaluate<void>(vdm, "sortedItems.sortRole = 'size'");
+    QVERIFY(evaluate<bool>(vdm, "isSorted(sortedItems)"));
+    QCOMPARE(evaluate<int>(vdm, "removed"), 300);
+    QCOMPARE(evaluate<int>(vdm, "inserted"), 300);
+    QCOMPARE(evaluate<int>(vdm, "sortedItems.get(0).model.size"), 1);
+    QCOMPARE(evaluate<int>(vdm, "items.get(299).model.size"), 300);
+
+    // A single move is still reported as a move.
+    evaluate<void>(vdm, "resetCounts()");
+    evaluate<void>(vdm, "listModel.setProperty(299, 'size', 1000)");
+    QVERIFY(evaluate<bool>(vdm, "isSorted(sortedItems)"));
+    QCOMPARE(evaluate<int>(vdm, "removed"), 1);
+    QCOMPARE(evaluate<int>(vdm, "inserted"), 1);
+}
+
 void tst_qquickvisualdatamodel::remove_data()
 {
     QTest::addColumn<QUrl>("source");
@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 200
+    height: 200
+
+    RotationAnimation on rotation { from: 0; to: 360; duration: 1000; loops: Animation.Infinite }
+
+    Loader {
+        objectName: "loader"
+        active: false
+        asynchronous: true
+        sourceComponent: Item {
+            Repeater {
+                model: 500
+                Rectangle {
+                    width: 10; height: 10; x: index % 20 * 10; y: index / 20 * 10
+                    // Make each delegate take a noticeable, but small part of a frame.
+                    color: { var sum = 0; for (var i = 0; i < 20000; ++i) sum += i; return sum > 0 ? "red" : "blue" }
+                }
+            }
+        }
+    }
+}
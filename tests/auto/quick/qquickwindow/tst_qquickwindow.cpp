@@ -377,6 +377,8 @@ private slots:
 
     void findChild();
 
+    void frameSyncedIncubation();
+
 private:
     QTouchDevice *touchDevice;
     QTouchDevice *touchDeviceWithVelocity;
@@ -2877,6 +2879,34 @@ void tst_qquickwindow::findChild()
     QCOMPARE(window.contentItem()->findChild<QObject *>("contentItemChild"), contentItemChild);
 }
 
+void tst_qquickwindow::frameSyncedIncubation()
+{
+    QQuickView view(testFileUrl("frameSyncedIncubation.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickLoader *loader = view.rootObject()->findChild<QQuickLoader *>("loader");
+    QVERIFY(loader);
+    loader->setActive(true);
+    QTRY_COMPARE(loader->status(), QQuickLoader::Ready);
+
+    const QQuickWindowPrivate::IncubationStatistics statistics
+            = QQuickWindowPrivate::get(&view)->incubationStatistics();
+    if (statistics.frames == 0)
+        QSKIP("The render loop does not report the time left in a frame");
+
+    // The delegates did not fit into one frame, so the work was spread over several.
+    QVERIFY2(statistics.frames > 1, qPrintable(QString::number(statistics.frames)));
+    QVERIFY(statistics.maxObjectsPerFrame < statistics.objects);
+
+    // Each frame only incubated for the time it had left. incubateFor() checks the time
+    // between objects, so it can run over by one delegate, but not by a frame.
+    const int frameInterval = qMax(1, int(1000 / view.screen()->refreshRate()));
+    QVERIFY2(statistics.maxOvershoot < frameInterval,
+             qPrintable(QString::fromLatin1("ran %1 ms past the end of a frame of %2 ms")
+                        .arg(statistics.maxOvershoot).arg(frameInterval)));
+}
+
 QTEST_MAIN(tst_qquickwindow)
 
 #include "tst_qquickwindow.moc"
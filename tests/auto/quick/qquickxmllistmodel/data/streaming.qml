@@ -0,0 +1,9 @@
+import QtQuick 2.0
+import QtQuick.XmlListModel 2.0
+
+XmlListModel {
+    query: "/data/item"
+    XmlRole { name: "id"; query: "@id/string()" }
+    XmlRole { name: "name"; query: "name/string()" }
+    XmlRole { name: "age"; query: "age/number()" }
+}
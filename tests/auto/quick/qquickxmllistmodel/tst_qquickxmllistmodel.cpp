@@ -92,6 +92,7 @@ private slots:
     void threading_data();
     void propertyChanges();
     void selectAncestor();
+    void streaming();
 
     void roleCrash();
     void proxyCrash();
@@ -968,6 +969,66 @@ void tst_qquickxmllistmodel::selectAncestor()
     QCOMPARE(model->data(index, Qt::UserRole+1).toString(), QLatin1String("cats"));
 }
 
+void tst_qquickxmllistmodel::streaming()
+{
+    // Simple queries are read in one pass and the rows are inserted in batches as they are read.
+    QQmlComponent component(&engine, testFileUrl("streaming.qml"));
+    QAbstractItemModel *model = qobject_cast<QAbstractItemModel *>(component.create());
+    QVERIFY(model != 0);
+
+    QString xml = QLatin1String("<data>");
+    for (int i = 0; i < 1000; ++i) {
+        xml += QString("<item id=\"%1\"><name>Name <b>%1</b></name><age>%1</age></item>").arg(i);
+        xml += QLatin1String("<other><item id=\"nested\"/></other>");
+    }
+    xml += QLatin1String("</data>");
+
+    QSignalSpy spyInsert(model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyRemove(model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    model->setProperty("xml", xml);
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(model->property("status")),
+                 QQuickXmlListModel::Ready);
+    QCOMPARE(model->rowCount(), 1000);
+
+    QVERIFY(spyInsert.count() > 1);
+    int row = 0;
+    for (int i = 0; i < spyInsert.count(); ++i) {
+        QCOMPARE(spyInsert[i][1].toInt(), row);
+        row = spyInsert[i][2].toInt() + 1;
+    }
+    QCOMPARE(row, 1000);
+    QCOMPARE(spyRemove.count(), 0);
+
+    QModelIndex index = model->index(500, 0);
+    QCOMPARE(model->data(index, Qt::UserRole).toString(), QLatin1String("500"));
+    QCOMPARE(model->data(index, Qt::UserRole+1).toString(), QLatin1String("Name 500"));
+    QCOMPARE(model->data(index, Qt::UserRole+2).toDouble(), 500.0);
+
+    // The rows of a new document replace the old ones.
+    spyInsert.clear();
+    model->setProperty("xml", QLatin1String("<data><item id=\"a\"><age>x</age></item></data>"));
+    QTRY_COMPARE(model->rowCount(), 1);
+    QCOMPARE(spyRemove.count(), 1);
+    QCOMPARE(spyInsert.count(), 1);
+    index = model->index(0, 0);
+    QCOMPARE(model->data(index, Qt::UserRole).toString(), QLatin1String("a"));
+    QCOMPARE(model->data(index, Qt::UserRole+1), QVariant(""));
+    QVERIFY(qIsNaN(model->data(index, Qt::UserRole+2).toDouble()));
+
+    // An empty element is an empty string for number() too, as with XQuery.
+    model->setProperty("xml", QLatin1String("<data><item id=\"b\"><age></age></item><item id=\"c\"><age/></item></data>"));
+    QTRY_COMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(0, 0), Qt::UserRole).toString(), QLatin1String("b"));
+    QCOMPARE(model->data(model->index(0, 0), Qt::UserRole+2), QVariant(""));
+    QCOMPARE(model->data(model->index(1, 0), Qt::UserRole+2), QVariant(""));
+
+    // A malformed document has no items.
+    model->setProperty("xml", QLatin1String("<data><item id=\"a\"></data>"));
+    QTRY_COMPARE(model->rowCount(), 0);
+
+    delete model;
+}
+
 void tst_qquickxmllistmodel::roleCrash()
 {
     // don't crash
@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+Item {
+    id: root
+    width: 400
+    height: 40
+    property int count: 0
+
+    Item { x: root.width * 0 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 1 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 2 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 3 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 4 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 5 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 6 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 7 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 8 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 9 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 10 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 11 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 12 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 13 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 14 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 15 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 16 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 17 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 18 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 19 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 20 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 21 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 22 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 23 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 24 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 25 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 26 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 27 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 28 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 29 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 30 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 31 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 32 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 33 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 34 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 35 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 36 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 37 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 38 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+    Item { x: root.width * 39 / 40; width: root.width / 40; height: root.height; onWidthChanged: root.count++ }
+}
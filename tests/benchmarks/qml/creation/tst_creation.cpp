@@ -34,6 +34,7 @@
 #include <QQuickItem>
 #include <QQmlContext>
 #include <private/qobject_p.h>
+#include <private/qqmlcreationarena_p.h>
 
 class tst_creation : public QObject
 {
@@ -61,6 +62,7 @@ private slots:
 
     void itemtests_qml_data();
     void itemtests_qml();
+    void delegate_qml();
 
     void bindings_cpp();
     void bindings_cpp2();
@@ -335,6 +337,30 @@ void tst_creation::itemtests_qml()
     QBENCHMARK { delete component.create(); }
 }
 
+void tst_creation::delegate_qml()
+{
+    QQmlComponent component(&engine, TEST_FILE("delegateWithChildren.qml"));
+    if (!component.isReady()) {
+        qWarning() << "Unable to create component: " << component.errorString();
+        return;
+    }
+
+    delete component.create();
+    QQmlCreationArena::setStatisticsEnabled(true);
+    QQmlCreationArena::resetStatistics();
+    int instances = 0;
+    QBENCHMARK {
+        delete component.create();
+        ++instances;
+    }
+    QQmlCreationArena::setStatisticsEnabled(false);
+
+    const QQmlCreationArena::Statistics statistics = QQmlCreationArena::statistics();
+    qDebug("per instance: %d arena allocations in %d chunks, %d heap allocations",
+           statistics.arenaAllocations / instances, statistics.chunks / instances,
+           statistics.heapAllocations / instances);
+}
+
 void tst_creation::bindings_cpp()
 {
     QQuickItem item;
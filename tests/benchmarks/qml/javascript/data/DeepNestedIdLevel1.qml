@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+QtObject {
+    id: level1
+
+    property variant object: DeepNestedIdLevel2 {}
+    function runtest() {
+        object.runtest();
+    }
+}
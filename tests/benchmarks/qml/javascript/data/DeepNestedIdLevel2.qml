@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+QtObject {
+    id: level2
+
+    property variant object: DeepNestedIdLevel3 {}
+    function runtest() {
+        object.runtest();
+    }
+}
@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+QtObject {
+    id: level3
+
+    property variant object: DeepNestedIdLevel4 {}
+    function runtest() {
+        object.runtest();
+    }
+}
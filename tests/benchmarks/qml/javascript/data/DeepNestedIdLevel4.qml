@@ -0,0 +1,11 @@
+import QtQuick 2.0
+
+QtObject {
+    id: level4
+
+    function runtest() {
+        for (var ii = 0; ii < 5000000; ++ii) {
+            root
+        }
+    }
+}
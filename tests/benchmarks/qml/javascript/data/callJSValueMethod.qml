@@ -0,0 +1,13 @@
+import Qt.test 1.0
+
+TestObject {
+    id: root
+
+    function runtest() {
+        var r = root;
+        var value = { a: 1 };
+        for (var ii = 0; ii < 1000000; ++ii) {
+            r.passJSValue(value)
+        }
+    }
+}
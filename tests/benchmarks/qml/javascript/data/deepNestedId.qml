@@ -0,0 +1,12 @@
+// Benchmarks the cost of accessing an id several component contexts above the script.
+
+import QtQuick 2.0
+
+QtObject {
+    id: root
+
+    property variant object: DeepNestedIdLevel1 {}
+    function runtest() {
+        object.runtest();
+    }
+}
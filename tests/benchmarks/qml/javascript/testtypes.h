@@ -30,6 +30,8 @@
 #define TESTTYPES_H
 
 #include <QtCore/qobject.h>
+#include <QtCore/qvariant.h>
+#include <QtQml/qjsvalue.h>
 
 class TestObject : public QObject
 {
@@ -43,6 +45,14 @@ public:
     int intValue() const { return 13; }
     QString stringValue() const { return m_string; }
 
+    Q_INVOKABLE int addInts(int a, int b) const { return a + b; }
+    Q_INVOKABLE double scaleReal(double value) const { return value * 2.0; }
+    Q_INVOKABLE QString appendString(const QString &value) const { return value + m_string; }
+    Q_INVOKABLE int variantListCount(const QVariantList &list) const { return list.count(); }
+    Q_INVOKABLE QVariantList variantList() const { return QVariantList() << 1 << 2 << 3; }
+    Q_INVOKABLE QJSValue passJSValue(const QJSValue &value) const { return value; }
+    Q_INVOKABLE QObject *passObject(QObject *object) const { return object; }
+
 private:
     QString m_string;
 };
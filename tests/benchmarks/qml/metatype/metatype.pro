@@ -0,0 +1,7 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_metatype
+QT += core-private qml-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_metatype.cpp
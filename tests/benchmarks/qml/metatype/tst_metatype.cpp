@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QThread>
+#include <QVector>
+#include <QUrl>
+#include <private/qqmlmetatype_p.h>
+
+// Measures how type lookups and component loading scale when several threads,
+// each with its own engine, use the process-wide QML type registry at once.
+class tst_metatype : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void lookups_data() { threadCounts(); }
+    void lookups();
+    void loadComponents_data() { threadCounts(); }
+    void loadComponents();
+
+private:
+    void threadCounts();
+};
+
+static const int lookupsPerThread = 20000;
+static const int componentsPerThread = 50;
+
+class LookupThread : public QThread
+{
+public:
+    void run() override
+    {
+        const QString moduleName = QStringLiteral("QtQml");
+        const QString typeName = QStringLiteral("QtObject");
+        const QHashedStringRef module(moduleName);
+        const QHashedStringRef name(typeName);
+        for (int i = 0; i < lookupsPerThread; ++i) {
+            QQmlType type = QQmlMetaType::qmlType(name, module, 2, 0);
+            type = QQmlMetaType::qmlType(&QObject::staticMetaObject);
+            QQmlMetaType::isQObject(type.typeId());
+            QQmlMetaType::propertyCache(&QObject::staticMetaObject);
+        }
+    }
+};
+
+class LoadThread : public QThread
+{
+public:
+    explicit LoadThread(int id) : m_id(id) {}
+
+    void run() override
+    {
+        QQmlEngine engine;
+        for (int i = 0; i < componentsPerThread; ++i) {
+            // A distinct url per component defeats the type loader cache, so that
+            // every iteration compiles, registers and resolves its types again.
+            const QUrl url(QStringLiteral("file:///tst_metatype/thread%1/Component%2.qml").arg(m_id).arg(i));
+            QQmlComponent component(&engine);
+            component.setData("import QtQml 2.0\n"
+                              "QtObject {\n"
+                              "    property int value: 42\n"
+                              "    property QtObject child: QtObject { objectName: \"child\" }\n"
+                              "    property list<QtObject> items: [ QtObject {}, QtObject {}, Timer {} ]\n"
+                              "    property var binding: value * 2 + items.length\n"
+                              "    Component.onCompleted: objectName = \"root\"\n"
+                              "}\n", url);
+            delete component.create();
+        }
+    }
+
+private:
+    int m_id;
+};
+
+void tst_metatype::initTestCase()
+{
+    // Registers the QtQml types before the threads start looking them up.
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQml 2.0\nQtObject {}\n", QUrl());
+    delete component.create();
+}
+
+void tst_metatype::threadCounts()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+}
+
+void tst_metatype::lookups()
+{
+    QFETCH(int, threadCount);
+
+    QBENCHMARK {
+        QVector<LookupThread *> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.append(new LookupThread);
+        for (LookupThread *thread : qAsConst(threads))
+            thread->start();
+        for (LookupThread *thread : qAsConst(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+void tst_metatype::loadComponents()
+{
+    QFETCH(int, threadCount);
+
+    QBENCHMARK {
+        QVector<LoadThread *> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.append(new LoadThread(i));
+        for (LoadThread *thread : qAsConst(threads))
+            thread->start();
+        for (LoadThread *thread : qAsConst(threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+QTEST_MAIN(tst_metatype)
+
+#include "tst_metatype.moc"
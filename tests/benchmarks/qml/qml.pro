@@ -8,9 +8,11 @@ SUBDIRS += \
            qqmlchangeset \
            qqmlcomponent \
            qqmlmetaproperty \
+           metatype \
            librarymetrics_performance \
            script \
            js \
-           creation
+           creation \
+           qquicklistview
 
 qtHaveModule(opengl): SUBDIRS += painting qquickwindow
@@ -31,6 +31,7 @@
 #include <QDebug>
 
 #include <private/qqmlchangeset_p.h>
+#include <private/qqmllistcompositor_p.h>
 
 class tst_qqmlchangeset : public QObject
 {
@@ -38,6 +39,11 @@ class tst_qqmlchangeset : public QObject
 
 private slots:
     void move();
+    void compositorFind();
+    void compositorSetFlags();
+
+private:
+    static void populateFragmented(QQmlListCompositor *compositor, void *list);
 };
 
 void tst_qqmlchangeset::move()
@@ -51,5 +57,46 @@ void tst_qqmlchangeset::move()
     }
 }
 
+static const int FRAGMENTED_RANGES = 100000;
+
+// Appends one item ranges whose membership of the Persisted group alternates, so that none
+// of them can be merged.
+void tst_qqmlchangeset::populateFragmented(QQmlListCompositor *compositor, void *list)
+{
+    for (int i = 0; i < FRAGMENTED_RANGES; ++i) {
+        compositor->append(list, i, 1, QQmlListCompositor::DefaultFlag
+                | (i % 2 ? QQmlListCompositor::PersistedFlag : 0));
+    }
+}
+
+void tst_qqmlchangeset::compositorFind()
+{
+    int list;
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(3);
+    populateFragmented(&compositor, &list);
+
+    QBENCHMARK {
+        // Stride through the list so successive lookups are far apart.
+        for (int i = 0, index = 0; i < 10000; ++i, index = (index + 7919) % FRAGMENTED_RANGES)
+            compositor.find(QQmlListCompositor::Default, index);
+    }
+}
+
+void tst_qqmlchangeset::compositorSetFlags()
+{
+    int list;
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(3);
+    populateFragmented(&compositor, &list);
+
+    QBENCHMARK {
+        for (int i = 0, index = 0; i < 10000; ++i, index = (index + 7919) % FRAGMENTED_RANGES) {
+            compositor.setFlags(QQmlListCompositor::Default, index, 1, QQmlListCompositor::CacheFlag);
+            compositor.clearFlags(QQmlListCompositor::Default, index, 1, QQmlListCompositor::CacheFlag);
+        }
+    }
+}
+
 QTEST_MAIN(tst_qqmlchangeset)
 #include "tst_qqmlchangeset.moc"
@@ -0,0 +1,34 @@
+import QtQuick 2.10
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+
+    property int created: 0
+
+    model: ListModel {
+        Component.onCompleted: {
+            for (var i = 0; i < 2000; ++i)
+                append({ "name": "Item " + i, "value": i })
+        }
+    }
+
+    delegate: Rectangle {
+        width: list.width
+        height: 40
+        color: index % 2 ? "lightsteelblue" : "lightgray"
+        Component.onCompleted: list.created++
+
+        Row {
+            anchors.fill: parent
+            anchors.margins: 4
+            spacing: 4
+            Rectangle { width: 32; height: 32; radius: 16; color: "steelblue" }
+            Column {
+                Text { text: name; font.bold: true }
+                Text { text: "value: " + value }
+            }
+        }
+    }
+}
@@ -0,0 +1,13 @@
+import QtQuick 2.10
+
+ListView {
+    width: 240
+    height: 320
+    model: 1000000
+
+    delegate: Rectangle {
+        width: ListView.view.width
+        height: 20 + (index % 7) * 10
+        color: index % 2 ? "lightsteelblue" : "lightgray"
+    }
+}
@@ -0,0 +1,9 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_qquicklistview
+QT += core-private gui-private qml-private quick-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qquicklistview.cpp
+
+DEFINES += SRCDIR=\\\"$$PWD\\\"
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQuickItem>
+#include <QtQuick/private/qquicklistview_p.h>
+
+class tst_qquicklistview : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qquicklistview() {}
+
+private slots:
+    void flick_data();
+    void flick();
+    void creations_data();
+    void creations();
+    void positionViewAtIndex_data();
+    void positionViewAtIndex();
+
+private:
+    QQuickListView *createView(bool reuseItems);
+    static void scrollThrough(QQuickListView *view);
+
+    QQmlEngine engine;
+};
+
+inline QUrl TEST_FILE(const QString &filename)
+{
+    return QUrl::fromLocalFile(QLatin1String(SRCDIR) + QLatin1String("/data/") + filename);
+}
+
+QQuickListView *tst_qquicklistview::createView(bool reuseItems)
+{
+    QQmlComponent component(&engine, TEST_FILE("flick.qml"));
+    QQuickListView *view = qobject_cast<QQuickListView *>(component.create());
+    if (view) {
+        view->setReuseItems(reuseItems);
+        view->forceLayout();
+    }
+    return view;
+}
+
+// Moves the view down by a fraction of a delegate per step, like a flick
+// does frame by frame, so that delegates continuously leave and enter it.
+void tst_qquicklistview::scrollThrough(QQuickListView *view)
+{
+    const qreal end = view->contentHeight() - view->height();
+    for (qreal y = 0; y < end; y += 13)
+        view->setContentY(y);
+    view->setContentY(0);
+}
+
+void tst_qquicklistview::flick_data()
+{
+    QTest::addColumn<bool>("reuseItems");
+
+    QTest::newRow("create") << false;
+    QTest::newRow("reuse") << true;
+}
+
+void tst_qquicklistview::flick()
+{
+    QFETCH(bool, reuseItems);
+
+    QScopedPointer<QQuickListView> view(createView(reuseItems));
+    QVERIFY(view);
+
+    QBENCHMARK {
+        scrollThrough(view.data());
+    }
+}
+
+void tst_qquicklistview::creations_data()
+{
+    flick_data();
+}
+
+// Reports the number of delegates created while scrolling through the whole
+// list once.
+void tst_qquicklistview::creations()
+{
+    QFETCH(bool, reuseItems);
+
+    QScopedPointer<QQuickListView> view(createView(reuseItems));
+    QVERIFY(view);
+
+    const int initiallyCreated = view->property("created").toInt();
+    scrollThrough(view.data());
+    QTest::setBenchmarkResult(view->property("created").toInt() - initiallyCreated, QTest::Events);
+}
+
+void tst_qquicklistview::positionViewAtIndex_data()
+{
+    QTest::addColumn<bool>("trackItemSizes");
+
+    QTest::newRow("average") << false;
+    QTest::newRow("tracked") << true;
+}
+
+// Jumps back and forth across a million delegates of varying size.
+void tst_qquicklistview::positionViewAtIndex()
+{
+    QFETCH(bool, trackItemSizes);
+
+    QQmlComponent component(&engine, TEST_FILE("variableSizes.qml"));
+    QScopedPointer<QQuickListView> view(qobject_cast<QQuickListView *>(component.create()));
+    QVERIFY(view);
+    view->setTrackItemSizes(trackItemSizes);
+    view->forceLayout();
+
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i)
+            view->positionViewAtIndex((i * 7919) % 1000000, QQuickListView::Beginning);
+    }
+}
+
+QTEST_MAIN(tst_qquicklistview)
+
+#include "tst_qquicklistview.moc"
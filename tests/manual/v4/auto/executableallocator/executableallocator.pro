@@ -1,4 +1,4 @@
 TEMPLATE = app
 TARGET = tst_executableallocator
 SOURCES = tst_executableallocator.cpp
-QT = core v4-private testlib
+QT = core qml-private testlib
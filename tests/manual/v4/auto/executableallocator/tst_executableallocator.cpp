@@ -31,9 +31,26 @@
 #include <stdlib.h>
 #include <assert.h>
 
-#include <private/qv4executableallocator.h>
+#include <private/qv4executableallocator_p.h>
 
-using namespace QQmlJS::VM;
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace QV4;
+
+static size_t systemPageSize()
+{
+#ifdef Q_OS_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+}
 
 class tst_ExecutableAllocator : public QObject
 {
@@ -43,14 +60,20 @@ private slots:
     void mergeNext();
     void mergePrev();
     void multipleChunks();
+    void granularity();
+    void writeBatches();
+    void pools();
+    void statistics();
 };
 
 void tst_ExecutableAllocator::singleAlloc()
 {
     ExecutableAllocator allocator;
-    ExecutableAllocator::Allocation *p = allocator.allocate(256);
+    ExecutableAllocator::WriteBatch batch(&allocator);
+    ExecutableAllocator::Allocation *p = allocator.allocate(256, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
     QCOMPARE(allocator.chunkCount(), 1);
+    batch.commit();
     allocator.free(p);
     QCOMPARE(allocator.freeAllocationCount(), 0);
     QCOMPARE(allocator.chunkCount(), 0);
@@ -59,12 +82,13 @@ void tst_ExecutableAllocator::singleAlloc()
 void tst_ExecutableAllocator::mergeNext()
 {
     ExecutableAllocator allocator;
+    ExecutableAllocator::WriteBatch batch(&allocator);
 
-    ExecutableAllocator::Allocation *first = allocator.allocate(10);
+    ExecutableAllocator::Allocation *first = allocator.allocate(10, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
     QCOMPARE(allocator.chunkCount(), 1);
 
-    ExecutableAllocator::Allocation *second = allocator.allocate(10);
+    ExecutableAllocator::Allocation *second = allocator.allocate(10, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
     QCOMPARE(allocator.chunkCount(), 1);
 
@@ -73,6 +97,7 @@ void tst_ExecutableAllocator::mergeNext()
     QCOMPARE(allocator.chunkCount(), 1);
 
     allocator.free(first);
+    batch.commit();
     QCOMPARE(allocator.freeAllocationCount(), 0);
     QCOMPARE(allocator.chunkCount(), 0);
 }
@@ -80,14 +105,15 @@ void tst_ExecutableAllocator::mergeNext()
 void tst_ExecutableAllocator::mergePrev()
 {
     ExecutableAllocator allocator;
+    ExecutableAllocator::WriteBatch batch(&allocator);
 
-    ExecutableAllocator::Allocation *first = allocator.allocate(10);
+    ExecutableAllocator::Allocation *first = allocator.allocate(10, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
 
-    ExecutableAllocator::Allocation *second = allocator.allocate(10);
+    ExecutableAllocator::Allocation *second = allocator.allocate(10, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
 
-    ExecutableAllocator::Allocation *third = allocator.allocate(10);
+    ExecutableAllocator::Allocation *third = allocator.allocate(10, &batch);
     QCOMPARE(allocator.freeAllocationCount(), 1);
 
     allocator.free(first);
@@ -97,28 +123,182 @@ void tst_ExecutableAllocator::mergePrev()
     QCOMPARE(allocator.freeAllocationCount(), 2);
 
     allocator.free(third);
+    batch.commit();
     QCOMPARE(allocator.freeAllocationCount(), 0);
+    QCOMPARE(allocator.chunkCount(), 0);
 }
 
 void tst_ExecutableAllocator::multipleChunks()
 {
     ExecutableAllocator allocator;
+    ExecutableAllocator::WriteBatch batch(&allocator);
 
-    ExecutableAllocator::Allocation *first = allocator.allocate(10);
+    ExecutableAllocator::Allocation *first = allocator.allocate(10, &batch);
     QCOMPARE(allocator.chunkCount(), 1);
 
-    ExecutableAllocator::Allocation *second = allocator.allocate(8 * 1024 * 1024);
+    ExecutableAllocator::Allocation *second = allocator.allocate(8 * 1024 * 1024, &batch);
     QCOMPARE(allocator.chunkCount(), 2);
 
-    ExecutableAllocator::Allocation *third = allocator.allocate(1024);
+    ExecutableAllocator::Allocation *third = allocator.allocate(100, &batch);
     QCOMPARE(allocator.chunkCount(), 2);
+    QCOMPARE(allocator.chunkForAllocation(third), allocator.chunkForAllocation(first));
+
+    // Functions of a different size class go into a chunk of their own.
+    ExecutableAllocator::Allocation *fourth = allocator.allocate(1024, &batch);
+    QCOMPARE(allocator.chunkCount(), 3);
+
+    batch.commit();
+    allocator.free(first);
+    allocator.free(second);
+    allocator.free(third);
+    allocator.free(fourth);
+    QCOMPARE(allocator.chunkCount(), 0);
+    QCOMPARE(allocator.freeAllocationCount(), 0);
+}
+
+void tst_ExecutableAllocator::granularity()
+{
+    ExecutableAllocator allocator;
+    ExecutableAllocator::WriteBatch batch(&allocator);
+
+    ExecutableAllocator::Allocation *first = allocator.allocate(10, &batch);
+    ExecutableAllocator::Allocation *second = allocator.allocate(100, &batch);
+    ExecutableAllocator::Allocation *third = allocator.allocate(10, &batch);
+    QCOMPARE(allocator.chunkCount(), 1);
 
+    const quintptr firstStart = reinterpret_cast<quintptr>(first->start());
+    const quintptr secondStart = reinterpret_cast<quintptr>(second->start());
+    const quintptr thirdStart = reinterpret_cast<quintptr>(third->start());
+    QCOMPARE(firstStart % 16, quintptr(0));
+    QCOMPARE(secondStart - firstStart, quintptr(16));
+    QCOMPARE(thirdStart - secondStart, quintptr(112));
+
+    batch.commit();
     allocator.free(first);
     allocator.free(second);
     allocator.free(third);
     QCOMPARE(allocator.chunkCount(), 0);
+}
+
+void tst_ExecutableAllocator::writeBatches()
+{
+    if (!ExecutableAllocator::writeXorExecute())
+        QSKIP("Code is writable and executable at once, write batches change no protection");
+
+    ExecutableAllocator allocator;
+    const quintptr pageSize = systemPageSize();
+
+    ExecutableAllocator::WriteBatch first(&allocator);
+    ExecutableAllocator::Allocation *a = allocator.allocate(10, &first);
+    ExecutableAllocator::Allocation *b = allocator.allocate(10, &first);
+    QCOMPARE(allocator.chunkForAllocation(b), allocator.chunkForAllocation(a));
+
+    // A chunk only takes code for one batch at a time.
+    ExecutableAllocator::WriteBatch second(&allocator);
+    ExecutableAllocator::Allocation *c = allocator.allocate(10, &second);
+    QVERIFY(allocator.chunkForAllocation(c) != allocator.chunkForAllocation(a));
+    QCOMPARE(allocator.chunkCount(), 2);
+
+    // One protection change covers everything the batch wrote into a chunk.
+    first.commit();
+    QCOMPARE(allocator.statistics().protectionChangeCount, 1);
+    second.commit();
+    QCOMPARE(allocator.statistics().protectionChangeCount, 2);
+
+    // Later batches write to the pages behind the executable ones.
+    ExecutableAllocator::WriteBatch third(&allocator);
+    ExecutableAllocator::Allocation *d = allocator.allocate(10, &third);
+    const quintptr dStart = reinterpret_cast<quintptr>(d->start());
+    QVERIFY(allocator.chunkForAllocation(d) == allocator.chunkForAllocation(a)
+            || allocator.chunkForAllocation(d) == allocator.chunkForAllocation(c));
+    QCOMPARE(dStart % pageSize, quintptr(0));
+    third.commit();
+    QCOMPARE(allocator.statistics().protectionChangeCount, 3);
+
+    allocator.free(a);
+    allocator.free(b);
+    allocator.free(c);
+    allocator.free(d);
+    QCOMPARE(allocator.chunkCount(), 0);
+    QCOMPARE(allocator.freeAllocationCount(), 0);
+}
+
+void tst_ExecutableAllocator::pools()
+{
+    ExecutableAllocator allocator;
+    ExecutableAllocator::WriteBatch batch(&allocator);
+
+    ExecutableAllocator::Allocation *hot = allocator.allocate(10, &batch, ExecutableAllocator::HotCode);
+    QCOMPARE(allocator.chunkCount(), 1);
+
+    // Cold code is never put next to hot code.
+    ExecutableAllocator::Allocation *cold = allocator.allocate(10, &batch, ExecutableAllocator::ColdCode);
+    QCOMPARE(allocator.chunkCount(), 2);
+    QVERIFY(allocator.chunkForAllocation(hot) != allocator.chunkForAllocation(cold));
+
+    ExecutableAllocator::Allocation *cold2 = allocator.allocate(10, &batch, ExecutableAllocator::ColdCode);
+    QCOMPARE(allocator.chunkCount(), 2);
+    QCOMPARE(allocator.chunkForAllocation(cold2), allocator.chunkForAllocation(cold));
+
+    ExecutableAllocator::Allocation *hot2 = allocator.allocate(10, &batch, ExecutableAllocator::HotCode);
+    QCOMPARE(allocator.chunkCount(), 2);
+    QCOMPARE(allocator.chunkForAllocation(hot2), allocator.chunkForAllocation(hot));
+
+    batch.commit();
+    allocator.free(cold);
+    allocator.free(cold2);
+    QCOMPARE(allocator.chunkCount(), 1);
+    allocator.free(hot);
+    allocator.free(hot2);
+    QCOMPARE(allocator.chunkCount(), 0);
     QCOMPARE(allocator.freeAllocationCount(), 0);
 }
 
+void tst_ExecutableAllocator::statistics()
+{
+    ExecutableAllocator allocator;
+    const size_t pageSize = systemPageSize();
+
+    ExecutableAllocator::Statistics stats = allocator.statistics();
+    QCOMPARE(stats.chunkCount, 0);
+    QCOMPARE(stats.reservedBytes, size_t(0));
+    QCOMPARE(stats.usedBytes, size_t(0));
+    QCOMPARE(stats.allocationCount, 0);
+    QCOMPARE(stats.protectionChangeCount, 0);
+
+    ExecutableAllocator::WriteBatch batch(&allocator);
+    ExecutableAllocator::Allocation *hot = allocator.allocate(10, &batch, ExecutableAllocator::HotCode);
+    ExecutableAllocator::Allocation *cold = allocator.allocate(pageSize + 10, &batch, ExecutableAllocator::ColdCode);
+    ExecutableAllocator::Allocation *large = allocator.allocate(8 * 1024 * 1024, &batch, ExecutableAllocator::HotCode);
+    batch.commit();
+
+    const size_t coldSize = (pageSize + 10 + 15) & ~size_t(15);
+    stats = allocator.statistics();
+    QCOMPARE(stats.chunkCount, 3);
+    QCOMPARE(stats.allocationCount, 3);
+    QCOMPARE(stats.usedBytesPerPool[ExecutableAllocator::HotCode], size_t(16 + 8 * 1024 * 1024));
+    QCOMPARE(stats.usedBytesPerPool[ExecutableAllocator::ColdCode], coldSize);
+    QCOMPARE(stats.usedBytes, coldSize + size_t(16 + 8 * 1024 * 1024));
+    QVERIFY(stats.reservedBytes >= size_t(8 * 1024 * 1024 + 2 * 64 * 1024));
+    QCOMPARE(stats.protectionChangeCount, ExecutableAllocator::writeXorExecute() ? 3 : 0);
+    if (!qEnvironmentVariableIsSet("QV4_JIT_HUGE_PAGES"))
+        QCOMPARE(stats.hugePageAdvisedChunkCount, 0);
+    QVERIFY(stats.hugePageAdvisedChunkCount <= 1);
+
+    allocator.free(large);
+    stats = allocator.statistics();
+    QCOMPARE(stats.chunkCount, 2);
+    QCOMPARE(stats.allocationCount, 2);
+    QCOMPARE(stats.usedBytes, coldSize + 16);
+
+    allocator.free(hot);
+    allocator.free(cold);
+    stats = allocator.statistics();
+    QCOMPARE(stats.chunkCount, 0);
+    QCOMPARE(stats.reservedBytes, size_t(0));
+    QCOMPARE(stats.usedBytes, size_t(0));
+    QCOMPARE(stats.allocationCount, 0);
+}
+
 QTEST_MAIN(tst_ExecutableAllocator)
 #include "tst_executableallocator.moc"
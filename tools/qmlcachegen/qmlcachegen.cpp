@@ -33,6 +33,11 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QHashFunctions>
+#include <QDir>
+#include <QSaveFile>
+#include <QTemporaryDir>
+
+#include <algorithm>
 
 #include <private/qqmlirbuilder_p.h>
 #include <private/qv4isel_moth_p.h>
@@ -214,6 +219,9 @@ static bool compileQmlFile(const QString &inputFileName, const QString &outputFi
         {
             QQmlJavaScriptBindingExpressionSimplificationPass pass(irDocument.objects, &irDocument.jsModule, &irDocument.jsGenerator);
             pass.reduceTranslationBindings();
+
+            QQmlTypedBindingCodeGenerator typedBindings(irDocument.objects, &irDocument.jsModule, &irDocument.jsGenerator);
+            typedBindings.generateTypedBindings();
         }
 
         QV4::ExecutableAllocator allocator;
@@ -324,6 +332,63 @@ static bool compileJSFile(const QString &inputFileName, const QString &outputFil
     return true;
 }
 
+struct BundleInput
+{
+    QByteArray key;
+    QByteArray unitData;
+};
+
+static bool writeBundle(const QString &outputFileName, QVector<BundleInput> inputs, Error *error)
+{
+    using namespace QV4::CompiledData;
+
+    std::sort(inputs.begin(), inputs.end(), [](const BundleInput &lhs, const BundleInput &rhs) {
+        return bundleKeyHash(lhs.key) < bundleKeyHash(rhs.key);
+    });
+
+    QByteArray data;
+    data.resize(sizeof(BundleHeader) + inputs.count() * sizeof(BundleEntry));
+    data.fill(0);
+
+    QVector<BundleEntry> entries(inputs.count());
+    for (int i = 0; i < inputs.count(); ++i) {
+        entries[i].keyHash = bundleKeyHash(inputs.at(i).key);
+        entries[i].keyOffset = data.size();
+        entries[i].keyLength = inputs.at(i).key.size();
+        data.append(inputs.at(i).key);
+    }
+
+    for (int i = 0; i < inputs.count(); ++i) {
+        // Page alignment keeps the units independent of each other when the JIT code
+        // within them is made executable.
+        const int padding = (bundleUnitAlignment - data.size() % bundleUnitAlignment) % bundleUnitAlignment;
+        data.append(QByteArray(padding, '\0'));
+        entries[i].unitOffset = data.size();
+        entries[i].unitSize = inputs.at(i).unitData.size();
+        data.append(inputs.at(i).unitData);
+    }
+
+    BundleHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, bundle_magic_str, sizeof(header.magic));
+    header.version = QV4_DATA_STRUCTURE_VERSION;
+    header.qtVersion = QT_VERSION;
+    header.entryCount = inputs.count();
+    header.offsetToEntryTable = sizeof(BundleHeader);
+    memcpy(data.data(), &header, sizeof(header));
+    if (!entries.isEmpty())
+        memcpy(data.data() + sizeof(BundleHeader), entries.constData(), entries.count() * sizeof(BundleEntry));
+
+    QSaveFile bundleFile(outputFileName);
+    if (!bundleFile.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || bundleFile.write(data) != data.size()
+        || !bundleFile.commit()) {
+        error->message = QLatin1String("Error writing ") + outputFileName + QLatin1Char(':') + bundleFile.errorString();
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -349,6 +414,15 @@ int main(int argc, char **argv)
     QCommandLineOption checkIfSupportedOption(QStringLiteral("check-if-supported"), QCoreApplication::translate("main", "Check if cache generate is supported on the specified target architecture"));
     parser.addOption(checkIfSupportedOption);
 
+    QCommandLineOption bundleOption(QStringLiteral("bundle"), QCoreApplication::translate("main", "Generate one cache bundle for all input files (see QML_CACHE_BUNDLE)"));
+    parser.addOption(bundleOption);
+
+    QCommandLineOption bundleRootOption(QStringLiteral("bundle-root"), QCoreApplication::translate("main", "Directory that input file paths are made relative to when computing bundle keys"), QCoreApplication::translate("main", "directory"));
+    parser.addOption(bundleRootOption);
+
+    QCommandLineOption bundleKeyPrefixOption(QStringLiteral("bundle-key-prefix"), QCoreApplication::translate("main", "Prefix for bundle keys, i.e. the run-time location of the bundle root (for example :/ or the installation directory)"), QCoreApplication::translate("main", "prefix"));
+    parser.addOption(bundleKeyPrefixOption);
+
     parser.addPositionalArgument(QStringLiteral("[qml file]"),
             QStringLiteral("QML source file to generate cache for."));
 
@@ -373,6 +447,65 @@ int main(int argc, char **argv)
     }
 
     const QStringList sources = parser.positionalArguments();
+
+    if (!isel)
+        isel.reset(new QV4::Moth::ISelFactory);
+
+    Error error;
+    const QString targetABI = parser.value(targetABIOption);
+
+    if (parser.isSet(bundleOption)) {
+        if (sources.isEmpty() || !parser.isSet(outputFileOption)) {
+            fprintf(stderr, "Bundle generation requires input files and an output file name specified with -o\n");
+            return EXIT_FAILURE;
+        }
+
+        QTemporaryDir workDir;
+        if (!workDir.isValid()) {
+            fprintf(stderr, "Error creating temporary directory for bundle generation\n");
+            return EXIT_FAILURE;
+        }
+
+        const QDir bundleRoot(parser.isSet(bundleRootOption) ? parser.value(bundleRootOption) : QDir::rootPath());
+        const QString keyPrefix = parser.isSet(bundleKeyPrefixOption) ? parser.value(bundleKeyPrefixOption) : QDir::rootPath();
+
+        QVector<BundleInput> inputs;
+        for (int i = 0; i < sources.count(); ++i) {
+            const QString &inputFile = sources.at(i);
+            const QString unitFileName = workDir.filePath(QString::number(i));
+            bool ok = false;
+            if (inputFile.endsWith(QLatin1String(".qml"))) {
+                ok = compileQmlFile(inputFile, unitFileName, isel.data(), targetABI, &error);
+            } else if (inputFile.endsWith(QLatin1String(".js"))) {
+                ok = compileJSFile(inputFile, unitFileName, isel.data(), targetABI, &error);
+            } else {
+                fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+                continue;
+            }
+            if (!ok) {
+                error.augment(QLatin1String("Error compiling qml file: ")).print();
+                return EXIT_FAILURE;
+            }
+
+            QFile unitFile(unitFileName);
+            if (!unitFile.open(QIODevice::ReadOnly)) {
+                fprintf(stderr, "Error reading generated cache for %s\n", qPrintable(inputFile));
+                return EXIT_FAILURE;
+            }
+
+            BundleInput input;
+            input.key = (keyPrefix + bundleRoot.relativeFilePath(QFileInfo(inputFile).absoluteFilePath())).toUtf8();
+            input.unitData = unitFile.readAll();
+            inputs.append(input);
+        }
+
+        if (!writeBundle(parser.value(outputFileOption), inputs, &error)) {
+            error.print();
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     if (sources.isEmpty()){
         parser.showHelp();
     } else if (sources.count() > 1) {
@@ -381,17 +514,10 @@ int main(int argc, char **argv)
     }
     const QString inputFile = sources.first();
 
-    if (!isel)
-        isel.reset(new QV4::Moth::ISelFactory);
-
-    Error error;
-
     QString outputFileName = inputFile + QLatin1Char('c');
     if (parser.isSet(outputFileOption))
         outputFileName = parser.value(outputFileOption);
 
-    const QString targetABI = parser.value(targetABIOption);
-
     if (inputFile.endsWith(QLatin1String(".qml"))) {
         if (!compileQmlFile(inputFile, outputFileName, isel.data(), targetABI, &error)) {
             error.augment(QLatin1String("Error compiling qml file: ")).print();
@@ -32,6 +32,7 @@
 #include <private/qv4codegen_p.h>
 #include <private/qv4value_p.h>
 #include <private/qqmlirbuilder_p.h>
+#include <private/qqmlimportresolutioncacheformat_p.h>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
@@ -47,6 +48,7 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QLibraryInfo>
+#include <QtCore/QSaveFile>
 
 #include <iostream>
 #include <algorithm>
@@ -74,7 +76,8 @@ static void printUsage(const QString &appNameIn)
 #endif
     std::wcerr
         << "Usage: " << appName << " -rootPath path/to/app/qml/directory -importPath path/to/qt/qml/directory\n"
-           "       " << appName << " -qmlFiles file1 file2 -importPath path/to/qt/qml/directory\n\n"
+           "       " << appName << " -qmlFiles file1 file2 -importPath path/to/qt/qml/directory\n"
+           "Add -importCache file to also write an import resolution cache for QML_IMPORT_CACHE.\n\n"
            "Example: " << appName << " -rootPath . -importPath "
         << QDir::toNativeSeparators(qmlPath).toStdWString()
         << '\n';
@@ -490,6 +493,195 @@ QVariantList findQmlImportsRecursively(const QStringList &qmlDirs, const QString
     return ret;
 }
 
+// Writes the file read by QQmlImportResolutionCache (QML_IMPORT_CACHE) for the
+// module imports found, so that the application does not have to probe the
+// import paths on its first start. The probing follows the order used by
+// QQmlImports::completeQmldirPaths() and QQmlImportDatabase::resolvePlugin().
+// Paths are recorded relative to their import path, together with the listings of
+// the directories down to them, so that the file stays valid where the import paths
+// are deployed to.
+class ImportResolutionCacheWriter
+{
+public:
+    ImportResolutionCacheWriter();
+
+    void addModule(const QString &uri, const QString &version);
+    bool write(const QString &fileName) const;
+
+private:
+    struct ImportPath {
+        QString path;
+        QJsonObject directories;
+        QSet<QString> missing;
+        QSet<QString> files;
+    };
+
+    bool probe(ImportPath &importPath, const QString &relativePath);
+    QStringList recordDirectory(ImportPath &importPath, const QString &relativeDirectory);
+    void addPlugins(ImportPath &importPath, const QString &qmldirPath, const QString &content);
+
+    QVector<ImportPath> importPaths;
+};
+
+ImportResolutionCacheWriter::ImportResolutionCacheWriter()
+{
+    for (const QString &path : qAsConst(g_qmlImportPaths)) {
+        const QFileInfo info(path);
+        if (!info.isDir())
+            continue;
+        ImportPath importPath;
+        importPath.path = info.absoluteFilePath();
+        if (!importPath.path.endsWith(QLatin1Char('/')))
+            importPath.path += QLatin1Char('/');
+        importPaths += importPath;
+    }
+}
+
+QStringList ImportResolutionCacheWriter::recordDirectory(ImportPath &importPath, const QString &relativeDirectory)
+{
+    const QJsonValue recorded = importPath.directories.value(relativeDirectory);
+    if (recorded.isArray())
+        return recorded.toVariant().toStringList();
+
+    // Must match QQmlImportResolutionCache::directoryEntries().
+    const QStringList entries = QDir(importPath.path + relativeDirectory).entryList(
+                QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System, QDir::Name);
+    importPath.directories.insert(relativeDirectory, QJsonArray::fromStringList(entries));
+    return entries;
+}
+
+// Records the listing of every directory the result depends on: the ones from the
+// import path down to the file, or down to the deepest one that exists.
+bool ImportResolutionCacheWriter::probe(ImportPath &importPath, const QString &relativePath)
+{
+    const QStringList names = relativePath.split(QLatin1Char('/'));
+    QString relativeDirectory;
+    for (int i = 0; i < names.count(); ++i) {
+        const QStringList entries = recordDirectory(importPath, relativeDirectory);
+        if (!entries.contains(names.at(i)))
+            break;
+        if (i == names.count() - 1) {
+            if (!QFileInfo(importPath.path + relativePath).isFile())
+                break;
+            importPath.files.insert(relativePath);
+            return true;
+        }
+        if (!relativeDirectory.isEmpty())
+            relativeDirectory += QLatin1Char('/');
+        relativeDirectory += names.at(i);
+    }
+    importPath.missing.insert(relativePath);
+    return false;
+}
+
+void ImportResolutionCacheWriter::addModule(const QString &uri, const QString &version)
+{
+    const QVector<QStringRef> versionParts = version.splitRef(QLatin1Char('.'));
+    if (versionParts.count() != 2)
+        return;
+    const QString vmaj = versionParts.at(0).toString();
+    const QString vmin = versionParts.at(1).toString();
+    const QStringList parts = uri.split(QLatin1Char('.'), QString::SkipEmptyParts);
+    const QString slash(QLatin1Char('/'));
+
+    const QString versions[] = {
+        QLatin1Char('.') + vmaj + QLatin1Char('.') + vmin,
+        QLatin1Char('.') + vmaj,
+        QString()
+    };
+    for (const QString &ver : versions) {
+        for (ImportPath &importPath : importPaths) {
+            QStringList candidates;
+            candidates += parts.join(slash) + ver + QLatin1String("/qmldir");
+            if (!ver.isEmpty()) {
+                for (int index = parts.count() - 2; index >= 0; --index) {
+                    candidates += parts.mid(0, index + 1).join(slash) + ver + slash
+                                  + parts.mid(index + 1).join(slash) + QLatin1String("/qmldir");
+                }
+            }
+
+            for (const QString &candidate : qAsConst(candidates)) {
+                if (!probe(importPath, candidate))
+                    continue;
+                QFile qmldir(importPath.path + candidate);
+                if (!qmldir.open(QIODevice::ReadOnly))
+                    return;
+                const QString content = QString::fromUtf8(qmldir.readAll());
+                addPlugins(importPath, candidate.left(candidate.lastIndexOf(QLatin1Char('/'))), content);
+                return;
+            }
+        }
+    }
+}
+
+void ImportResolutionCacheWriter::addPlugins(ImportPath &importPath, const QString &qmldirPath, const QString &content)
+{
+#if defined(Q_OS_WIN)
+    const QString prefix;
+    const QStringList suffixes(QStringLiteral(".dll"));
+#elif defined(Q_OS_DARWIN)
+    const QString prefix = QStringLiteral("lib");
+    const QStringList suffixes = { QStringLiteral(".dylib"), QStringLiteral("_debug.dylib"),
+                                   QStringLiteral(".so"), QStringLiteral(".bundle") };
+#else
+    const QString prefix = QStringLiteral("lib");
+    const QStringList suffixes(QStringLiteral(".so"));
+#endif
+
+    const QVector<QStringRef> lines = content.splitRef(QLatin1Char('\n'));
+    for (const QStringRef &line : lines) {
+        const QVector<QStringRef> fields = line.trimmed().split(QLatin1Char(' '), QString::SkipEmptyParts);
+        if (fields.count() < 2 || fields.at(0) != QLatin1String("plugin"))
+            continue;
+
+        QString pluginDir = qmldirPath;
+        if (fields.count() > 2) {
+            // Plugins outside of the import path are left to be probed at run time.
+            const QString path = fields.at(2).toString();
+            if (!QDir::isRelativePath(path))
+                continue;
+            pluginDir = QDir::cleanPath(qmldirPath + QLatin1Char('/') + path);
+            if (pluginDir == QLatin1String("..") || pluginDir.startsWith(QLatin1String("../")))
+                continue;
+        }
+        const QString base = pluginDir + QLatin1Char('/') + prefix + fields.at(1).toString();
+        for (const QString &suffix : suffixes) {
+            if (probe(importPath, base + suffix))
+                break;
+        }
+    }
+}
+
+bool ImportResolutionCacheWriter::write(const QString &fileName) const
+{
+    namespace Format = QQmlImportResolutionCacheFormat;
+
+    QJsonArray paths;
+    for (const ImportPath &importPath : importPaths) {
+        if (importPath.missing.isEmpty() && importPath.files.isEmpty())
+            continue;
+        QStringList missing = importPath.missing.toList();
+        std::sort(missing.begin(), missing.end());
+        QStringList files = importPath.files.toList();
+        std::sort(files.begin(), files.end());
+        QJsonObject entry;
+        entry.insert(Format::directoriesKey(), importPath.directories);
+        entry.insert(Format::missingKey(), QJsonArray::fromStringList(missing));
+        entry.insert(Format::filesKey(), QJsonArray::fromStringList(files));
+        paths.append(entry);
+    }
+
+    QJsonObject root;
+    root.insert(Format::versionKey(), int(Format::Version));
+    root.insert(Format::importPathsKey(), paths);
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
@@ -504,6 +696,7 @@ int main(int argc, char *argv[])
     QStringList qmlRootPaths;
     QStringList scanFiles;
     QStringList qmlImportPaths;
+    QString importCacheFile;
 
     int i = 1;
     while (i < args.count()) {
@@ -528,6 +721,13 @@ int main(int argc, char *argv[])
             if (i >= args.count())
                 std::cerr << "-importPath requires an argument\n";
             argReceiver = &qmlImportPaths;
+        } else if (arg == QLatin1String("-importCache")) {
+            if (i >= args.count()) {
+                std::cerr << "-importCache requires an argument\n";
+                return 1;
+            }
+            importCacheFile = args.at(i++);
+            continue;
         } else {
             std::cerr << qPrintable(appName) << ": Invalid argument: \""
                 << qPrintable(arg) << "\"\n";
@@ -554,6 +754,20 @@ int main(int argc, char *argv[])
     // Find the imports!
     QVariantList imports = findQmlImportsRecursively(qmlRootPaths, scanFiles);
 
+    if (!importCacheFile.isEmpty()) {
+        ImportResolutionCacheWriter cacheWriter;
+        for (const QVariant &importVariant : qAsConst(imports)) {
+            const QVariantMap import = qvariant_cast<QVariantMap>(importVariant);
+            if (import.value(typeLiteral()) == QLatin1String("module"))
+                cacheWriter.addModule(import.value(nameLiteral()).toString(), import.value(versionLiteral()).toString());
+        }
+        if (!cacheWriter.write(importCacheFile)) {
+            std::cerr << qPrintable(appName) << ": Cannot write import cache \""
+                << qPrintable(importCacheFile) << "\"\n";
+            return 1;
+        }
+    }
+
     // Convert to JSON
     QByteArray json = QJsonDocument(QJsonArray::fromVariantList(imports)).toJson();
     std::cout << json.constData() << std::endl;